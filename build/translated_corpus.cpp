@@ -0,0 +1,6061 @@
+// Translated from Pendulum bytecode by metronome32's translator.
+
+#include <cstddef>
+#include <cstdint>
+#include "translator.h"
+
+std::uint64_t translated_multiply(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+std::uint64_t translated_divide(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+std::uint64_t translated_exchange_sweep(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+std::uint64_t translated_call_chain(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+std::uint64_t translated_bubble_sort(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+std::uint64_t translated_hash(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);
+
+// multiply: 6 words, 4 runs.
+static const metronome32::translated::word translated_multiply_words[] = {
+	{0x0U, 0x2C000005U},
+	{0x1U, 0x34000000U},
+	{0x2U, 0x410001U},
+	{0x3U, 0x601FFFFFU},
+	{0x4U, 0x3000FFFDU},
+	{0x5U, 0x34000000U},
+	{0, 0},
+};
+
+std::uint64_t translated_multiply(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 6;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_multiply_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					retired += 1;
+					context.retired += 1;
+					if (r[0] >> 31 == 1 or r[0] == 0) {
+						context.pc_stack.push(0x0U);
+						context.counter = 0x6U;
+					} else {
+						context.counter = 0x1U;
+					}
+					note_peaks(context);
+					continue;
+				case 0x1U:
+					if (not fits_forward(max_steps - retired, 0x1U, stop_at, 1)) break;
+					context.pc_stack.push(0x1U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x2U;
+					note_peaks(context);
+					continue;
+				case 0x2U:
+					if (not fits_forward(max_steps - retired, 0x2U, stop_at, 3)) break;
+					do {
+						r[2] += r[1];
+						r[0] += 0xFFFFFFFFU;
+						retired += 3;
+						context.retired += 3;
+						if (not (r[0] >> 31 == 0 and r[0] != 0)) {
+							context.counter = 0x5U;
+							break;
+						}
+						context.pc_stack.push(0x4U);
+						context.counter = 0x2U;
+					} while (context.counter != stop_at and fits_forward(max_steps - retired, 0x2U, stop_at, 3));
+					note_peaks(context);
+					continue;
+				case 0x5U:
+					if (not fits_forward(max_steps - retired, 0x5U, stop_at, 1)) break;
+					context.pc_stack.push(0x5U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x6U;
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x2U:
+					if (not fits_reverse(max_steps - retired, 0x2U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x2U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x4U:
+					if (not fits_reverse(max_steps - retired, 0x4U, stop_at, 2)) break;
+					r[0] -= 0xFFFFFFFFU;
+					r[2] -= r[1];
+					context.counter = 0x2U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x6U:
+					if (not fits_reverse(max_steps - retired, 0x6U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x6U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_multiply_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+// divide: 6 words, 3 runs.
+static const metronome32::translated::word translated_divide_words[] = {
+	{0x0U, 0x34000000U},
+	{0x1U, 0x10004U},
+	{0x2U, 0x60400001U},
+	{0x3U, 0x1800FFFDU},
+	{0x4U, 0x10001U},
+	{0x5U, 0x605FFFFFU},
+	{0, 0},
+};
+
+std::uint64_t translated_divide(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 6;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_divide_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					context.pc_stack.push(0x0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1U;
+					note_peaks(context);
+					continue;
+				case 0x1U:
+					if (not fits_forward(max_steps - retired, 0x1U, stop_at, 3)) break;
+					do {
+						r[0] -= r[1];
+						r[2] += 0x1U;
+						retired += 3;
+						context.retired += 3;
+						if (not (r[0] >> 31 == 0)) {
+							context.counter = 0x4U;
+							break;
+						}
+						context.pc_stack.push(0x3U);
+						context.counter = 0x1U;
+					} while (context.counter != stop_at and fits_forward(max_steps - retired, 0x1U, stop_at, 3));
+					note_peaks(context);
+					continue;
+				case 0x4U:
+					if (not fits_forward(max_steps - retired, 0x4U, stop_at, 2)) break;
+					r[0] += r[1];
+					r[2] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x6U;
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x1U:
+					if (not fits_reverse(max_steps - retired, 0x1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3U:
+					if (not fits_reverse(max_steps - retired, 0x3U, stop_at, 2)) break;
+					r[2] -= 0x1U;
+					r[0] += r[1];
+					context.counter = 0x1U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x6U:
+					if (not fits_reverse(max_steps - retired, 0x6U, stop_at, 2)) break;
+					r[2] -= 0xFFFFFFFFU;
+					r[0] -= r[1];
+					context.counter = 0x4U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_divide_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+// exchange-sweep: 4107 words, 5 runs.
+static const metronome32::translated::word translated_exchange_sweep_words[] = {
+	{0x0U, 0x34000000U},
+	{0x1U, 0x60001000U},
+	{0x2U, 0x34000000U},
+	{0x4U, 0x60200001U},
+	{0x5U, 0x60600001U},
+	{0x6U, 0x601FFFFFU},
+	{0x7U, 0x3000FFFBU},
+	{0x8U, 0x607FF000U},
+	{0x9U, 0x609FFFFFU},
+	{0xAU, 0x3004FFF6U},
+	{0, 0},
+};
+
+std::uint64_t translated_exchange_sweep(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 10;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_exchange_sweep_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					context.pc_stack.push(0x0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1U;
+					note_peaks(context);
+					continue;
+				case 0x1U:
+					if (not fits_forward(max_steps - retired, 0x1U, stop_at, 1)) break;
+					r[0] += 0x1000U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x2U;
+					note_peaks(context);
+					continue;
+				case 0x2U:
+					if (not fits_forward(max_steps - retired, 0x2U, stop_at, 1)) break;
+					context.pc_stack.push(0x2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3U;
+					note_peaks(context);
+					continue;
+				case 0x4U:
+					if (not fits_forward(max_steps - retired, 0x4U, stop_at, 4)) break;
+					r[1] += 0x1U;
+					r[3] += 0x1U;
+					r[0] += 0xFFFFFFFFU;
+					retired += 4;
+					context.retired += 4;
+					if (r[0] >> 31 == 0 and r[0] != 0) {
+						context.pc_stack.push(0x7U);
+						context.counter = 0x3U;
+					} else {
+						context.counter = 0x8U;
+					}
+					note_peaks(context);
+					continue;
+				case 0x8U:
+					if (not fits_forward(max_steps - retired, 0x8U, stop_at, 3)) break;
+					r[3] += 0xFFFFF000U;
+					r[4] += 0xFFFFFFFFU;
+					retired += 3;
+					context.retired += 3;
+					if (r[4] >> 31 == 0 and r[4] != 0) {
+						context.pc_stack.push(0xAU);
+						context.counter = 0x1U;
+					} else {
+						context.counter = 0xBU;
+					}
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x1U:
+					if (not fits_reverse(max_steps - retired, 0x1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x2U:
+					if (not fits_reverse(max_steps - retired, 0x2U, stop_at, 1)) break;
+					r[0] -= 0x1000U;
+					context.counter = 0x1U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3U:
+					if (not fits_reverse(max_steps - retired, 0x3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x7U:
+					if (not fits_reverse(max_steps - retired, 0x7U, stop_at, 3)) break;
+					r[0] -= 0xFFFFFFFFU;
+					r[3] -= 0x1U;
+					r[1] -= 0x1U;
+					context.counter = 0x4U;
+					retired += 3;
+					context.retired += 3;
+					continue;
+				case 0xAU:
+					if (not fits_reverse(max_steps - retired, 0xAU, stop_at, 2)) break;
+					r[4] -= 0xFFFFFFFFU;
+					r[3] -= 0xFFFFF000U;
+					context.counter = 0x8U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_exchange_sweep_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+// call-chain: 641 words, 321 runs.
+static const metronome32::translated::word translated_call_chain_words[] = {
+	{0x0U, 0x34000000U},
+	{0x2U, 0x34000000U},
+	{0x3U, 0x63FFFFFEU},
+	{0x4U, 0x601FFFFFU},
+	{0x5U, 0x3000FFFBU},
+	{0x7U, 0x34000000U},
+	{0x8U, 0x63A00001U},
+	{0xAU, 0x63C00001U},
+	{0xCU, 0x34000000U},
+	{0xDU, 0x63FFFFF4U},
+	{0xEU, 0x63DFFFFFU},
+	{0x11U, 0x34000000U},
+	{0x12U, 0x63A00001U},
+	{0x14U, 0x63C00001U},
+	{0x16U, 0x34000000U},
+	{0x17U, 0x63FFFFEAU},
+	{0x18U, 0x63DFFFFFU},
+	{0x1BU, 0x34000000U},
+	{0x1CU, 0x63A00001U},
+	{0x1EU, 0x63C00001U},
+	{0x20U, 0x34000000U},
+	{0x21U, 0x63FFFFE0U},
+	{0x22U, 0x63DFFFFFU},
+	{0x25U, 0x34000000U},
+	{0x26U, 0x63A00001U},
+	{0x28U, 0x63C00001U},
+	{0x2AU, 0x34000000U},
+	{0x2BU, 0x63FFFFD6U},
+	{0x2CU, 0x63DFFFFFU},
+	{0x2FU, 0x34000000U},
+	{0x30U, 0x63A00001U},
+	{0x32U, 0x63C00001U},
+	{0x34U, 0x34000000U},
+	{0x35U, 0x63FFFFCCU},
+	{0x36U, 0x63DFFFFFU},
+	{0x39U, 0x34000000U},
+	{0x3AU, 0x63A00001U},
+	{0x3CU, 0x63C00001U},
+	{0x3EU, 0x34000000U},
+	{0x3FU, 0x63FFFFC2U},
+	{0x40U, 0x63DFFFFFU},
+	{0x43U, 0x34000000U},
+	{0x44U, 0x63A00001U},
+	{0x46U, 0x63C00001U},
+	{0x48U, 0x34000000U},
+	{0x49U, 0x63FFFFB8U},
+	{0x4AU, 0x63DFFFFFU},
+	{0x4DU, 0x34000000U},
+	{0x4EU, 0x63A00001U},
+	{0x50U, 0x63C00001U},
+	{0x52U, 0x34000000U},
+	{0x53U, 0x63FFFFAEU},
+	{0x54U, 0x63DFFFFFU},
+	{0x57U, 0x34000000U},
+	{0x58U, 0x63A00001U},
+	{0x5AU, 0x63C00001U},
+	{0x5CU, 0x34000000U},
+	{0x5DU, 0x63FFFFA4U},
+	{0x5EU, 0x63DFFFFFU},
+	{0x61U, 0x34000000U},
+	{0x62U, 0x63A00001U},
+	{0x64U, 0x63C00001U},
+	{0x66U, 0x34000000U},
+	{0x67U, 0x63FFFF9AU},
+	{0x68U, 0x63DFFFFFU},
+	{0x6BU, 0x34000000U},
+	{0x6CU, 0x63A00001U},
+	{0x6EU, 0x63C00001U},
+	{0x70U, 0x34000000U},
+	{0x71U, 0x63FFFF90U},
+	{0x72U, 0x63DFFFFFU},
+	{0x75U, 0x34000000U},
+	{0x76U, 0x63A00001U},
+	{0x78U, 0x63C00001U},
+	{0x7AU, 0x34000000U},
+	{0x7BU, 0x63FFFF86U},
+	{0x7CU, 0x63DFFFFFU},
+	{0x7FU, 0x34000000U},
+	{0x80U, 0x63A00001U},
+	{0x82U, 0x63C00001U},
+	{0x84U, 0x34000000U},
+	{0x85U, 0x63FFFF7CU},
+	{0x86U, 0x63DFFFFFU},
+	{0x89U, 0x34000000U},
+	{0x8AU, 0x63A00001U},
+	{0x8CU, 0x63C00001U},
+	{0x8EU, 0x34000000U},
+	{0x8FU, 0x63FFFF72U},
+	{0x90U, 0x63DFFFFFU},
+	{0x93U, 0x34000000U},
+	{0x94U, 0x63A00001U},
+	{0x96U, 0x63C00001U},
+	{0x98U, 0x34000000U},
+	{0x99U, 0x63FFFF68U},
+	{0x9AU, 0x63DFFFFFU},
+	{0x9DU, 0x34000000U},
+	{0x9EU, 0x63A00001U},
+	{0xA0U, 0x63C00001U},
+	{0xA2U, 0x34000000U},
+	{0xA3U, 0x63FFFF5EU},
+	{0xA4U, 0x63DFFFFFU},
+	{0xA7U, 0x34000000U},
+	{0xA8U, 0x63A00001U},
+	{0xAAU, 0x63C00001U},
+	{0xACU, 0x34000000U},
+	{0xADU, 0x63FFFF54U},
+	{0xAEU, 0x63DFFFFFU},
+	{0xB1U, 0x34000000U},
+	{0xB2U, 0x63A00001U},
+	{0xB4U, 0x63C00001U},
+	{0xB6U, 0x34000000U},
+	{0xB7U, 0x63FFFF4AU},
+	{0xB8U, 0x63DFFFFFU},
+	{0xBBU, 0x34000000U},
+	{0xBCU, 0x63A00001U},
+	{0xBEU, 0x63C00001U},
+	{0xC0U, 0x34000000U},
+	{0xC1U, 0x63FFFF40U},
+	{0xC2U, 0x63DFFFFFU},
+	{0xC5U, 0x34000000U},
+	{0xC6U, 0x63A00001U},
+	{0xC8U, 0x63C00001U},
+	{0xCAU, 0x34000000U},
+	{0xCBU, 0x63FFFF36U},
+	{0xCCU, 0x63DFFFFFU},
+	{0xCFU, 0x34000000U},
+	{0xD0U, 0x63A00001U},
+	{0xD2U, 0x63C00001U},
+	{0xD4U, 0x34000000U},
+	{0xD5U, 0x63FFFF2CU},
+	{0xD6U, 0x63DFFFFFU},
+	{0xD9U, 0x34000000U},
+	{0xDAU, 0x63A00001U},
+	{0xDCU, 0x63C00001U},
+	{0xDEU, 0x34000000U},
+	{0xDFU, 0x63FFFF22U},
+	{0xE0U, 0x63DFFFFFU},
+	{0xE3U, 0x34000000U},
+	{0xE4U, 0x63A00001U},
+	{0xE6U, 0x63C00001U},
+	{0xE8U, 0x34000000U},
+	{0xE9U, 0x63FFFF18U},
+	{0xEAU, 0x63DFFFFFU},
+	{0xEDU, 0x34000000U},
+	{0xEEU, 0x63A00001U},
+	{0xF0U, 0x63C00001U},
+	{0xF2U, 0x34000000U},
+	{0xF3U, 0x63FFFF0EU},
+	{0xF4U, 0x63DFFFFFU},
+	{0xF7U, 0x34000000U},
+	{0xF8U, 0x63A00001U},
+	{0xFAU, 0x63C00001U},
+	{0xFCU, 0x34000000U},
+	{0xFDU, 0x63FFFF04U},
+	{0xFEU, 0x63DFFFFFU},
+	{0x101U, 0x34000000U},
+	{0x102U, 0x63A00001U},
+	{0x104U, 0x63C00001U},
+	{0x106U, 0x34000000U},
+	{0x107U, 0x63FFFEFAU},
+	{0x108U, 0x63DFFFFFU},
+	{0x10BU, 0x34000000U},
+	{0x10CU, 0x63A00001U},
+	{0x10EU, 0x63C00001U},
+	{0x110U, 0x34000000U},
+	{0x111U, 0x63FFFEF0U},
+	{0x112U, 0x63DFFFFFU},
+	{0x115U, 0x34000000U},
+	{0x116U, 0x63A00001U},
+	{0x118U, 0x63C00001U},
+	{0x11AU, 0x34000000U},
+	{0x11BU, 0x63FFFEE6U},
+	{0x11CU, 0x63DFFFFFU},
+	{0x11FU, 0x34000000U},
+	{0x120U, 0x63A00001U},
+	{0x122U, 0x63C00001U},
+	{0x124U, 0x34000000U},
+	{0x125U, 0x63FFFEDCU},
+	{0x126U, 0x63DFFFFFU},
+	{0x129U, 0x34000000U},
+	{0x12AU, 0x63A00001U},
+	{0x12CU, 0x63C00001U},
+	{0x12EU, 0x34000000U},
+	{0x12FU, 0x63FFFED2U},
+	{0x130U, 0x63DFFFFFU},
+	{0x133U, 0x34000000U},
+	{0x134U, 0x63A00001U},
+	{0x136U, 0x63C00001U},
+	{0x138U, 0x34000000U},
+	{0x139U, 0x63FFFEC8U},
+	{0x13AU, 0x63DFFFFFU},
+	{0x13DU, 0x34000000U},
+	{0x13EU, 0x63A00001U},
+	{0x140U, 0x63C00001U},
+	{0x142U, 0x34000000U},
+	{0x143U, 0x63FFFEBEU},
+	{0x144U, 0x63DFFFFFU},
+	{0x147U, 0x34000000U},
+	{0x148U, 0x63A00001U},
+	{0x14AU, 0x63C00001U},
+	{0x14CU, 0x34000000U},
+	{0x14DU, 0x63FFFEB4U},
+	{0x14EU, 0x63DFFFFFU},
+	{0x151U, 0x34000000U},
+	{0x152U, 0x63A00001U},
+	{0x154U, 0x63C00001U},
+	{0x156U, 0x34000000U},
+	{0x157U, 0x63FFFEAAU},
+	{0x158U, 0x63DFFFFFU},
+	{0x15BU, 0x34000000U},
+	{0x15CU, 0x63A00001U},
+	{0x15EU, 0x63C00001U},
+	{0x160U, 0x34000000U},
+	{0x161U, 0x63FFFEA0U},
+	{0x162U, 0x63DFFFFFU},
+	{0x165U, 0x34000000U},
+	{0x166U, 0x63A00001U},
+	{0x168U, 0x63C00001U},
+	{0x16AU, 0x34000000U},
+	{0x16BU, 0x63FFFE96U},
+	{0x16CU, 0x63DFFFFFU},
+	{0x16FU, 0x34000000U},
+	{0x170U, 0x63A00001U},
+	{0x172U, 0x63C00001U},
+	{0x174U, 0x34000000U},
+	{0x175U, 0x63FFFE8CU},
+	{0x176U, 0x63DFFFFFU},
+	{0x179U, 0x34000000U},
+	{0x17AU, 0x63A00001U},
+	{0x17CU, 0x63C00001U},
+	{0x17EU, 0x34000000U},
+	{0x17FU, 0x63FFFE82U},
+	{0x180U, 0x63DFFFFFU},
+	{0x183U, 0x34000000U},
+	{0x184U, 0x63A00001U},
+	{0x186U, 0x63C00001U},
+	{0x188U, 0x34000000U},
+	{0x189U, 0x63FFFE78U},
+	{0x18AU, 0x63DFFFFFU},
+	{0x18DU, 0x34000000U},
+	{0x18EU, 0x63A00001U},
+	{0x190U, 0x63C00001U},
+	{0x192U, 0x34000000U},
+	{0x193U, 0x63FFFE6EU},
+	{0x194U, 0x63DFFFFFU},
+	{0x197U, 0x34000000U},
+	{0x198U, 0x63A00001U},
+	{0x19AU, 0x63C00001U},
+	{0x19CU, 0x34000000U},
+	{0x19DU, 0x63FFFE64U},
+	{0x19EU, 0x63DFFFFFU},
+	{0x1A1U, 0x34000000U},
+	{0x1A2U, 0x63A00001U},
+	{0x1A4U, 0x63C00001U},
+	{0x1A6U, 0x34000000U},
+	{0x1A7U, 0x63FFFE5AU},
+	{0x1A8U, 0x63DFFFFFU},
+	{0x1ABU, 0x34000000U},
+	{0x1ACU, 0x63A00001U},
+	{0x1AEU, 0x63C00001U},
+	{0x1B0U, 0x34000000U},
+	{0x1B1U, 0x63FFFE50U},
+	{0x1B2U, 0x63DFFFFFU},
+	{0x1B5U, 0x34000000U},
+	{0x1B6U, 0x63A00001U},
+	{0x1B8U, 0x63C00001U},
+	{0x1BAU, 0x34000000U},
+	{0x1BBU, 0x63FFFE46U},
+	{0x1BCU, 0x63DFFFFFU},
+	{0x1BFU, 0x34000000U},
+	{0x1C0U, 0x63A00001U},
+	{0x1C2U, 0x63C00001U},
+	{0x1C4U, 0x34000000U},
+	{0x1C5U, 0x63FFFE3CU},
+	{0x1C6U, 0x63DFFFFFU},
+	{0x1C9U, 0x34000000U},
+	{0x1CAU, 0x63A00001U},
+	{0x1CCU, 0x63C00001U},
+	{0x1CEU, 0x34000000U},
+	{0x1CFU, 0x63FFFE32U},
+	{0x1D0U, 0x63DFFFFFU},
+	{0x1D3U, 0x34000000U},
+	{0x1D4U, 0x63A00001U},
+	{0x1D6U, 0x63C00001U},
+	{0x1D8U, 0x34000000U},
+	{0x1D9U, 0x63FFFE28U},
+	{0x1DAU, 0x63DFFFFFU},
+	{0x1DDU, 0x34000000U},
+	{0x1DEU, 0x63A00001U},
+	{0x1E0U, 0x63C00001U},
+	{0x1E2U, 0x34000000U},
+	{0x1E3U, 0x63FFFE1EU},
+	{0x1E4U, 0x63DFFFFFU},
+	{0x1E7U, 0x34000000U},
+	{0x1E8U, 0x63A00001U},
+	{0x1EAU, 0x63C00001U},
+	{0x1ECU, 0x34000000U},
+	{0x1EDU, 0x63FFFE14U},
+	{0x1EEU, 0x63DFFFFFU},
+	{0x1F1U, 0x34000000U},
+	{0x1F2U, 0x63A00001U},
+	{0x1F4U, 0x63C00001U},
+	{0x1F6U, 0x34000000U},
+	{0x1F7U, 0x63FFFE0AU},
+	{0x1F8U, 0x63DFFFFFU},
+	{0x1FBU, 0x34000000U},
+	{0x1FCU, 0x63A00001U},
+	{0x1FEU, 0x63C00001U},
+	{0x200U, 0x34000000U},
+	{0x201U, 0x63FFFE00U},
+	{0x202U, 0x63DFFFFFU},
+	{0x205U, 0x34000000U},
+	{0x206U, 0x63A00001U},
+	{0x208U, 0x63C00001U},
+	{0x20AU, 0x34000000U},
+	{0x20BU, 0x63FFFDF6U},
+	{0x20CU, 0x63DFFFFFU},
+	{0x20FU, 0x34000000U},
+	{0x210U, 0x63A00001U},
+	{0x212U, 0x63C00001U},
+	{0x214U, 0x34000000U},
+	{0x215U, 0x63FFFDECU},
+	{0x216U, 0x63DFFFFFU},
+	{0x219U, 0x34000000U},
+	{0x21AU, 0x63A00001U},
+	{0x21CU, 0x63C00001U},
+	{0x21EU, 0x34000000U},
+	{0x21FU, 0x63FFFDE2U},
+	{0x220U, 0x63DFFFFFU},
+	{0x223U, 0x34000000U},
+	{0x224U, 0x63A00001U},
+	{0x226U, 0x63C00001U},
+	{0x228U, 0x34000000U},
+	{0x229U, 0x63FFFDD8U},
+	{0x22AU, 0x63DFFFFFU},
+	{0x22DU, 0x34000000U},
+	{0x22EU, 0x63A00001U},
+	{0x230U, 0x63C00001U},
+	{0x232U, 0x34000000U},
+	{0x233U, 0x63FFFDCEU},
+	{0x234U, 0x63DFFFFFU},
+	{0x237U, 0x34000000U},
+	{0x238U, 0x63A00001U},
+	{0x23AU, 0x63C00001U},
+	{0x23CU, 0x34000000U},
+	{0x23DU, 0x63FFFDC4U},
+	{0x23EU, 0x63DFFFFFU},
+	{0x241U, 0x34000000U},
+	{0x242U, 0x63A00001U},
+	{0x244U, 0x63C00001U},
+	{0x246U, 0x34000000U},
+	{0x247U, 0x63FFFDBAU},
+	{0x248U, 0x63DFFFFFU},
+	{0x24BU, 0x34000000U},
+	{0x24CU, 0x63A00001U},
+	{0x24EU, 0x63C00001U},
+	{0x250U, 0x34000000U},
+	{0x251U, 0x63FFFDB0U},
+	{0x252U, 0x63DFFFFFU},
+	{0x255U, 0x34000000U},
+	{0x256U, 0x63A00001U},
+	{0x258U, 0x63C00001U},
+	{0x25AU, 0x34000000U},
+	{0x25BU, 0x63FFFDA6U},
+	{0x25CU, 0x63DFFFFFU},
+	{0x25FU, 0x34000000U},
+	{0x260U, 0x63A00001U},
+	{0x262U, 0x63C00001U},
+	{0x264U, 0x34000000U},
+	{0x265U, 0x63FFFD9CU},
+	{0x266U, 0x63DFFFFFU},
+	{0x269U, 0x34000000U},
+	{0x26AU, 0x63A00001U},
+	{0x26CU, 0x63C00001U},
+	{0x26EU, 0x34000000U},
+	{0x26FU, 0x63FFFD92U},
+	{0x270U, 0x63DFFFFFU},
+	{0x273U, 0x34000000U},
+	{0x274U, 0x63A00001U},
+	{0x276U, 0x63C00001U},
+	{0x278U, 0x34000000U},
+	{0x279U, 0x63FFFD88U},
+	{0x27AU, 0x63DFFFFFU},
+	{0x27DU, 0x34000000U},
+	{0x27EU, 0x63A00001U},
+	{0x280U, 0x34000000U},
+	{0, 0},
+};
+
+std::uint64_t translated_call_chain(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 386;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_call_chain_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					context.pc_stack.push(0x0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1U;
+					note_peaks(context);
+					continue;
+				case 0x2U:
+					if (not fits_forward(max_steps - retired, 0x2U, stop_at, 1)) break;
+					context.pc_stack.push(0x2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3U;
+					note_peaks(context);
+					continue;
+				case 0x3U:
+					if (not fits_forward(max_steps - retired, 0x3U, stop_at, 3)) break;
+					r[31] += 0xFFFFFFFEU;
+					r[0] += 0xFFFFFFFFU;
+					retired += 3;
+					context.retired += 3;
+					if (r[0] >> 31 == 0 and r[0] != 0) {
+						context.pc_stack.push(0x5U);
+						context.counter = 0x1U;
+					} else {
+						context.counter = 0x6U;
+					}
+					note_peaks(context);
+					continue;
+				case 0x7U:
+					if (not fits_forward(max_steps - retired, 0x7U, stop_at, 1)) break;
+					context.pc_stack.push(0x7U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x8U;
+					note_peaks(context);
+					continue;
+				case 0x8U:
+					if (not fits_forward(max_steps - retired, 0x8U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x9U;
+					note_peaks(context);
+					continue;
+				case 0xAU:
+					if (not fits_forward(max_steps - retired, 0xAU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xBU;
+					note_peaks(context);
+					continue;
+				case 0xCU:
+					if (not fits_forward(max_steps - retired, 0xCU, stop_at, 1)) break;
+					context.pc_stack.push(0xCU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xDU;
+					note_peaks(context);
+					continue;
+				case 0xDU:
+					if (not fits_forward(max_steps - retired, 0xDU, stop_at, 2)) break;
+					r[31] += 0xFFFFFFF4U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xFU;
+					note_peaks(context);
+					continue;
+				case 0x11U:
+					if (not fits_forward(max_steps - retired, 0x11U, stop_at, 1)) break;
+					context.pc_stack.push(0x11U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x12U;
+					note_peaks(context);
+					continue;
+				case 0x12U:
+					if (not fits_forward(max_steps - retired, 0x12U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x13U;
+					note_peaks(context);
+					continue;
+				case 0x14U:
+					if (not fits_forward(max_steps - retired, 0x14U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x15U;
+					note_peaks(context);
+					continue;
+				case 0x16U:
+					if (not fits_forward(max_steps - retired, 0x16U, stop_at, 1)) break;
+					context.pc_stack.push(0x16U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x17U;
+					note_peaks(context);
+					continue;
+				case 0x17U:
+					if (not fits_forward(max_steps - retired, 0x17U, stop_at, 2)) break;
+					r[31] += 0xFFFFFFEAU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x19U;
+					note_peaks(context);
+					continue;
+				case 0x1BU:
+					if (not fits_forward(max_steps - retired, 0x1BU, stop_at, 1)) break;
+					context.pc_stack.push(0x1BU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1CU;
+					note_peaks(context);
+					continue;
+				case 0x1CU:
+					if (not fits_forward(max_steps - retired, 0x1CU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1DU;
+					note_peaks(context);
+					continue;
+				case 0x1EU:
+					if (not fits_forward(max_steps - retired, 0x1EU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1FU;
+					note_peaks(context);
+					continue;
+				case 0x20U:
+					if (not fits_forward(max_steps - retired, 0x20U, stop_at, 1)) break;
+					context.pc_stack.push(0x20U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x21U;
+					note_peaks(context);
+					continue;
+				case 0x21U:
+					if (not fits_forward(max_steps - retired, 0x21U, stop_at, 2)) break;
+					r[31] += 0xFFFFFFE0U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x23U;
+					note_peaks(context);
+					continue;
+				case 0x25U:
+					if (not fits_forward(max_steps - retired, 0x25U, stop_at, 1)) break;
+					context.pc_stack.push(0x25U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x26U;
+					note_peaks(context);
+					continue;
+				case 0x26U:
+					if (not fits_forward(max_steps - retired, 0x26U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x27U;
+					note_peaks(context);
+					continue;
+				case 0x28U:
+					if (not fits_forward(max_steps - retired, 0x28U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x29U;
+					note_peaks(context);
+					continue;
+				case 0x2AU:
+					if (not fits_forward(max_steps - retired, 0x2AU, stop_at, 1)) break;
+					context.pc_stack.push(0x2AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x2BU;
+					note_peaks(context);
+					continue;
+				case 0x2BU:
+					if (not fits_forward(max_steps - retired, 0x2BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFFD6U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x2DU;
+					note_peaks(context);
+					continue;
+				case 0x2FU:
+					if (not fits_forward(max_steps - retired, 0x2FU, stop_at, 1)) break;
+					context.pc_stack.push(0x2FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x30U;
+					note_peaks(context);
+					continue;
+				case 0x30U:
+					if (not fits_forward(max_steps - retired, 0x30U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x31U;
+					note_peaks(context);
+					continue;
+				case 0x32U:
+					if (not fits_forward(max_steps - retired, 0x32U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x33U;
+					note_peaks(context);
+					continue;
+				case 0x34U:
+					if (not fits_forward(max_steps - retired, 0x34U, stop_at, 1)) break;
+					context.pc_stack.push(0x34U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x35U;
+					note_peaks(context);
+					continue;
+				case 0x35U:
+					if (not fits_forward(max_steps - retired, 0x35U, stop_at, 2)) break;
+					r[31] += 0xFFFFFFCCU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x37U;
+					note_peaks(context);
+					continue;
+				case 0x39U:
+					if (not fits_forward(max_steps - retired, 0x39U, stop_at, 1)) break;
+					context.pc_stack.push(0x39U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3AU;
+					note_peaks(context);
+					continue;
+				case 0x3AU:
+					if (not fits_forward(max_steps - retired, 0x3AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3BU;
+					note_peaks(context);
+					continue;
+				case 0x3CU:
+					if (not fits_forward(max_steps - retired, 0x3CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3DU;
+					note_peaks(context);
+					continue;
+				case 0x3EU:
+					if (not fits_forward(max_steps - retired, 0x3EU, stop_at, 1)) break;
+					context.pc_stack.push(0x3EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3FU;
+					note_peaks(context);
+					continue;
+				case 0x3FU:
+					if (not fits_forward(max_steps - retired, 0x3FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFFC2U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x41U;
+					note_peaks(context);
+					continue;
+				case 0x43U:
+					if (not fits_forward(max_steps - retired, 0x43U, stop_at, 1)) break;
+					context.pc_stack.push(0x43U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x44U;
+					note_peaks(context);
+					continue;
+				case 0x44U:
+					if (not fits_forward(max_steps - retired, 0x44U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x45U;
+					note_peaks(context);
+					continue;
+				case 0x46U:
+					if (not fits_forward(max_steps - retired, 0x46U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x47U;
+					note_peaks(context);
+					continue;
+				case 0x48U:
+					if (not fits_forward(max_steps - retired, 0x48U, stop_at, 1)) break;
+					context.pc_stack.push(0x48U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x49U;
+					note_peaks(context);
+					continue;
+				case 0x49U:
+					if (not fits_forward(max_steps - retired, 0x49U, stop_at, 2)) break;
+					r[31] += 0xFFFFFFB8U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x4BU;
+					note_peaks(context);
+					continue;
+				case 0x4DU:
+					if (not fits_forward(max_steps - retired, 0x4DU, stop_at, 1)) break;
+					context.pc_stack.push(0x4DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x4EU;
+					note_peaks(context);
+					continue;
+				case 0x4EU:
+					if (not fits_forward(max_steps - retired, 0x4EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x4FU;
+					note_peaks(context);
+					continue;
+				case 0x50U:
+					if (not fits_forward(max_steps - retired, 0x50U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x51U;
+					note_peaks(context);
+					continue;
+				case 0x52U:
+					if (not fits_forward(max_steps - retired, 0x52U, stop_at, 1)) break;
+					context.pc_stack.push(0x52U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x53U;
+					note_peaks(context);
+					continue;
+				case 0x53U:
+					if (not fits_forward(max_steps - retired, 0x53U, stop_at, 2)) break;
+					r[31] += 0xFFFFFFAEU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x55U;
+					note_peaks(context);
+					continue;
+				case 0x57U:
+					if (not fits_forward(max_steps - retired, 0x57U, stop_at, 1)) break;
+					context.pc_stack.push(0x57U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x58U;
+					note_peaks(context);
+					continue;
+				case 0x58U:
+					if (not fits_forward(max_steps - retired, 0x58U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x59U;
+					note_peaks(context);
+					continue;
+				case 0x5AU:
+					if (not fits_forward(max_steps - retired, 0x5AU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x5BU;
+					note_peaks(context);
+					continue;
+				case 0x5CU:
+					if (not fits_forward(max_steps - retired, 0x5CU, stop_at, 1)) break;
+					context.pc_stack.push(0x5CU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x5DU;
+					note_peaks(context);
+					continue;
+				case 0x5DU:
+					if (not fits_forward(max_steps - retired, 0x5DU, stop_at, 2)) break;
+					r[31] += 0xFFFFFFA4U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x5FU;
+					note_peaks(context);
+					continue;
+				case 0x61U:
+					if (not fits_forward(max_steps - retired, 0x61U, stop_at, 1)) break;
+					context.pc_stack.push(0x61U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x62U;
+					note_peaks(context);
+					continue;
+				case 0x62U:
+					if (not fits_forward(max_steps - retired, 0x62U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x63U;
+					note_peaks(context);
+					continue;
+				case 0x64U:
+					if (not fits_forward(max_steps - retired, 0x64U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x65U;
+					note_peaks(context);
+					continue;
+				case 0x66U:
+					if (not fits_forward(max_steps - retired, 0x66U, stop_at, 1)) break;
+					context.pc_stack.push(0x66U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x67U;
+					note_peaks(context);
+					continue;
+				case 0x67U:
+					if (not fits_forward(max_steps - retired, 0x67U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF9AU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x69U;
+					note_peaks(context);
+					continue;
+				case 0x6BU:
+					if (not fits_forward(max_steps - retired, 0x6BU, stop_at, 1)) break;
+					context.pc_stack.push(0x6BU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x6CU;
+					note_peaks(context);
+					continue;
+				case 0x6CU:
+					if (not fits_forward(max_steps - retired, 0x6CU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x6DU;
+					note_peaks(context);
+					continue;
+				case 0x6EU:
+					if (not fits_forward(max_steps - retired, 0x6EU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x6FU;
+					note_peaks(context);
+					continue;
+				case 0x70U:
+					if (not fits_forward(max_steps - retired, 0x70U, stop_at, 1)) break;
+					context.pc_stack.push(0x70U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x71U;
+					note_peaks(context);
+					continue;
+				case 0x71U:
+					if (not fits_forward(max_steps - retired, 0x71U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF90U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x73U;
+					note_peaks(context);
+					continue;
+				case 0x75U:
+					if (not fits_forward(max_steps - retired, 0x75U, stop_at, 1)) break;
+					context.pc_stack.push(0x75U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x76U;
+					note_peaks(context);
+					continue;
+				case 0x76U:
+					if (not fits_forward(max_steps - retired, 0x76U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x77U;
+					note_peaks(context);
+					continue;
+				case 0x78U:
+					if (not fits_forward(max_steps - retired, 0x78U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x79U;
+					note_peaks(context);
+					continue;
+				case 0x7AU:
+					if (not fits_forward(max_steps - retired, 0x7AU, stop_at, 1)) break;
+					context.pc_stack.push(0x7AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x7BU;
+					note_peaks(context);
+					continue;
+				case 0x7BU:
+					if (not fits_forward(max_steps - retired, 0x7BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF86U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x7DU;
+					note_peaks(context);
+					continue;
+				case 0x7FU:
+					if (not fits_forward(max_steps - retired, 0x7FU, stop_at, 1)) break;
+					context.pc_stack.push(0x7FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x80U;
+					note_peaks(context);
+					continue;
+				case 0x80U:
+					if (not fits_forward(max_steps - retired, 0x80U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x81U;
+					note_peaks(context);
+					continue;
+				case 0x82U:
+					if (not fits_forward(max_steps - retired, 0x82U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x83U;
+					note_peaks(context);
+					continue;
+				case 0x84U:
+					if (not fits_forward(max_steps - retired, 0x84U, stop_at, 1)) break;
+					context.pc_stack.push(0x84U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x85U;
+					note_peaks(context);
+					continue;
+				case 0x85U:
+					if (not fits_forward(max_steps - retired, 0x85U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF7CU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x87U;
+					note_peaks(context);
+					continue;
+				case 0x89U:
+					if (not fits_forward(max_steps - retired, 0x89U, stop_at, 1)) break;
+					context.pc_stack.push(0x89U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x8AU;
+					note_peaks(context);
+					continue;
+				case 0x8AU:
+					if (not fits_forward(max_steps - retired, 0x8AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x8BU;
+					note_peaks(context);
+					continue;
+				case 0x8CU:
+					if (not fits_forward(max_steps - retired, 0x8CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x8DU;
+					note_peaks(context);
+					continue;
+				case 0x8EU:
+					if (not fits_forward(max_steps - retired, 0x8EU, stop_at, 1)) break;
+					context.pc_stack.push(0x8EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x8FU;
+					note_peaks(context);
+					continue;
+				case 0x8FU:
+					if (not fits_forward(max_steps - retired, 0x8FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF72U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x91U;
+					note_peaks(context);
+					continue;
+				case 0x93U:
+					if (not fits_forward(max_steps - retired, 0x93U, stop_at, 1)) break;
+					context.pc_stack.push(0x93U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x94U;
+					note_peaks(context);
+					continue;
+				case 0x94U:
+					if (not fits_forward(max_steps - retired, 0x94U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x95U;
+					note_peaks(context);
+					continue;
+				case 0x96U:
+					if (not fits_forward(max_steps - retired, 0x96U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x97U;
+					note_peaks(context);
+					continue;
+				case 0x98U:
+					if (not fits_forward(max_steps - retired, 0x98U, stop_at, 1)) break;
+					context.pc_stack.push(0x98U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x99U;
+					note_peaks(context);
+					continue;
+				case 0x99U:
+					if (not fits_forward(max_steps - retired, 0x99U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF68U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x9BU;
+					note_peaks(context);
+					continue;
+				case 0x9DU:
+					if (not fits_forward(max_steps - retired, 0x9DU, stop_at, 1)) break;
+					context.pc_stack.push(0x9DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x9EU;
+					note_peaks(context);
+					continue;
+				case 0x9EU:
+					if (not fits_forward(max_steps - retired, 0x9EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x9FU;
+					note_peaks(context);
+					continue;
+				case 0xA0U:
+					if (not fits_forward(max_steps - retired, 0xA0U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xA1U;
+					note_peaks(context);
+					continue;
+				case 0xA2U:
+					if (not fits_forward(max_steps - retired, 0xA2U, stop_at, 1)) break;
+					context.pc_stack.push(0xA2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xA3U;
+					note_peaks(context);
+					continue;
+				case 0xA3U:
+					if (not fits_forward(max_steps - retired, 0xA3U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF5EU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xA5U;
+					note_peaks(context);
+					continue;
+				case 0xA7U:
+					if (not fits_forward(max_steps - retired, 0xA7U, stop_at, 1)) break;
+					context.pc_stack.push(0xA7U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xA8U;
+					note_peaks(context);
+					continue;
+				case 0xA8U:
+					if (not fits_forward(max_steps - retired, 0xA8U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xA9U;
+					note_peaks(context);
+					continue;
+				case 0xAAU:
+					if (not fits_forward(max_steps - retired, 0xAAU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xABU;
+					note_peaks(context);
+					continue;
+				case 0xACU:
+					if (not fits_forward(max_steps - retired, 0xACU, stop_at, 1)) break;
+					context.pc_stack.push(0xACU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xADU;
+					note_peaks(context);
+					continue;
+				case 0xADU:
+					if (not fits_forward(max_steps - retired, 0xADU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF54U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xAFU;
+					note_peaks(context);
+					continue;
+				case 0xB1U:
+					if (not fits_forward(max_steps - retired, 0xB1U, stop_at, 1)) break;
+					context.pc_stack.push(0xB1U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xB2U;
+					note_peaks(context);
+					continue;
+				case 0xB2U:
+					if (not fits_forward(max_steps - retired, 0xB2U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xB3U;
+					note_peaks(context);
+					continue;
+				case 0xB4U:
+					if (not fits_forward(max_steps - retired, 0xB4U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xB5U;
+					note_peaks(context);
+					continue;
+				case 0xB6U:
+					if (not fits_forward(max_steps - retired, 0xB6U, stop_at, 1)) break;
+					context.pc_stack.push(0xB6U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xB7U;
+					note_peaks(context);
+					continue;
+				case 0xB7U:
+					if (not fits_forward(max_steps - retired, 0xB7U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF4AU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xB9U;
+					note_peaks(context);
+					continue;
+				case 0xBBU:
+					if (not fits_forward(max_steps - retired, 0xBBU, stop_at, 1)) break;
+					context.pc_stack.push(0xBBU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xBCU;
+					note_peaks(context);
+					continue;
+				case 0xBCU:
+					if (not fits_forward(max_steps - retired, 0xBCU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xBDU;
+					note_peaks(context);
+					continue;
+				case 0xBEU:
+					if (not fits_forward(max_steps - retired, 0xBEU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xBFU;
+					note_peaks(context);
+					continue;
+				case 0xC0U:
+					if (not fits_forward(max_steps - retired, 0xC0U, stop_at, 1)) break;
+					context.pc_stack.push(0xC0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xC1U;
+					note_peaks(context);
+					continue;
+				case 0xC1U:
+					if (not fits_forward(max_steps - retired, 0xC1U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF40U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xC3U;
+					note_peaks(context);
+					continue;
+				case 0xC5U:
+					if (not fits_forward(max_steps - retired, 0xC5U, stop_at, 1)) break;
+					context.pc_stack.push(0xC5U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xC6U;
+					note_peaks(context);
+					continue;
+				case 0xC6U:
+					if (not fits_forward(max_steps - retired, 0xC6U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xC7U;
+					note_peaks(context);
+					continue;
+				case 0xC8U:
+					if (not fits_forward(max_steps - retired, 0xC8U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xC9U;
+					note_peaks(context);
+					continue;
+				case 0xCAU:
+					if (not fits_forward(max_steps - retired, 0xCAU, stop_at, 1)) break;
+					context.pc_stack.push(0xCAU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xCBU;
+					note_peaks(context);
+					continue;
+				case 0xCBU:
+					if (not fits_forward(max_steps - retired, 0xCBU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF36U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xCDU;
+					note_peaks(context);
+					continue;
+				case 0xCFU:
+					if (not fits_forward(max_steps - retired, 0xCFU, stop_at, 1)) break;
+					context.pc_stack.push(0xCFU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xD0U;
+					note_peaks(context);
+					continue;
+				case 0xD0U:
+					if (not fits_forward(max_steps - retired, 0xD0U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xD1U;
+					note_peaks(context);
+					continue;
+				case 0xD2U:
+					if (not fits_forward(max_steps - retired, 0xD2U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xD3U;
+					note_peaks(context);
+					continue;
+				case 0xD4U:
+					if (not fits_forward(max_steps - retired, 0xD4U, stop_at, 1)) break;
+					context.pc_stack.push(0xD4U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xD5U;
+					note_peaks(context);
+					continue;
+				case 0xD5U:
+					if (not fits_forward(max_steps - retired, 0xD5U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF2CU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xD7U;
+					note_peaks(context);
+					continue;
+				case 0xD9U:
+					if (not fits_forward(max_steps - retired, 0xD9U, stop_at, 1)) break;
+					context.pc_stack.push(0xD9U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xDAU;
+					note_peaks(context);
+					continue;
+				case 0xDAU:
+					if (not fits_forward(max_steps - retired, 0xDAU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xDBU;
+					note_peaks(context);
+					continue;
+				case 0xDCU:
+					if (not fits_forward(max_steps - retired, 0xDCU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xDDU;
+					note_peaks(context);
+					continue;
+				case 0xDEU:
+					if (not fits_forward(max_steps - retired, 0xDEU, stop_at, 1)) break;
+					context.pc_stack.push(0xDEU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xDFU;
+					note_peaks(context);
+					continue;
+				case 0xDFU:
+					if (not fits_forward(max_steps - retired, 0xDFU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF22U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xE1U;
+					note_peaks(context);
+					continue;
+				case 0xE3U:
+					if (not fits_forward(max_steps - retired, 0xE3U, stop_at, 1)) break;
+					context.pc_stack.push(0xE3U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xE4U;
+					note_peaks(context);
+					continue;
+				case 0xE4U:
+					if (not fits_forward(max_steps - retired, 0xE4U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xE5U;
+					note_peaks(context);
+					continue;
+				case 0xE6U:
+					if (not fits_forward(max_steps - retired, 0xE6U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xE7U;
+					note_peaks(context);
+					continue;
+				case 0xE8U:
+					if (not fits_forward(max_steps - retired, 0xE8U, stop_at, 1)) break;
+					context.pc_stack.push(0xE8U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xE9U;
+					note_peaks(context);
+					continue;
+				case 0xE9U:
+					if (not fits_forward(max_steps - retired, 0xE9U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF18U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xEBU;
+					note_peaks(context);
+					continue;
+				case 0xEDU:
+					if (not fits_forward(max_steps - retired, 0xEDU, stop_at, 1)) break;
+					context.pc_stack.push(0xEDU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xEEU;
+					note_peaks(context);
+					continue;
+				case 0xEEU:
+					if (not fits_forward(max_steps - retired, 0xEEU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xEFU;
+					note_peaks(context);
+					continue;
+				case 0xF0U:
+					if (not fits_forward(max_steps - retired, 0xF0U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xF1U;
+					note_peaks(context);
+					continue;
+				case 0xF2U:
+					if (not fits_forward(max_steps - retired, 0xF2U, stop_at, 1)) break;
+					context.pc_stack.push(0xF2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xF3U;
+					note_peaks(context);
+					continue;
+				case 0xF3U:
+					if (not fits_forward(max_steps - retired, 0xF3U, stop_at, 2)) break;
+					r[31] += 0xFFFFFF0EU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xF5U;
+					note_peaks(context);
+					continue;
+				case 0xF7U:
+					if (not fits_forward(max_steps - retired, 0xF7U, stop_at, 1)) break;
+					context.pc_stack.push(0xF7U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xF8U;
+					note_peaks(context);
+					continue;
+				case 0xF8U:
+					if (not fits_forward(max_steps - retired, 0xF8U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xF9U;
+					note_peaks(context);
+					continue;
+				case 0xFAU:
+					if (not fits_forward(max_steps - retired, 0xFAU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xFBU;
+					note_peaks(context);
+					continue;
+				case 0xFCU:
+					if (not fits_forward(max_steps - retired, 0xFCU, stop_at, 1)) break;
+					context.pc_stack.push(0xFCU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xFDU;
+					note_peaks(context);
+					continue;
+				case 0xFDU:
+					if (not fits_forward(max_steps - retired, 0xFDU, stop_at, 2)) break;
+					r[31] += 0xFFFFFF04U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0xFFU;
+					note_peaks(context);
+					continue;
+				case 0x101U:
+					if (not fits_forward(max_steps - retired, 0x101U, stop_at, 1)) break;
+					context.pc_stack.push(0x101U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x102U;
+					note_peaks(context);
+					continue;
+				case 0x102U:
+					if (not fits_forward(max_steps - retired, 0x102U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x103U;
+					note_peaks(context);
+					continue;
+				case 0x104U:
+					if (not fits_forward(max_steps - retired, 0x104U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x105U;
+					note_peaks(context);
+					continue;
+				case 0x106U:
+					if (not fits_forward(max_steps - retired, 0x106U, stop_at, 1)) break;
+					context.pc_stack.push(0x106U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x107U;
+					note_peaks(context);
+					continue;
+				case 0x107U:
+					if (not fits_forward(max_steps - retired, 0x107U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEFAU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x109U;
+					note_peaks(context);
+					continue;
+				case 0x10BU:
+					if (not fits_forward(max_steps - retired, 0x10BU, stop_at, 1)) break;
+					context.pc_stack.push(0x10BU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x10CU;
+					note_peaks(context);
+					continue;
+				case 0x10CU:
+					if (not fits_forward(max_steps - retired, 0x10CU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x10DU;
+					note_peaks(context);
+					continue;
+				case 0x10EU:
+					if (not fits_forward(max_steps - retired, 0x10EU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x10FU;
+					note_peaks(context);
+					continue;
+				case 0x110U:
+					if (not fits_forward(max_steps - retired, 0x110U, stop_at, 1)) break;
+					context.pc_stack.push(0x110U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x111U;
+					note_peaks(context);
+					continue;
+				case 0x111U:
+					if (not fits_forward(max_steps - retired, 0x111U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEF0U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x113U;
+					note_peaks(context);
+					continue;
+				case 0x115U:
+					if (not fits_forward(max_steps - retired, 0x115U, stop_at, 1)) break;
+					context.pc_stack.push(0x115U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x116U;
+					note_peaks(context);
+					continue;
+				case 0x116U:
+					if (not fits_forward(max_steps - retired, 0x116U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x117U;
+					note_peaks(context);
+					continue;
+				case 0x118U:
+					if (not fits_forward(max_steps - retired, 0x118U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x119U;
+					note_peaks(context);
+					continue;
+				case 0x11AU:
+					if (not fits_forward(max_steps - retired, 0x11AU, stop_at, 1)) break;
+					context.pc_stack.push(0x11AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x11BU;
+					note_peaks(context);
+					continue;
+				case 0x11BU:
+					if (not fits_forward(max_steps - retired, 0x11BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFEE6U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x11DU;
+					note_peaks(context);
+					continue;
+				case 0x11FU:
+					if (not fits_forward(max_steps - retired, 0x11FU, stop_at, 1)) break;
+					context.pc_stack.push(0x11FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x120U;
+					note_peaks(context);
+					continue;
+				case 0x120U:
+					if (not fits_forward(max_steps - retired, 0x120U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x121U;
+					note_peaks(context);
+					continue;
+				case 0x122U:
+					if (not fits_forward(max_steps - retired, 0x122U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x123U;
+					note_peaks(context);
+					continue;
+				case 0x124U:
+					if (not fits_forward(max_steps - retired, 0x124U, stop_at, 1)) break;
+					context.pc_stack.push(0x124U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x125U;
+					note_peaks(context);
+					continue;
+				case 0x125U:
+					if (not fits_forward(max_steps - retired, 0x125U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEDCU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x127U;
+					note_peaks(context);
+					continue;
+				case 0x129U:
+					if (not fits_forward(max_steps - retired, 0x129U, stop_at, 1)) break;
+					context.pc_stack.push(0x129U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x12AU;
+					note_peaks(context);
+					continue;
+				case 0x12AU:
+					if (not fits_forward(max_steps - retired, 0x12AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x12BU;
+					note_peaks(context);
+					continue;
+				case 0x12CU:
+					if (not fits_forward(max_steps - retired, 0x12CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x12DU;
+					note_peaks(context);
+					continue;
+				case 0x12EU:
+					if (not fits_forward(max_steps - retired, 0x12EU, stop_at, 1)) break;
+					context.pc_stack.push(0x12EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x12FU;
+					note_peaks(context);
+					continue;
+				case 0x12FU:
+					if (not fits_forward(max_steps - retired, 0x12FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFED2U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x131U;
+					note_peaks(context);
+					continue;
+				case 0x133U:
+					if (not fits_forward(max_steps - retired, 0x133U, stop_at, 1)) break;
+					context.pc_stack.push(0x133U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x134U;
+					note_peaks(context);
+					continue;
+				case 0x134U:
+					if (not fits_forward(max_steps - retired, 0x134U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x135U;
+					note_peaks(context);
+					continue;
+				case 0x136U:
+					if (not fits_forward(max_steps - retired, 0x136U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x137U;
+					note_peaks(context);
+					continue;
+				case 0x138U:
+					if (not fits_forward(max_steps - retired, 0x138U, stop_at, 1)) break;
+					context.pc_stack.push(0x138U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x139U;
+					note_peaks(context);
+					continue;
+				case 0x139U:
+					if (not fits_forward(max_steps - retired, 0x139U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEC8U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x13BU;
+					note_peaks(context);
+					continue;
+				case 0x13DU:
+					if (not fits_forward(max_steps - retired, 0x13DU, stop_at, 1)) break;
+					context.pc_stack.push(0x13DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x13EU;
+					note_peaks(context);
+					continue;
+				case 0x13EU:
+					if (not fits_forward(max_steps - retired, 0x13EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x13FU;
+					note_peaks(context);
+					continue;
+				case 0x140U:
+					if (not fits_forward(max_steps - retired, 0x140U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x141U;
+					note_peaks(context);
+					continue;
+				case 0x142U:
+					if (not fits_forward(max_steps - retired, 0x142U, stop_at, 1)) break;
+					context.pc_stack.push(0x142U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x143U;
+					note_peaks(context);
+					continue;
+				case 0x143U:
+					if (not fits_forward(max_steps - retired, 0x143U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEBEU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x145U;
+					note_peaks(context);
+					continue;
+				case 0x147U:
+					if (not fits_forward(max_steps - retired, 0x147U, stop_at, 1)) break;
+					context.pc_stack.push(0x147U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x148U;
+					note_peaks(context);
+					continue;
+				case 0x148U:
+					if (not fits_forward(max_steps - retired, 0x148U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x149U;
+					note_peaks(context);
+					continue;
+				case 0x14AU:
+					if (not fits_forward(max_steps - retired, 0x14AU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x14BU;
+					note_peaks(context);
+					continue;
+				case 0x14CU:
+					if (not fits_forward(max_steps - retired, 0x14CU, stop_at, 1)) break;
+					context.pc_stack.push(0x14CU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x14DU;
+					note_peaks(context);
+					continue;
+				case 0x14DU:
+					if (not fits_forward(max_steps - retired, 0x14DU, stop_at, 2)) break;
+					r[31] += 0xFFFFFEB4U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x14FU;
+					note_peaks(context);
+					continue;
+				case 0x151U:
+					if (not fits_forward(max_steps - retired, 0x151U, stop_at, 1)) break;
+					context.pc_stack.push(0x151U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x152U;
+					note_peaks(context);
+					continue;
+				case 0x152U:
+					if (not fits_forward(max_steps - retired, 0x152U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x153U;
+					note_peaks(context);
+					continue;
+				case 0x154U:
+					if (not fits_forward(max_steps - retired, 0x154U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x155U;
+					note_peaks(context);
+					continue;
+				case 0x156U:
+					if (not fits_forward(max_steps - retired, 0x156U, stop_at, 1)) break;
+					context.pc_stack.push(0x156U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x157U;
+					note_peaks(context);
+					continue;
+				case 0x157U:
+					if (not fits_forward(max_steps - retired, 0x157U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEAAU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x159U;
+					note_peaks(context);
+					continue;
+				case 0x15BU:
+					if (not fits_forward(max_steps - retired, 0x15BU, stop_at, 1)) break;
+					context.pc_stack.push(0x15BU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x15CU;
+					note_peaks(context);
+					continue;
+				case 0x15CU:
+					if (not fits_forward(max_steps - retired, 0x15CU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x15DU;
+					note_peaks(context);
+					continue;
+				case 0x15EU:
+					if (not fits_forward(max_steps - retired, 0x15EU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x15FU;
+					note_peaks(context);
+					continue;
+				case 0x160U:
+					if (not fits_forward(max_steps - retired, 0x160U, stop_at, 1)) break;
+					context.pc_stack.push(0x160U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x161U;
+					note_peaks(context);
+					continue;
+				case 0x161U:
+					if (not fits_forward(max_steps - retired, 0x161U, stop_at, 2)) break;
+					r[31] += 0xFFFFFEA0U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x163U;
+					note_peaks(context);
+					continue;
+				case 0x165U:
+					if (not fits_forward(max_steps - retired, 0x165U, stop_at, 1)) break;
+					context.pc_stack.push(0x165U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x166U;
+					note_peaks(context);
+					continue;
+				case 0x166U:
+					if (not fits_forward(max_steps - retired, 0x166U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x167U;
+					note_peaks(context);
+					continue;
+				case 0x168U:
+					if (not fits_forward(max_steps - retired, 0x168U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x169U;
+					note_peaks(context);
+					continue;
+				case 0x16AU:
+					if (not fits_forward(max_steps - retired, 0x16AU, stop_at, 1)) break;
+					context.pc_stack.push(0x16AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x16BU;
+					note_peaks(context);
+					continue;
+				case 0x16BU:
+					if (not fits_forward(max_steps - retired, 0x16BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE96U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x16DU;
+					note_peaks(context);
+					continue;
+				case 0x16FU:
+					if (not fits_forward(max_steps - retired, 0x16FU, stop_at, 1)) break;
+					context.pc_stack.push(0x16FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x170U;
+					note_peaks(context);
+					continue;
+				case 0x170U:
+					if (not fits_forward(max_steps - retired, 0x170U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x171U;
+					note_peaks(context);
+					continue;
+				case 0x172U:
+					if (not fits_forward(max_steps - retired, 0x172U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x173U;
+					note_peaks(context);
+					continue;
+				case 0x174U:
+					if (not fits_forward(max_steps - retired, 0x174U, stop_at, 1)) break;
+					context.pc_stack.push(0x174U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x175U;
+					note_peaks(context);
+					continue;
+				case 0x175U:
+					if (not fits_forward(max_steps - retired, 0x175U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE8CU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x177U;
+					note_peaks(context);
+					continue;
+				case 0x179U:
+					if (not fits_forward(max_steps - retired, 0x179U, stop_at, 1)) break;
+					context.pc_stack.push(0x179U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x17AU;
+					note_peaks(context);
+					continue;
+				case 0x17AU:
+					if (not fits_forward(max_steps - retired, 0x17AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x17BU;
+					note_peaks(context);
+					continue;
+				case 0x17CU:
+					if (not fits_forward(max_steps - retired, 0x17CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x17DU;
+					note_peaks(context);
+					continue;
+				case 0x17EU:
+					if (not fits_forward(max_steps - retired, 0x17EU, stop_at, 1)) break;
+					context.pc_stack.push(0x17EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x17FU;
+					note_peaks(context);
+					continue;
+				case 0x17FU:
+					if (not fits_forward(max_steps - retired, 0x17FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE82U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x181U;
+					note_peaks(context);
+					continue;
+				case 0x183U:
+					if (not fits_forward(max_steps - retired, 0x183U, stop_at, 1)) break;
+					context.pc_stack.push(0x183U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x184U;
+					note_peaks(context);
+					continue;
+				case 0x184U:
+					if (not fits_forward(max_steps - retired, 0x184U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x185U;
+					note_peaks(context);
+					continue;
+				case 0x186U:
+					if (not fits_forward(max_steps - retired, 0x186U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x187U;
+					note_peaks(context);
+					continue;
+				case 0x188U:
+					if (not fits_forward(max_steps - retired, 0x188U, stop_at, 1)) break;
+					context.pc_stack.push(0x188U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x189U;
+					note_peaks(context);
+					continue;
+				case 0x189U:
+					if (not fits_forward(max_steps - retired, 0x189U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE78U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x18BU;
+					note_peaks(context);
+					continue;
+				case 0x18DU:
+					if (not fits_forward(max_steps - retired, 0x18DU, stop_at, 1)) break;
+					context.pc_stack.push(0x18DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x18EU;
+					note_peaks(context);
+					continue;
+				case 0x18EU:
+					if (not fits_forward(max_steps - retired, 0x18EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x18FU;
+					note_peaks(context);
+					continue;
+				case 0x190U:
+					if (not fits_forward(max_steps - retired, 0x190U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x191U;
+					note_peaks(context);
+					continue;
+				case 0x192U:
+					if (not fits_forward(max_steps - retired, 0x192U, stop_at, 1)) break;
+					context.pc_stack.push(0x192U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x193U;
+					note_peaks(context);
+					continue;
+				case 0x193U:
+					if (not fits_forward(max_steps - retired, 0x193U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE6EU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x195U;
+					note_peaks(context);
+					continue;
+				case 0x197U:
+					if (not fits_forward(max_steps - retired, 0x197U, stop_at, 1)) break;
+					context.pc_stack.push(0x197U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x198U;
+					note_peaks(context);
+					continue;
+				case 0x198U:
+					if (not fits_forward(max_steps - retired, 0x198U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x199U;
+					note_peaks(context);
+					continue;
+				case 0x19AU:
+					if (not fits_forward(max_steps - retired, 0x19AU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x19BU;
+					note_peaks(context);
+					continue;
+				case 0x19CU:
+					if (not fits_forward(max_steps - retired, 0x19CU, stop_at, 1)) break;
+					context.pc_stack.push(0x19CU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x19DU;
+					note_peaks(context);
+					continue;
+				case 0x19DU:
+					if (not fits_forward(max_steps - retired, 0x19DU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE64U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x19FU;
+					note_peaks(context);
+					continue;
+				case 0x1A1U:
+					if (not fits_forward(max_steps - retired, 0x1A1U, stop_at, 1)) break;
+					context.pc_stack.push(0x1A1U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1A2U;
+					note_peaks(context);
+					continue;
+				case 0x1A2U:
+					if (not fits_forward(max_steps - retired, 0x1A2U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1A3U;
+					note_peaks(context);
+					continue;
+				case 0x1A4U:
+					if (not fits_forward(max_steps - retired, 0x1A4U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1A5U;
+					note_peaks(context);
+					continue;
+				case 0x1A6U:
+					if (not fits_forward(max_steps - retired, 0x1A6U, stop_at, 1)) break;
+					context.pc_stack.push(0x1A6U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1A7U;
+					note_peaks(context);
+					continue;
+				case 0x1A7U:
+					if (not fits_forward(max_steps - retired, 0x1A7U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE5AU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1A9U;
+					note_peaks(context);
+					continue;
+				case 0x1ABU:
+					if (not fits_forward(max_steps - retired, 0x1ABU, stop_at, 1)) break;
+					context.pc_stack.push(0x1ABU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1ACU;
+					note_peaks(context);
+					continue;
+				case 0x1ACU:
+					if (not fits_forward(max_steps - retired, 0x1ACU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1ADU;
+					note_peaks(context);
+					continue;
+				case 0x1AEU:
+					if (not fits_forward(max_steps - retired, 0x1AEU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1AFU;
+					note_peaks(context);
+					continue;
+				case 0x1B0U:
+					if (not fits_forward(max_steps - retired, 0x1B0U, stop_at, 1)) break;
+					context.pc_stack.push(0x1B0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1B1U;
+					note_peaks(context);
+					continue;
+				case 0x1B1U:
+					if (not fits_forward(max_steps - retired, 0x1B1U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE50U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1B3U;
+					note_peaks(context);
+					continue;
+				case 0x1B5U:
+					if (not fits_forward(max_steps - retired, 0x1B5U, stop_at, 1)) break;
+					context.pc_stack.push(0x1B5U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1B6U;
+					note_peaks(context);
+					continue;
+				case 0x1B6U:
+					if (not fits_forward(max_steps - retired, 0x1B6U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1B7U;
+					note_peaks(context);
+					continue;
+				case 0x1B8U:
+					if (not fits_forward(max_steps - retired, 0x1B8U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1B9U;
+					note_peaks(context);
+					continue;
+				case 0x1BAU:
+					if (not fits_forward(max_steps - retired, 0x1BAU, stop_at, 1)) break;
+					context.pc_stack.push(0x1BAU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1BBU;
+					note_peaks(context);
+					continue;
+				case 0x1BBU:
+					if (not fits_forward(max_steps - retired, 0x1BBU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE46U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1BDU;
+					note_peaks(context);
+					continue;
+				case 0x1BFU:
+					if (not fits_forward(max_steps - retired, 0x1BFU, stop_at, 1)) break;
+					context.pc_stack.push(0x1BFU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1C0U;
+					note_peaks(context);
+					continue;
+				case 0x1C0U:
+					if (not fits_forward(max_steps - retired, 0x1C0U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1C1U;
+					note_peaks(context);
+					continue;
+				case 0x1C2U:
+					if (not fits_forward(max_steps - retired, 0x1C2U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1C3U;
+					note_peaks(context);
+					continue;
+				case 0x1C4U:
+					if (not fits_forward(max_steps - retired, 0x1C4U, stop_at, 1)) break;
+					context.pc_stack.push(0x1C4U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1C5U;
+					note_peaks(context);
+					continue;
+				case 0x1C5U:
+					if (not fits_forward(max_steps - retired, 0x1C5U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE3CU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1C7U;
+					note_peaks(context);
+					continue;
+				case 0x1C9U:
+					if (not fits_forward(max_steps - retired, 0x1C9U, stop_at, 1)) break;
+					context.pc_stack.push(0x1C9U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1CAU;
+					note_peaks(context);
+					continue;
+				case 0x1CAU:
+					if (not fits_forward(max_steps - retired, 0x1CAU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1CBU;
+					note_peaks(context);
+					continue;
+				case 0x1CCU:
+					if (not fits_forward(max_steps - retired, 0x1CCU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1CDU;
+					note_peaks(context);
+					continue;
+				case 0x1CEU:
+					if (not fits_forward(max_steps - retired, 0x1CEU, stop_at, 1)) break;
+					context.pc_stack.push(0x1CEU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1CFU;
+					note_peaks(context);
+					continue;
+				case 0x1CFU:
+					if (not fits_forward(max_steps - retired, 0x1CFU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE32U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1D1U;
+					note_peaks(context);
+					continue;
+				case 0x1D3U:
+					if (not fits_forward(max_steps - retired, 0x1D3U, stop_at, 1)) break;
+					context.pc_stack.push(0x1D3U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1D4U;
+					note_peaks(context);
+					continue;
+				case 0x1D4U:
+					if (not fits_forward(max_steps - retired, 0x1D4U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1D5U;
+					note_peaks(context);
+					continue;
+				case 0x1D6U:
+					if (not fits_forward(max_steps - retired, 0x1D6U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1D7U;
+					note_peaks(context);
+					continue;
+				case 0x1D8U:
+					if (not fits_forward(max_steps - retired, 0x1D8U, stop_at, 1)) break;
+					context.pc_stack.push(0x1D8U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1D9U;
+					note_peaks(context);
+					continue;
+				case 0x1D9U:
+					if (not fits_forward(max_steps - retired, 0x1D9U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE28U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1DBU;
+					note_peaks(context);
+					continue;
+				case 0x1DDU:
+					if (not fits_forward(max_steps - retired, 0x1DDU, stop_at, 1)) break;
+					context.pc_stack.push(0x1DDU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1DEU;
+					note_peaks(context);
+					continue;
+				case 0x1DEU:
+					if (not fits_forward(max_steps - retired, 0x1DEU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1DFU;
+					note_peaks(context);
+					continue;
+				case 0x1E0U:
+					if (not fits_forward(max_steps - retired, 0x1E0U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1E1U;
+					note_peaks(context);
+					continue;
+				case 0x1E2U:
+					if (not fits_forward(max_steps - retired, 0x1E2U, stop_at, 1)) break;
+					context.pc_stack.push(0x1E2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1E3U;
+					note_peaks(context);
+					continue;
+				case 0x1E3U:
+					if (not fits_forward(max_steps - retired, 0x1E3U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE1EU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1E5U;
+					note_peaks(context);
+					continue;
+				case 0x1E7U:
+					if (not fits_forward(max_steps - retired, 0x1E7U, stop_at, 1)) break;
+					context.pc_stack.push(0x1E7U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1E8U;
+					note_peaks(context);
+					continue;
+				case 0x1E8U:
+					if (not fits_forward(max_steps - retired, 0x1E8U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1E9U;
+					note_peaks(context);
+					continue;
+				case 0x1EAU:
+					if (not fits_forward(max_steps - retired, 0x1EAU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1EBU;
+					note_peaks(context);
+					continue;
+				case 0x1ECU:
+					if (not fits_forward(max_steps - retired, 0x1ECU, stop_at, 1)) break;
+					context.pc_stack.push(0x1ECU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1EDU;
+					note_peaks(context);
+					continue;
+				case 0x1EDU:
+					if (not fits_forward(max_steps - retired, 0x1EDU, stop_at, 2)) break;
+					r[31] += 0xFFFFFE14U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1EFU;
+					note_peaks(context);
+					continue;
+				case 0x1F1U:
+					if (not fits_forward(max_steps - retired, 0x1F1U, stop_at, 1)) break;
+					context.pc_stack.push(0x1F1U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1F2U;
+					note_peaks(context);
+					continue;
+				case 0x1F2U:
+					if (not fits_forward(max_steps - retired, 0x1F2U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1F3U;
+					note_peaks(context);
+					continue;
+				case 0x1F4U:
+					if (not fits_forward(max_steps - retired, 0x1F4U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1F5U;
+					note_peaks(context);
+					continue;
+				case 0x1F6U:
+					if (not fits_forward(max_steps - retired, 0x1F6U, stop_at, 1)) break;
+					context.pc_stack.push(0x1F6U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1F7U;
+					note_peaks(context);
+					continue;
+				case 0x1F7U:
+					if (not fits_forward(max_steps - retired, 0x1F7U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE0AU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x1F9U;
+					note_peaks(context);
+					continue;
+				case 0x1FBU:
+					if (not fits_forward(max_steps - retired, 0x1FBU, stop_at, 1)) break;
+					context.pc_stack.push(0x1FBU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1FCU;
+					note_peaks(context);
+					continue;
+				case 0x1FCU:
+					if (not fits_forward(max_steps - retired, 0x1FCU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1FDU;
+					note_peaks(context);
+					continue;
+				case 0x1FEU:
+					if (not fits_forward(max_steps - retired, 0x1FEU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1FFU;
+					note_peaks(context);
+					continue;
+				case 0x200U:
+					if (not fits_forward(max_steps - retired, 0x200U, stop_at, 1)) break;
+					context.pc_stack.push(0x200U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x201U;
+					note_peaks(context);
+					continue;
+				case 0x201U:
+					if (not fits_forward(max_steps - retired, 0x201U, stop_at, 2)) break;
+					r[31] += 0xFFFFFE00U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x203U;
+					note_peaks(context);
+					continue;
+				case 0x205U:
+					if (not fits_forward(max_steps - retired, 0x205U, stop_at, 1)) break;
+					context.pc_stack.push(0x205U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x206U;
+					note_peaks(context);
+					continue;
+				case 0x206U:
+					if (not fits_forward(max_steps - retired, 0x206U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x207U;
+					note_peaks(context);
+					continue;
+				case 0x208U:
+					if (not fits_forward(max_steps - retired, 0x208U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x209U;
+					note_peaks(context);
+					continue;
+				case 0x20AU:
+					if (not fits_forward(max_steps - retired, 0x20AU, stop_at, 1)) break;
+					context.pc_stack.push(0x20AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x20BU;
+					note_peaks(context);
+					continue;
+				case 0x20BU:
+					if (not fits_forward(max_steps - retired, 0x20BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFDF6U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x20DU;
+					note_peaks(context);
+					continue;
+				case 0x20FU:
+					if (not fits_forward(max_steps - retired, 0x20FU, stop_at, 1)) break;
+					context.pc_stack.push(0x20FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x210U;
+					note_peaks(context);
+					continue;
+				case 0x210U:
+					if (not fits_forward(max_steps - retired, 0x210U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x211U;
+					note_peaks(context);
+					continue;
+				case 0x212U:
+					if (not fits_forward(max_steps - retired, 0x212U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x213U;
+					note_peaks(context);
+					continue;
+				case 0x214U:
+					if (not fits_forward(max_steps - retired, 0x214U, stop_at, 1)) break;
+					context.pc_stack.push(0x214U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x215U;
+					note_peaks(context);
+					continue;
+				case 0x215U:
+					if (not fits_forward(max_steps - retired, 0x215U, stop_at, 2)) break;
+					r[31] += 0xFFFFFDECU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x217U;
+					note_peaks(context);
+					continue;
+				case 0x219U:
+					if (not fits_forward(max_steps - retired, 0x219U, stop_at, 1)) break;
+					context.pc_stack.push(0x219U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x21AU;
+					note_peaks(context);
+					continue;
+				case 0x21AU:
+					if (not fits_forward(max_steps - retired, 0x21AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x21BU;
+					note_peaks(context);
+					continue;
+				case 0x21CU:
+					if (not fits_forward(max_steps - retired, 0x21CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x21DU;
+					note_peaks(context);
+					continue;
+				case 0x21EU:
+					if (not fits_forward(max_steps - retired, 0x21EU, stop_at, 1)) break;
+					context.pc_stack.push(0x21EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x21FU;
+					note_peaks(context);
+					continue;
+				case 0x21FU:
+					if (not fits_forward(max_steps - retired, 0x21FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFDE2U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x221U;
+					note_peaks(context);
+					continue;
+				case 0x223U:
+					if (not fits_forward(max_steps - retired, 0x223U, stop_at, 1)) break;
+					context.pc_stack.push(0x223U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x224U;
+					note_peaks(context);
+					continue;
+				case 0x224U:
+					if (not fits_forward(max_steps - retired, 0x224U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x225U;
+					note_peaks(context);
+					continue;
+				case 0x226U:
+					if (not fits_forward(max_steps - retired, 0x226U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x227U;
+					note_peaks(context);
+					continue;
+				case 0x228U:
+					if (not fits_forward(max_steps - retired, 0x228U, stop_at, 1)) break;
+					context.pc_stack.push(0x228U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x229U;
+					note_peaks(context);
+					continue;
+				case 0x229U:
+					if (not fits_forward(max_steps - retired, 0x229U, stop_at, 2)) break;
+					r[31] += 0xFFFFFDD8U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x22BU;
+					note_peaks(context);
+					continue;
+				case 0x22DU:
+					if (not fits_forward(max_steps - retired, 0x22DU, stop_at, 1)) break;
+					context.pc_stack.push(0x22DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x22EU;
+					note_peaks(context);
+					continue;
+				case 0x22EU:
+					if (not fits_forward(max_steps - retired, 0x22EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x22FU;
+					note_peaks(context);
+					continue;
+				case 0x230U:
+					if (not fits_forward(max_steps - retired, 0x230U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x231U;
+					note_peaks(context);
+					continue;
+				case 0x232U:
+					if (not fits_forward(max_steps - retired, 0x232U, stop_at, 1)) break;
+					context.pc_stack.push(0x232U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x233U;
+					note_peaks(context);
+					continue;
+				case 0x233U:
+					if (not fits_forward(max_steps - retired, 0x233U, stop_at, 2)) break;
+					r[31] += 0xFFFFFDCEU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x235U;
+					note_peaks(context);
+					continue;
+				case 0x237U:
+					if (not fits_forward(max_steps - retired, 0x237U, stop_at, 1)) break;
+					context.pc_stack.push(0x237U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x238U;
+					note_peaks(context);
+					continue;
+				case 0x238U:
+					if (not fits_forward(max_steps - retired, 0x238U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x239U;
+					note_peaks(context);
+					continue;
+				case 0x23AU:
+					if (not fits_forward(max_steps - retired, 0x23AU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x23BU;
+					note_peaks(context);
+					continue;
+				case 0x23CU:
+					if (not fits_forward(max_steps - retired, 0x23CU, stop_at, 1)) break;
+					context.pc_stack.push(0x23CU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x23DU;
+					note_peaks(context);
+					continue;
+				case 0x23DU:
+					if (not fits_forward(max_steps - retired, 0x23DU, stop_at, 2)) break;
+					r[31] += 0xFFFFFDC4U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x23FU;
+					note_peaks(context);
+					continue;
+				case 0x241U:
+					if (not fits_forward(max_steps - retired, 0x241U, stop_at, 1)) break;
+					context.pc_stack.push(0x241U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x242U;
+					note_peaks(context);
+					continue;
+				case 0x242U:
+					if (not fits_forward(max_steps - retired, 0x242U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x243U;
+					note_peaks(context);
+					continue;
+				case 0x244U:
+					if (not fits_forward(max_steps - retired, 0x244U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x245U;
+					note_peaks(context);
+					continue;
+				case 0x246U:
+					if (not fits_forward(max_steps - retired, 0x246U, stop_at, 1)) break;
+					context.pc_stack.push(0x246U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x247U;
+					note_peaks(context);
+					continue;
+				case 0x247U:
+					if (not fits_forward(max_steps - retired, 0x247U, stop_at, 2)) break;
+					r[31] += 0xFFFFFDBAU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x249U;
+					note_peaks(context);
+					continue;
+				case 0x24BU:
+					if (not fits_forward(max_steps - retired, 0x24BU, stop_at, 1)) break;
+					context.pc_stack.push(0x24BU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x24CU;
+					note_peaks(context);
+					continue;
+				case 0x24CU:
+					if (not fits_forward(max_steps - retired, 0x24CU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x24DU;
+					note_peaks(context);
+					continue;
+				case 0x24EU:
+					if (not fits_forward(max_steps - retired, 0x24EU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x24FU;
+					note_peaks(context);
+					continue;
+				case 0x250U:
+					if (not fits_forward(max_steps - retired, 0x250U, stop_at, 1)) break;
+					context.pc_stack.push(0x250U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x251U;
+					note_peaks(context);
+					continue;
+				case 0x251U:
+					if (not fits_forward(max_steps - retired, 0x251U, stop_at, 2)) break;
+					r[31] += 0xFFFFFDB0U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x253U;
+					note_peaks(context);
+					continue;
+				case 0x255U:
+					if (not fits_forward(max_steps - retired, 0x255U, stop_at, 1)) break;
+					context.pc_stack.push(0x255U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x256U;
+					note_peaks(context);
+					continue;
+				case 0x256U:
+					if (not fits_forward(max_steps - retired, 0x256U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x257U;
+					note_peaks(context);
+					continue;
+				case 0x258U:
+					if (not fits_forward(max_steps - retired, 0x258U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x259U;
+					note_peaks(context);
+					continue;
+				case 0x25AU:
+					if (not fits_forward(max_steps - retired, 0x25AU, stop_at, 1)) break;
+					context.pc_stack.push(0x25AU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x25BU;
+					note_peaks(context);
+					continue;
+				case 0x25BU:
+					if (not fits_forward(max_steps - retired, 0x25BU, stop_at, 2)) break;
+					r[31] += 0xFFFFFDA6U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x25DU;
+					note_peaks(context);
+					continue;
+				case 0x25FU:
+					if (not fits_forward(max_steps - retired, 0x25FU, stop_at, 1)) break;
+					context.pc_stack.push(0x25FU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x260U;
+					note_peaks(context);
+					continue;
+				case 0x260U:
+					if (not fits_forward(max_steps - retired, 0x260U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x261U;
+					note_peaks(context);
+					continue;
+				case 0x262U:
+					if (not fits_forward(max_steps - retired, 0x262U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x263U;
+					note_peaks(context);
+					continue;
+				case 0x264U:
+					if (not fits_forward(max_steps - retired, 0x264U, stop_at, 1)) break;
+					context.pc_stack.push(0x264U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x265U;
+					note_peaks(context);
+					continue;
+				case 0x265U:
+					if (not fits_forward(max_steps - retired, 0x265U, stop_at, 2)) break;
+					r[31] += 0xFFFFFD9CU;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x267U;
+					note_peaks(context);
+					continue;
+				case 0x269U:
+					if (not fits_forward(max_steps - retired, 0x269U, stop_at, 1)) break;
+					context.pc_stack.push(0x269U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x26AU;
+					note_peaks(context);
+					continue;
+				case 0x26AU:
+					if (not fits_forward(max_steps - retired, 0x26AU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x26BU;
+					note_peaks(context);
+					continue;
+				case 0x26CU:
+					if (not fits_forward(max_steps - retired, 0x26CU, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x26DU;
+					note_peaks(context);
+					continue;
+				case 0x26EU:
+					if (not fits_forward(max_steps - retired, 0x26EU, stop_at, 1)) break;
+					context.pc_stack.push(0x26EU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x26FU;
+					note_peaks(context);
+					continue;
+				case 0x26FU:
+					if (not fits_forward(max_steps - retired, 0x26FU, stop_at, 2)) break;
+					r[31] += 0xFFFFFD92U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x271U;
+					note_peaks(context);
+					continue;
+				case 0x273U:
+					if (not fits_forward(max_steps - retired, 0x273U, stop_at, 1)) break;
+					context.pc_stack.push(0x273U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x274U;
+					note_peaks(context);
+					continue;
+				case 0x274U:
+					if (not fits_forward(max_steps - retired, 0x274U, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x275U;
+					note_peaks(context);
+					continue;
+				case 0x276U:
+					if (not fits_forward(max_steps - retired, 0x276U, stop_at, 1)) break;
+					r[30] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x277U;
+					note_peaks(context);
+					continue;
+				case 0x278U:
+					if (not fits_forward(max_steps - retired, 0x278U, stop_at, 1)) break;
+					context.pc_stack.push(0x278U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x279U;
+					note_peaks(context);
+					continue;
+				case 0x279U:
+					if (not fits_forward(max_steps - retired, 0x279U, stop_at, 2)) break;
+					r[31] += 0xFFFFFD88U;
+					r[30] += 0xFFFFFFFFU;
+					retired += 2;
+					context.retired += 2;
+					context.counter = 0x27BU;
+					note_peaks(context);
+					continue;
+				case 0x27DU:
+					if (not fits_forward(max_steps - retired, 0x27DU, stop_at, 1)) break;
+					context.pc_stack.push(0x27DU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x27EU;
+					note_peaks(context);
+					continue;
+				case 0x27EU:
+					if (not fits_forward(max_steps - retired, 0x27EU, stop_at, 1)) break;
+					r[29] += 0x1U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x27FU;
+					note_peaks(context);
+					continue;
+				case 0x280U:
+					if (not fits_forward(max_steps - retired, 0x280U, stop_at, 1)) break;
+					context.pc_stack.push(0x280U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x281U;
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x1U:
+					if (not fits_reverse(max_steps - retired, 0x1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3U:
+					if (not fits_reverse(max_steps - retired, 0x3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x5U:
+					if (not fits_reverse(max_steps - retired, 0x5U, stop_at, 2)) break;
+					r[0] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFFEU;
+					context.counter = 0x3U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x8U:
+					if (not fits_reverse(max_steps - retired, 0x8U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x8U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x9U:
+					if (not fits_reverse(max_steps - retired, 0x9U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xBU:
+					if (not fits_reverse(max_steps - retired, 0xBU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xDU:
+					if (not fits_reverse(max_steps - retired, 0xDU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xDU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xFU:
+					if (not fits_reverse(max_steps - retired, 0xFU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFF4U;
+					context.counter = 0xDU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x12U:
+					if (not fits_reverse(max_steps - retired, 0x12U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x12U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x13U:
+					if (not fits_reverse(max_steps - retired, 0x13U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x12U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x15U:
+					if (not fits_reverse(max_steps - retired, 0x15U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x14U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x17U:
+					if (not fits_reverse(max_steps - retired, 0x17U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x17U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x19U:
+					if (not fits_reverse(max_steps - retired, 0x19U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFEAU;
+					context.counter = 0x17U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1CU:
+					if (not fits_reverse(max_steps - retired, 0x1CU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1CU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1DU:
+					if (not fits_reverse(max_steps - retired, 0x1DU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1FU:
+					if (not fits_reverse(max_steps - retired, 0x1FU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x21U:
+					if (not fits_reverse(max_steps - retired, 0x21U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x21U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x23U:
+					if (not fits_reverse(max_steps - retired, 0x23U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFE0U;
+					context.counter = 0x21U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x26U:
+					if (not fits_reverse(max_steps - retired, 0x26U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x26U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x27U:
+					if (not fits_reverse(max_steps - retired, 0x27U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x26U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x29U:
+					if (not fits_reverse(max_steps - retired, 0x29U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x28U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x2BU:
+					if (not fits_reverse(max_steps - retired, 0x2BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x2BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x2DU:
+					if (not fits_reverse(max_steps - retired, 0x2DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFD6U;
+					context.counter = 0x2BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x30U:
+					if (not fits_reverse(max_steps - retired, 0x30U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x30U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x31U:
+					if (not fits_reverse(max_steps - retired, 0x31U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x30U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x33U:
+					if (not fits_reverse(max_steps - retired, 0x33U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x32U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x35U:
+					if (not fits_reverse(max_steps - retired, 0x35U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x35U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x37U:
+					if (not fits_reverse(max_steps - retired, 0x37U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFCCU;
+					context.counter = 0x35U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x3AU:
+					if (not fits_reverse(max_steps - retired, 0x3AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3BU:
+					if (not fits_reverse(max_steps - retired, 0x3BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x3AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3DU:
+					if (not fits_reverse(max_steps - retired, 0x3DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x3CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3FU:
+					if (not fits_reverse(max_steps - retired, 0x3FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x41U:
+					if (not fits_reverse(max_steps - retired, 0x41U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFC2U;
+					context.counter = 0x3FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x44U:
+					if (not fits_reverse(max_steps - retired, 0x44U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x44U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x45U:
+					if (not fits_reverse(max_steps - retired, 0x45U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x44U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x47U:
+					if (not fits_reverse(max_steps - retired, 0x47U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x46U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x49U:
+					if (not fits_reverse(max_steps - retired, 0x49U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x49U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x4BU:
+					if (not fits_reverse(max_steps - retired, 0x4BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFB8U;
+					context.counter = 0x49U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x4EU:
+					if (not fits_reverse(max_steps - retired, 0x4EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x4EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x4FU:
+					if (not fits_reverse(max_steps - retired, 0x4FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x4EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x51U:
+					if (not fits_reverse(max_steps - retired, 0x51U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x50U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x53U:
+					if (not fits_reverse(max_steps - retired, 0x53U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x53U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x55U:
+					if (not fits_reverse(max_steps - retired, 0x55U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFAEU;
+					context.counter = 0x53U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x58U:
+					if (not fits_reverse(max_steps - retired, 0x58U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x58U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x59U:
+					if (not fits_reverse(max_steps - retired, 0x59U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x58U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x5BU:
+					if (not fits_reverse(max_steps - retired, 0x5BU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x5AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x5DU:
+					if (not fits_reverse(max_steps - retired, 0x5DU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x5DU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x5FU:
+					if (not fits_reverse(max_steps - retired, 0x5FU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFFA4U;
+					context.counter = 0x5DU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x62U:
+					if (not fits_reverse(max_steps - retired, 0x62U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x62U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x63U:
+					if (not fits_reverse(max_steps - retired, 0x63U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x62U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x65U:
+					if (not fits_reverse(max_steps - retired, 0x65U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x64U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x67U:
+					if (not fits_reverse(max_steps - retired, 0x67U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x67U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x69U:
+					if (not fits_reverse(max_steps - retired, 0x69U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF9AU;
+					context.counter = 0x67U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x6CU:
+					if (not fits_reverse(max_steps - retired, 0x6CU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x6CU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x6DU:
+					if (not fits_reverse(max_steps - retired, 0x6DU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x6CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x6FU:
+					if (not fits_reverse(max_steps - retired, 0x6FU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x6EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x71U:
+					if (not fits_reverse(max_steps - retired, 0x71U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x71U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x73U:
+					if (not fits_reverse(max_steps - retired, 0x73U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF90U;
+					context.counter = 0x71U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x76U:
+					if (not fits_reverse(max_steps - retired, 0x76U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x76U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x77U:
+					if (not fits_reverse(max_steps - retired, 0x77U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x76U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x79U:
+					if (not fits_reverse(max_steps - retired, 0x79U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x78U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x7BU:
+					if (not fits_reverse(max_steps - retired, 0x7BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x7BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x7DU:
+					if (not fits_reverse(max_steps - retired, 0x7DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF86U;
+					context.counter = 0x7BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x80U:
+					if (not fits_reverse(max_steps - retired, 0x80U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x80U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x81U:
+					if (not fits_reverse(max_steps - retired, 0x81U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x80U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x83U:
+					if (not fits_reverse(max_steps - retired, 0x83U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x82U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x85U:
+					if (not fits_reverse(max_steps - retired, 0x85U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x85U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x87U:
+					if (not fits_reverse(max_steps - retired, 0x87U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF7CU;
+					context.counter = 0x85U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x8AU:
+					if (not fits_reverse(max_steps - retired, 0x8AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x8AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x8BU:
+					if (not fits_reverse(max_steps - retired, 0x8BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x8AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x8DU:
+					if (not fits_reverse(max_steps - retired, 0x8DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x8CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x8FU:
+					if (not fits_reverse(max_steps - retired, 0x8FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x8FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x91U:
+					if (not fits_reverse(max_steps - retired, 0x91U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF72U;
+					context.counter = 0x8FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x94U:
+					if (not fits_reverse(max_steps - retired, 0x94U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x94U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x95U:
+					if (not fits_reverse(max_steps - retired, 0x95U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x94U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x97U:
+					if (not fits_reverse(max_steps - retired, 0x97U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x96U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x99U:
+					if (not fits_reverse(max_steps - retired, 0x99U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x99U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x9BU:
+					if (not fits_reverse(max_steps - retired, 0x9BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF68U;
+					context.counter = 0x99U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x9EU:
+					if (not fits_reverse(max_steps - retired, 0x9EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x9EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x9FU:
+					if (not fits_reverse(max_steps - retired, 0x9FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x9EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xA1U:
+					if (not fits_reverse(max_steps - retired, 0xA1U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xA0U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xA3U:
+					if (not fits_reverse(max_steps - retired, 0xA3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xA3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xA5U:
+					if (not fits_reverse(max_steps - retired, 0xA5U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF5EU;
+					context.counter = 0xA3U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xA8U:
+					if (not fits_reverse(max_steps - retired, 0xA8U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xA8U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xA9U:
+					if (not fits_reverse(max_steps - retired, 0xA9U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xA8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xABU:
+					if (not fits_reverse(max_steps - retired, 0xABU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xAAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xADU:
+					if (not fits_reverse(max_steps - retired, 0xADU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xADU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xAFU:
+					if (not fits_reverse(max_steps - retired, 0xAFU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF54U;
+					context.counter = 0xADU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xB2U:
+					if (not fits_reverse(max_steps - retired, 0xB2U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xB2U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xB3U:
+					if (not fits_reverse(max_steps - retired, 0xB3U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xB2U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xB5U:
+					if (not fits_reverse(max_steps - retired, 0xB5U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xB4U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xB7U:
+					if (not fits_reverse(max_steps - retired, 0xB7U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xB7U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xB9U:
+					if (not fits_reverse(max_steps - retired, 0xB9U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF4AU;
+					context.counter = 0xB7U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xBCU:
+					if (not fits_reverse(max_steps - retired, 0xBCU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xBCU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xBDU:
+					if (not fits_reverse(max_steps - retired, 0xBDU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xBCU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xBFU:
+					if (not fits_reverse(max_steps - retired, 0xBFU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xBEU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xC1U:
+					if (not fits_reverse(max_steps - retired, 0xC1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xC1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xC3U:
+					if (not fits_reverse(max_steps - retired, 0xC3U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF40U;
+					context.counter = 0xC1U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xC6U:
+					if (not fits_reverse(max_steps - retired, 0xC6U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xC6U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xC7U:
+					if (not fits_reverse(max_steps - retired, 0xC7U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xC6U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xC9U:
+					if (not fits_reverse(max_steps - retired, 0xC9U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xC8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xCBU:
+					if (not fits_reverse(max_steps - retired, 0xCBU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xCBU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xCDU:
+					if (not fits_reverse(max_steps - retired, 0xCDU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF36U;
+					context.counter = 0xCBU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xD0U:
+					if (not fits_reverse(max_steps - retired, 0xD0U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xD0U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xD1U:
+					if (not fits_reverse(max_steps - retired, 0xD1U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xD0U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xD3U:
+					if (not fits_reverse(max_steps - retired, 0xD3U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xD2U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xD5U:
+					if (not fits_reverse(max_steps - retired, 0xD5U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xD5U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xD7U:
+					if (not fits_reverse(max_steps - retired, 0xD7U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF2CU;
+					context.counter = 0xD5U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xDAU:
+					if (not fits_reverse(max_steps - retired, 0xDAU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xDAU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xDBU:
+					if (not fits_reverse(max_steps - retired, 0xDBU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xDAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xDDU:
+					if (not fits_reverse(max_steps - retired, 0xDDU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xDCU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xDFU:
+					if (not fits_reverse(max_steps - retired, 0xDFU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xDFU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xE1U:
+					if (not fits_reverse(max_steps - retired, 0xE1U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF22U;
+					context.counter = 0xDFU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xE4U:
+					if (not fits_reverse(max_steps - retired, 0xE4U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xE4U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xE5U:
+					if (not fits_reverse(max_steps - retired, 0xE5U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xE4U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xE7U:
+					if (not fits_reverse(max_steps - retired, 0xE7U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xE6U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xE9U:
+					if (not fits_reverse(max_steps - retired, 0xE9U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xE9U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xEBU:
+					if (not fits_reverse(max_steps - retired, 0xEBU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF18U;
+					context.counter = 0xE9U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xEEU:
+					if (not fits_reverse(max_steps - retired, 0xEEU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xEEU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xEFU:
+					if (not fits_reverse(max_steps - retired, 0xEFU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xEEU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xF1U:
+					if (not fits_reverse(max_steps - retired, 0xF1U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xF0U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xF3U:
+					if (not fits_reverse(max_steps - retired, 0xF3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xF3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xF5U:
+					if (not fits_reverse(max_steps - retired, 0xF5U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF0EU;
+					context.counter = 0xF3U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xF8U:
+					if (not fits_reverse(max_steps - retired, 0xF8U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xF8U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xF9U:
+					if (not fits_reverse(max_steps - retired, 0xF9U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0xF8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xFBU:
+					if (not fits_reverse(max_steps - retired, 0xFBU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0xFAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xFDU:
+					if (not fits_reverse(max_steps - retired, 0xFDU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xFDU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xFFU:
+					if (not fits_reverse(max_steps - retired, 0xFFU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFF04U;
+					context.counter = 0xFDU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x102U:
+					if (not fits_reverse(max_steps - retired, 0x102U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x102U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x103U:
+					if (not fits_reverse(max_steps - retired, 0x103U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x102U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x105U:
+					if (not fits_reverse(max_steps - retired, 0x105U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x104U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x107U:
+					if (not fits_reverse(max_steps - retired, 0x107U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x107U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x109U:
+					if (not fits_reverse(max_steps - retired, 0x109U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEFAU;
+					context.counter = 0x107U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x10CU:
+					if (not fits_reverse(max_steps - retired, 0x10CU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x10CU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x10DU:
+					if (not fits_reverse(max_steps - retired, 0x10DU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x10CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x10FU:
+					if (not fits_reverse(max_steps - retired, 0x10FU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x10EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x111U:
+					if (not fits_reverse(max_steps - retired, 0x111U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x111U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x113U:
+					if (not fits_reverse(max_steps - retired, 0x113U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEF0U;
+					context.counter = 0x111U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x116U:
+					if (not fits_reverse(max_steps - retired, 0x116U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x116U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x117U:
+					if (not fits_reverse(max_steps - retired, 0x117U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x116U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x119U:
+					if (not fits_reverse(max_steps - retired, 0x119U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x118U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x11BU:
+					if (not fits_reverse(max_steps - retired, 0x11BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x11BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x11DU:
+					if (not fits_reverse(max_steps - retired, 0x11DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEE6U;
+					context.counter = 0x11BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x120U:
+					if (not fits_reverse(max_steps - retired, 0x120U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x120U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x121U:
+					if (not fits_reverse(max_steps - retired, 0x121U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x120U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x123U:
+					if (not fits_reverse(max_steps - retired, 0x123U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x122U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x125U:
+					if (not fits_reverse(max_steps - retired, 0x125U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x125U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x127U:
+					if (not fits_reverse(max_steps - retired, 0x127U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEDCU;
+					context.counter = 0x125U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x12AU:
+					if (not fits_reverse(max_steps - retired, 0x12AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x12AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x12BU:
+					if (not fits_reverse(max_steps - retired, 0x12BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x12AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x12DU:
+					if (not fits_reverse(max_steps - retired, 0x12DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x12CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x12FU:
+					if (not fits_reverse(max_steps - retired, 0x12FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x12FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x131U:
+					if (not fits_reverse(max_steps - retired, 0x131U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFED2U;
+					context.counter = 0x12FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x134U:
+					if (not fits_reverse(max_steps - retired, 0x134U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x134U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x135U:
+					if (not fits_reverse(max_steps - retired, 0x135U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x134U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x137U:
+					if (not fits_reverse(max_steps - retired, 0x137U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x136U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x139U:
+					if (not fits_reverse(max_steps - retired, 0x139U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x139U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x13BU:
+					if (not fits_reverse(max_steps - retired, 0x13BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEC8U;
+					context.counter = 0x139U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x13EU:
+					if (not fits_reverse(max_steps - retired, 0x13EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x13EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x13FU:
+					if (not fits_reverse(max_steps - retired, 0x13FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x13EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x141U:
+					if (not fits_reverse(max_steps - retired, 0x141U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x140U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x143U:
+					if (not fits_reverse(max_steps - retired, 0x143U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x143U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x145U:
+					if (not fits_reverse(max_steps - retired, 0x145U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEBEU;
+					context.counter = 0x143U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x148U:
+					if (not fits_reverse(max_steps - retired, 0x148U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x148U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x149U:
+					if (not fits_reverse(max_steps - retired, 0x149U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x148U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x14BU:
+					if (not fits_reverse(max_steps - retired, 0x14BU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x14AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x14DU:
+					if (not fits_reverse(max_steps - retired, 0x14DU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x14DU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x14FU:
+					if (not fits_reverse(max_steps - retired, 0x14FU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEB4U;
+					context.counter = 0x14DU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x152U:
+					if (not fits_reverse(max_steps - retired, 0x152U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x152U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x153U:
+					if (not fits_reverse(max_steps - retired, 0x153U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x152U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x155U:
+					if (not fits_reverse(max_steps - retired, 0x155U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x154U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x157U:
+					if (not fits_reverse(max_steps - retired, 0x157U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x157U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x159U:
+					if (not fits_reverse(max_steps - retired, 0x159U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEAAU;
+					context.counter = 0x157U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x15CU:
+					if (not fits_reverse(max_steps - retired, 0x15CU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x15CU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x15DU:
+					if (not fits_reverse(max_steps - retired, 0x15DU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x15CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x15FU:
+					if (not fits_reverse(max_steps - retired, 0x15FU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x15EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x161U:
+					if (not fits_reverse(max_steps - retired, 0x161U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x161U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x163U:
+					if (not fits_reverse(max_steps - retired, 0x163U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFEA0U;
+					context.counter = 0x161U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x166U:
+					if (not fits_reverse(max_steps - retired, 0x166U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x166U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x167U:
+					if (not fits_reverse(max_steps - retired, 0x167U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x166U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x169U:
+					if (not fits_reverse(max_steps - retired, 0x169U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x168U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x16BU:
+					if (not fits_reverse(max_steps - retired, 0x16BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x16BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x16DU:
+					if (not fits_reverse(max_steps - retired, 0x16DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE96U;
+					context.counter = 0x16BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x170U:
+					if (not fits_reverse(max_steps - retired, 0x170U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x170U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x171U:
+					if (not fits_reverse(max_steps - retired, 0x171U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x170U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x173U:
+					if (not fits_reverse(max_steps - retired, 0x173U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x172U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x175U:
+					if (not fits_reverse(max_steps - retired, 0x175U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x175U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x177U:
+					if (not fits_reverse(max_steps - retired, 0x177U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE8CU;
+					context.counter = 0x175U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x17AU:
+					if (not fits_reverse(max_steps - retired, 0x17AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x17AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x17BU:
+					if (not fits_reverse(max_steps - retired, 0x17BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x17AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x17DU:
+					if (not fits_reverse(max_steps - retired, 0x17DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x17CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x17FU:
+					if (not fits_reverse(max_steps - retired, 0x17FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x17FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x181U:
+					if (not fits_reverse(max_steps - retired, 0x181U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE82U;
+					context.counter = 0x17FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x184U:
+					if (not fits_reverse(max_steps - retired, 0x184U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x184U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x185U:
+					if (not fits_reverse(max_steps - retired, 0x185U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x184U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x187U:
+					if (not fits_reverse(max_steps - retired, 0x187U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x186U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x189U:
+					if (not fits_reverse(max_steps - retired, 0x189U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x189U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x18BU:
+					if (not fits_reverse(max_steps - retired, 0x18BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE78U;
+					context.counter = 0x189U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x18EU:
+					if (not fits_reverse(max_steps - retired, 0x18EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x18EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x18FU:
+					if (not fits_reverse(max_steps - retired, 0x18FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x18EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x191U:
+					if (not fits_reverse(max_steps - retired, 0x191U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x190U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x193U:
+					if (not fits_reverse(max_steps - retired, 0x193U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x193U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x195U:
+					if (not fits_reverse(max_steps - retired, 0x195U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE6EU;
+					context.counter = 0x193U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x198U:
+					if (not fits_reverse(max_steps - retired, 0x198U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x198U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x199U:
+					if (not fits_reverse(max_steps - retired, 0x199U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x198U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x19BU:
+					if (not fits_reverse(max_steps - retired, 0x19BU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x19AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x19DU:
+					if (not fits_reverse(max_steps - retired, 0x19DU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x19DU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x19FU:
+					if (not fits_reverse(max_steps - retired, 0x19FU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE64U;
+					context.counter = 0x19DU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1A2U:
+					if (not fits_reverse(max_steps - retired, 0x1A2U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1A2U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1A3U:
+					if (not fits_reverse(max_steps - retired, 0x1A3U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1A2U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1A5U:
+					if (not fits_reverse(max_steps - retired, 0x1A5U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1A4U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1A7U:
+					if (not fits_reverse(max_steps - retired, 0x1A7U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1A7U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1A9U:
+					if (not fits_reverse(max_steps - retired, 0x1A9U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE5AU;
+					context.counter = 0x1A7U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1ACU:
+					if (not fits_reverse(max_steps - retired, 0x1ACU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1ACU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1ADU:
+					if (not fits_reverse(max_steps - retired, 0x1ADU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1ACU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1AFU:
+					if (not fits_reverse(max_steps - retired, 0x1AFU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1AEU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1B1U:
+					if (not fits_reverse(max_steps - retired, 0x1B1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1B1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1B3U:
+					if (not fits_reverse(max_steps - retired, 0x1B3U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE50U;
+					context.counter = 0x1B1U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1B6U:
+					if (not fits_reverse(max_steps - retired, 0x1B6U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1B6U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1B7U:
+					if (not fits_reverse(max_steps - retired, 0x1B7U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1B6U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1B9U:
+					if (not fits_reverse(max_steps - retired, 0x1B9U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1B8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1BBU:
+					if (not fits_reverse(max_steps - retired, 0x1BBU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1BBU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1BDU:
+					if (not fits_reverse(max_steps - retired, 0x1BDU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE46U;
+					context.counter = 0x1BBU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1C0U:
+					if (not fits_reverse(max_steps - retired, 0x1C0U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1C0U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1C1U:
+					if (not fits_reverse(max_steps - retired, 0x1C1U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1C0U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1C3U:
+					if (not fits_reverse(max_steps - retired, 0x1C3U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1C2U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1C5U:
+					if (not fits_reverse(max_steps - retired, 0x1C5U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1C5U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1C7U:
+					if (not fits_reverse(max_steps - retired, 0x1C7U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE3CU;
+					context.counter = 0x1C5U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1CAU:
+					if (not fits_reverse(max_steps - retired, 0x1CAU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1CAU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1CBU:
+					if (not fits_reverse(max_steps - retired, 0x1CBU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1CAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1CDU:
+					if (not fits_reverse(max_steps - retired, 0x1CDU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1CCU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1CFU:
+					if (not fits_reverse(max_steps - retired, 0x1CFU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1CFU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1D1U:
+					if (not fits_reverse(max_steps - retired, 0x1D1U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE32U;
+					context.counter = 0x1CFU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1D4U:
+					if (not fits_reverse(max_steps - retired, 0x1D4U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1D4U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1D5U:
+					if (not fits_reverse(max_steps - retired, 0x1D5U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1D4U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1D7U:
+					if (not fits_reverse(max_steps - retired, 0x1D7U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1D6U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1D9U:
+					if (not fits_reverse(max_steps - retired, 0x1D9U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1D9U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1DBU:
+					if (not fits_reverse(max_steps - retired, 0x1DBU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE28U;
+					context.counter = 0x1D9U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1DEU:
+					if (not fits_reverse(max_steps - retired, 0x1DEU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1DEU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1DFU:
+					if (not fits_reverse(max_steps - retired, 0x1DFU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1DEU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1E1U:
+					if (not fits_reverse(max_steps - retired, 0x1E1U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1E0U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1E3U:
+					if (not fits_reverse(max_steps - retired, 0x1E3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1E3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1E5U:
+					if (not fits_reverse(max_steps - retired, 0x1E5U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE1EU;
+					context.counter = 0x1E3U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1E8U:
+					if (not fits_reverse(max_steps - retired, 0x1E8U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1E8U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1E9U:
+					if (not fits_reverse(max_steps - retired, 0x1E9U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1E8U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1EBU:
+					if (not fits_reverse(max_steps - retired, 0x1EBU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1EAU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1EDU:
+					if (not fits_reverse(max_steps - retired, 0x1EDU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1EDU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1EFU:
+					if (not fits_reverse(max_steps - retired, 0x1EFU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE14U;
+					context.counter = 0x1EDU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1F2U:
+					if (not fits_reverse(max_steps - retired, 0x1F2U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1F2U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1F3U:
+					if (not fits_reverse(max_steps - retired, 0x1F3U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1F2U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1F5U:
+					if (not fits_reverse(max_steps - retired, 0x1F5U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1F4U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1F7U:
+					if (not fits_reverse(max_steps - retired, 0x1F7U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1F7U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1F9U:
+					if (not fits_reverse(max_steps - retired, 0x1F9U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE0AU;
+					context.counter = 0x1F7U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x1FCU:
+					if (not fits_reverse(max_steps - retired, 0x1FCU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1FCU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1FDU:
+					if (not fits_reverse(max_steps - retired, 0x1FDU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x1FCU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x1FFU:
+					if (not fits_reverse(max_steps - retired, 0x1FFU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x1FEU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x201U:
+					if (not fits_reverse(max_steps - retired, 0x201U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x201U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x203U:
+					if (not fits_reverse(max_steps - retired, 0x203U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFE00U;
+					context.counter = 0x201U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x206U:
+					if (not fits_reverse(max_steps - retired, 0x206U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x206U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x207U:
+					if (not fits_reverse(max_steps - retired, 0x207U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x206U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x209U:
+					if (not fits_reverse(max_steps - retired, 0x209U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x208U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x20BU:
+					if (not fits_reverse(max_steps - retired, 0x20BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x20BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x20DU:
+					if (not fits_reverse(max_steps - retired, 0x20DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDF6U;
+					context.counter = 0x20BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x210U:
+					if (not fits_reverse(max_steps - retired, 0x210U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x210U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x211U:
+					if (not fits_reverse(max_steps - retired, 0x211U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x210U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x213U:
+					if (not fits_reverse(max_steps - retired, 0x213U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x212U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x215U:
+					if (not fits_reverse(max_steps - retired, 0x215U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x215U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x217U:
+					if (not fits_reverse(max_steps - retired, 0x217U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDECU;
+					context.counter = 0x215U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x21AU:
+					if (not fits_reverse(max_steps - retired, 0x21AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x21AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x21BU:
+					if (not fits_reverse(max_steps - retired, 0x21BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x21AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x21DU:
+					if (not fits_reverse(max_steps - retired, 0x21DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x21CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x21FU:
+					if (not fits_reverse(max_steps - retired, 0x21FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x21FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x221U:
+					if (not fits_reverse(max_steps - retired, 0x221U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDE2U;
+					context.counter = 0x21FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x224U:
+					if (not fits_reverse(max_steps - retired, 0x224U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x224U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x225U:
+					if (not fits_reverse(max_steps - retired, 0x225U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x224U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x227U:
+					if (not fits_reverse(max_steps - retired, 0x227U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x226U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x229U:
+					if (not fits_reverse(max_steps - retired, 0x229U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x229U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x22BU:
+					if (not fits_reverse(max_steps - retired, 0x22BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDD8U;
+					context.counter = 0x229U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x22EU:
+					if (not fits_reverse(max_steps - retired, 0x22EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x22EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x22FU:
+					if (not fits_reverse(max_steps - retired, 0x22FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x22EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x231U:
+					if (not fits_reverse(max_steps - retired, 0x231U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x230U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x233U:
+					if (not fits_reverse(max_steps - retired, 0x233U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x233U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x235U:
+					if (not fits_reverse(max_steps - retired, 0x235U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDCEU;
+					context.counter = 0x233U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x238U:
+					if (not fits_reverse(max_steps - retired, 0x238U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x238U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x239U:
+					if (not fits_reverse(max_steps - retired, 0x239U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x238U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x23BU:
+					if (not fits_reverse(max_steps - retired, 0x23BU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x23AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x23DU:
+					if (not fits_reverse(max_steps - retired, 0x23DU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x23DU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x23FU:
+					if (not fits_reverse(max_steps - retired, 0x23FU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDC4U;
+					context.counter = 0x23DU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x242U:
+					if (not fits_reverse(max_steps - retired, 0x242U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x242U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x243U:
+					if (not fits_reverse(max_steps - retired, 0x243U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x242U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x245U:
+					if (not fits_reverse(max_steps - retired, 0x245U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x244U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x247U:
+					if (not fits_reverse(max_steps - retired, 0x247U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x247U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x249U:
+					if (not fits_reverse(max_steps - retired, 0x249U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDBAU;
+					context.counter = 0x247U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x24CU:
+					if (not fits_reverse(max_steps - retired, 0x24CU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x24CU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x24DU:
+					if (not fits_reverse(max_steps - retired, 0x24DU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x24CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x24FU:
+					if (not fits_reverse(max_steps - retired, 0x24FU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x24EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x251U:
+					if (not fits_reverse(max_steps - retired, 0x251U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x251U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x253U:
+					if (not fits_reverse(max_steps - retired, 0x253U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDB0U;
+					context.counter = 0x251U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x256U:
+					if (not fits_reverse(max_steps - retired, 0x256U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x256U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x257U:
+					if (not fits_reverse(max_steps - retired, 0x257U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x256U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x259U:
+					if (not fits_reverse(max_steps - retired, 0x259U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x258U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x25BU:
+					if (not fits_reverse(max_steps - retired, 0x25BU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x25BU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x25DU:
+					if (not fits_reverse(max_steps - retired, 0x25DU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFDA6U;
+					context.counter = 0x25BU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x260U:
+					if (not fits_reverse(max_steps - retired, 0x260U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x260U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x261U:
+					if (not fits_reverse(max_steps - retired, 0x261U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x260U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x263U:
+					if (not fits_reverse(max_steps - retired, 0x263U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x262U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x265U:
+					if (not fits_reverse(max_steps - retired, 0x265U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x265U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x267U:
+					if (not fits_reverse(max_steps - retired, 0x267U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFD9CU;
+					context.counter = 0x265U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x26AU:
+					if (not fits_reverse(max_steps - retired, 0x26AU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x26AU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x26BU:
+					if (not fits_reverse(max_steps - retired, 0x26BU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x26AU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x26DU:
+					if (not fits_reverse(max_steps - retired, 0x26DU, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x26CU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x26FU:
+					if (not fits_reverse(max_steps - retired, 0x26FU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x26FU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x271U:
+					if (not fits_reverse(max_steps - retired, 0x271U, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFD92U;
+					context.counter = 0x26FU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x274U:
+					if (not fits_reverse(max_steps - retired, 0x274U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x274U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x275U:
+					if (not fits_reverse(max_steps - retired, 0x275U, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x274U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x277U:
+					if (not fits_reverse(max_steps - retired, 0x277U, stop_at, 1)) break;
+					r[30] -= 0x1U;
+					context.counter = 0x276U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x279U:
+					if (not fits_reverse(max_steps - retired, 0x279U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x279U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x27BU:
+					if (not fits_reverse(max_steps - retired, 0x27BU, stop_at, 2)) break;
+					r[30] -= 0xFFFFFFFFU;
+					r[31] -= 0xFFFFFD88U;
+					context.counter = 0x279U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0x27EU:
+					if (not fits_reverse(max_steps - retired, 0x27EU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x27EU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x27FU:
+					if (not fits_reverse(max_steps - retired, 0x27FU, stop_at, 1)) break;
+					r[29] -= 0x1U;
+					context.counter = 0x27EU;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x281U:
+					if (not fits_reverse(max_steps - retired, 0x281U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x281U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_call_chain_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+// bubble-sort: 79 words, 13 runs.
+static const metronome32::translated::word translated_bubble_sort_words[] = {
+	{0x0U, 0x34000000U},
+	{0x1U, 0x60C0002FU},
+	{0x2U, 0x34000000U},
+	{0x3U, 0x60E0002FU},
+	{0x4U, 0x34000000U},
+	{0x7U, 0xA20001U},
+	{0x8U, 0xA10400U},
+	{0x9U, 0x30050002U},
+	{0xBU, 0x34000000U},
+	{0xCU, 0x220040U},
+	{0xDU, 0x410040U},
+	{0xEU, 0x220040U},
+	{0xFU, 0x34000000U},
+	{0x10U, 0x70A00000U},
+	{0x13U, 0x60600001U},
+	{0x14U, 0x60800001U},
+	{0x15U, 0x60FFFFFFU},
+	{0x16U, 0x3007FFEEU},
+	{0x17U, 0x607FFFD1U},
+	{0x18U, 0x609FFFD1U},
+	{0x19U, 0x60DFFFFFU},
+	{0x1AU, 0x3006FFE8U},
+	{0x1BU, 0x60600030U},
+	{0x1CU, 0x60800030U},
+	{0x1DU, 0x613FFFFFU},
+	{0x1EU, 0x3009FFE2U},
+	{0, 0},
+};
+
+std::uint64_t translated_bubble_sort(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 26;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_bubble_sort_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					context.pc_stack.push(0x0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1U;
+					note_peaks(context);
+					continue;
+				case 0x1U:
+					if (not fits_forward(max_steps - retired, 0x1U, stop_at, 1)) break;
+					r[6] += 0x2FU;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x2U;
+					note_peaks(context);
+					continue;
+				case 0x2U:
+					if (not fits_forward(max_steps - retired, 0x2U, stop_at, 1)) break;
+					context.pc_stack.push(0x2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3U;
+					note_peaks(context);
+					continue;
+				case 0x3U:
+					if (not fits_forward(max_steps - retired, 0x3U, stop_at, 1)) break;
+					r[7] += 0x2FU;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x4U;
+					note_peaks(context);
+					continue;
+				case 0x4U:
+					if (not fits_forward(max_steps - retired, 0x4U, stop_at, 1)) break;
+					context.pc_stack.push(0x4U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x5U;
+					note_peaks(context);
+					continue;
+				case 0x7U:
+					if (not fits_forward(max_steps - retired, 0x7U, stop_at, 3)) break;
+					r[5] += r[2];
+					dp.push(r[5]);
+					r[5] = less(r[5], r[1]);
+					retired += 3;
+					context.retired += 3;
+					if (r[5] >> 31 == 0 and r[5] != 0) {
+						context.pc_stack.push(0x9U);
+						context.counter = 0xCU;
+					} else {
+						context.counter = 0xAU;
+					}
+					note_peaks(context);
+					continue;
+				case 0xBU:
+					if (not fits_forward(max_steps - retired, 0xBU, stop_at, 1)) break;
+					context.pc_stack.push(0xBU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0xCU;
+					note_peaks(context);
+					continue;
+				case 0xCU:
+					if (not fits_forward(max_steps - retired, 0xCU, stop_at, 3)) break;
+					r[1] ^= r[2];
+					r[2] ^= r[1];
+					r[1] ^= r[2];
+					retired += 3;
+					context.retired += 3;
+					context.counter = 0xFU;
+					note_peaks(context);
+					continue;
+				case 0xFU:
+					if (not fits_forward(max_steps - retired, 0xFU, stop_at, 1)) break;
+					context.pc_stack.push(0xFU);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x10U;
+					note_peaks(context);
+					continue;
+				case 0x10U:
+					if (not fits_forward(max_steps - retired, 0x10U, stop_at, 1)) break;
+					dp.push(r[5]);
+					r[5] &= 0x0U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x11U;
+					note_peaks(context);
+					continue;
+				case 0x13U:
+					if (not fits_forward(max_steps - retired, 0x13U, stop_at, 4)) break;
+					r[3] += 0x1U;
+					r[4] += 0x1U;
+					r[7] += 0xFFFFFFFFU;
+					retired += 4;
+					context.retired += 4;
+					if (r[7] >> 31 == 0 and r[7] != 0) {
+						context.pc_stack.push(0x16U);
+						context.counter = 0x5U;
+					} else {
+						context.counter = 0x17U;
+					}
+					note_peaks(context);
+					continue;
+				case 0x17U:
+					if (not fits_forward(max_steps - retired, 0x17U, stop_at, 4)) break;
+					r[3] += 0xFFFFFFD1U;
+					r[4] += 0xFFFFFFD1U;
+					r[6] += 0xFFFFFFFFU;
+					retired += 4;
+					context.retired += 4;
+					if (r[6] >> 31 == 0 and r[6] != 0) {
+						context.pc_stack.push(0x1AU);
+						context.counter = 0x3U;
+					} else {
+						context.counter = 0x1BU;
+					}
+					note_peaks(context);
+					continue;
+				case 0x1BU:
+					if (not fits_forward(max_steps - retired, 0x1BU, stop_at, 4)) break;
+					r[3] += 0x30U;
+					r[4] += 0x30U;
+					r[9] += 0xFFFFFFFFU;
+					retired += 4;
+					context.retired += 4;
+					if (r[9] >> 31 == 0 and r[9] != 0) {
+						context.pc_stack.push(0x1EU);
+						context.counter = 0x1U;
+					} else {
+						context.counter = 0x1FU;
+					}
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x1U:
+					if (not fits_reverse(max_steps - retired, 0x1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x2U:
+					if (not fits_reverse(max_steps - retired, 0x2U, stop_at, 1)) break;
+					r[6] -= 0x2FU;
+					context.counter = 0x1U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3U:
+					if (not fits_reverse(max_steps - retired, 0x3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x4U:
+					if (not fits_reverse(max_steps - retired, 0x4U, stop_at, 1)) break;
+					r[7] -= 0x2FU;
+					context.counter = 0x3U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x5U:
+					if (not fits_reverse(max_steps - retired, 0x5U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x5U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x9U:
+					if (not fits_reverse(max_steps - retired, 0x9U, stop_at, 2)) break;
+					if (not pop_garbage(context, 5)) return stranded(context, retired, 0x9U, 0);
+					r[5] -= r[2];
+					context.counter = 0x7U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xCU:
+					if (not fits_reverse(max_steps - retired, 0xCU, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0xCU, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0xFU:
+					if (not fits_reverse(max_steps - retired, 0xFU, stop_at, 3)) break;
+					r[1] ^= r[2];
+					r[2] ^= r[1];
+					r[1] ^= r[2];
+					context.counter = 0xCU;
+					retired += 3;
+					context.retired += 3;
+					continue;
+				case 0x10U:
+					if (not fits_reverse(max_steps - retired, 0x10U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x10U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x11U:
+					if (not fits_reverse(max_steps - retired, 0x11U, stop_at, 1)) break;
+					if (not pop_garbage(context, 5)) return stranded(context, retired, 0x11U, 0);
+					context.counter = 0x10U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x16U:
+					if (not fits_reverse(max_steps - retired, 0x16U, stop_at, 3)) break;
+					r[7] -= 0xFFFFFFFFU;
+					r[4] -= 0x1U;
+					r[3] -= 0x1U;
+					context.counter = 0x13U;
+					retired += 3;
+					context.retired += 3;
+					continue;
+				case 0x1AU:
+					if (not fits_reverse(max_steps - retired, 0x1AU, stop_at, 3)) break;
+					r[6] -= 0xFFFFFFFFU;
+					r[4] -= 0xFFFFFFD1U;
+					r[3] -= 0xFFFFFFD1U;
+					context.counter = 0x17U;
+					retired += 3;
+					context.retired += 3;
+					continue;
+				case 0x1EU:
+					if (not fits_reverse(max_steps - retired, 0x1EU, stop_at, 3)) break;
+					r[9] -= 0xFFFFFFFFU;
+					r[4] -= 0x30U;
+					r[3] -= 0x30U;
+					context.counter = 0x1BU;
+					retired += 3;
+					context.retired += 3;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_bubble_sort_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+// hash: 1039 words, 6 runs.
+static const metronome32::translated::word translated_hash_words[] = {
+	{0x0U, 0x34000000U},
+	{0x1U, 0x60000400U},
+	{0x2U, 0x34000000U},
+	{0x4U, 0x1010040U},
+	{0x5U, 0x1002C40U},
+	{0x6U, 0x1010001U},
+	{0x7U, 0x201C80U},
+	{0x9U, 0x60600001U},
+	{0xAU, 0x601FFFFFU},
+	{0xBU, 0x3000FFF7U},
+	{0xCU, 0x607FFC00U},
+	{0xDU, 0x609FFFFFU},
+	{0xEU, 0x3004FFF2U},
+	{0, 0},
+};
+
+std::uint64_t translated_hash(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)
+{
+	using namespace metronome32::translated;
+	const std::size_t count = 13;
+	metronome32::register_value* const r = context.registers.data();
+	auto& dp = context.dp_stack;
+	bool trusted = holds(context.sys_mem, translated_hash_words, count);
+	std::uint64_t retired = 0;
+	(void) r;
+	(void) dp;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		if (trusted and runnable(context)) {
+			if (not context.reversing) {
+				switch (context.counter) {
+				case 0x0U:
+					if (not fits_forward(max_steps - retired, 0x0U, stop_at, 1)) break;
+					context.pc_stack.push(0x0U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x1U;
+					note_peaks(context);
+					continue;
+				case 0x1U:
+					if (not fits_forward(max_steps - retired, 0x1U, stop_at, 1)) break;
+					r[0] += 0x400U;
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x2U;
+					note_peaks(context);
+					continue;
+				case 0x2U:
+					if (not fits_forward(max_steps - retired, 0x2U, stop_at, 1)) break;
+					context.pc_stack.push(0x2U);
+					retired += 1;
+					context.retired += 1;
+					context.counter = 0x3U;
+					note_peaks(context);
+					continue;
+				case 0x4U:
+					if (not fits_forward(max_steps - retired, 0x4U, stop_at, 4)) break;
+					r[8] ^= r[1];
+					r[8] = rotate_left(r[8], 5);
+					r[8] += r[1];
+					r[1] = rotate_right(r[1], 3);
+					retired += 4;
+					context.retired += 4;
+					context.counter = 0x8U;
+					note_peaks(context);
+					continue;
+				case 0x9U:
+					if (not fits_forward(max_steps - retired, 0x9U, stop_at, 3)) break;
+					r[3] += 0x1U;
+					r[0] += 0xFFFFFFFFU;
+					retired += 3;
+					context.retired += 3;
+					if (r[0] >> 31 == 0 and r[0] != 0) {
+						context.pc_stack.push(0xBU);
+						context.counter = 0x3U;
+					} else {
+						context.counter = 0xCU;
+					}
+					note_peaks(context);
+					continue;
+				case 0xCU:
+					if (not fits_forward(max_steps - retired, 0xCU, stop_at, 3)) break;
+					r[3] += 0xFFFFFC00U;
+					r[4] += 0xFFFFFFFFU;
+					retired += 3;
+					context.retired += 3;
+					if (r[4] >> 31 == 0 and r[4] != 0) {
+						context.pc_stack.push(0xEU);
+						context.counter = 0x1U;
+					} else {
+						context.counter = 0xFU;
+					}
+					note_peaks(context);
+					continue;
+				default:
+					break;
+				}
+			} else {
+				switch (context.counter) {
+				case 0x1U:
+					if (not fits_reverse(max_steps - retired, 0x1U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x1U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x2U:
+					if (not fits_reverse(max_steps - retired, 0x2U, stop_at, 1)) break;
+					r[0] -= 0x400U;
+					context.counter = 0x1U;
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x3U:
+					if (not fits_reverse(max_steps - retired, 0x3U, stop_at, 1)) break;
+					if (not pop_counter(context)) return stranded(context, retired, 0x3U, 0);
+					retired += 1;
+					context.retired += 1;
+					continue;
+				case 0x8U:
+					if (not fits_reverse(max_steps - retired, 0x8U, stop_at, 4)) break;
+					r[1] = rotate_left(r[1], 3);
+					r[8] -= r[1];
+					r[8] = rotate_right(r[8], 5);
+					r[8] ^= r[1];
+					context.counter = 0x4U;
+					retired += 4;
+					context.retired += 4;
+					continue;
+				case 0xBU:
+					if (not fits_reverse(max_steps - retired, 0xBU, stop_at, 2)) break;
+					r[0] -= 0xFFFFFFFFU;
+					r[3] -= 0x1U;
+					context.counter = 0x9U;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				case 0xEU:
+					if (not fits_reverse(max_steps - retired, 0xEU, stop_at, 2)) break;
+					r[4] -= 0xFFFFFFFFU;
+					r[3] -= 0xFFFFFC00U;
+					context.counter = 0xCU;
+					retired += 2;
+					context.retired += 2;
+					continue;
+				default:
+					break;
+				}
+			}
+		}
+		
+		if (not step(context, trusted, translated_hash_words, count)) break;
+		retired++;
+	}
+	
+	return retired;
+}
+
+const metronome32::translation metronome32::translated_programs[] = {
+	{"multiply", &translated_multiply},
+	{"divide", &translated_divide},
+	{"exchange-sweep", &translated_exchange_sweep},
+	{"call-chain", &translated_call_chain},
+	{"bubble-sort", &translated_bubble_sort},
+	{"hash", &translated_hash},
+	{nullptr, nullptr},
+};
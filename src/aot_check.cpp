@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "corpus.h"
+#include "differential.h"
+#include "engine.h"
+#include "translator.h"
+namespace m32 = metronome32;
+
+typedef std::chrono::steady_clock check_clock;
+
+static int usage(const char* program)
+{
+	std::cerr << "usage: " << program << " [--scale N]\n";
+	
+	return EXIT_FAILURE;
+}
+
+// Runs a workload forward and back on an engine until at least
+// instructions have retired, returning instructions per second.
+static double throughput(m32::engine& engine, const m32::workload& work, const std::uint64_t instructions)
+{
+	std::uint64_t retired = 0;
+	const auto start = check_clock::now();
+	
+	while (retired < instructions) {
+		engine.load(work.initial);
+		retired += engine.run(UINT64_MAX, work.end);
+		engine.reverse(true);
+		retired += engine.run(UINT64_MAX, 0);
+	}
+	
+	return retired / std::chrono::duration<double>(check_clock::now() - start).count();
+}
+
+// Checks every program in the translated unit this is linked with
+// against the reference engine, on the workload of the same name, and
+// compares their speed.
+int main(int argc, char** argv)
+{
+	unsigned int scale = 1;
+	
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 == argc) {
+			return usage(argv[0]);
+		} else if (std::strcmp(argv[i], "--scale") == 0) {
+			scale = std::max(1, std::atoi(argv[++i]));
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	
+	const std::vector<m32::workload> workloads = m32::workload_corpus(scale);
+	bool failed = false;
+	
+	for (const m32::translation* program = m32::translated_programs; program->name != nullptr; program++) {
+		const m32::workload* work = nullptr;
+		
+		for (const m32::workload& candidate : workloads) {
+			if (candidate.name == program->name) {
+				work = &candidate;
+			}
+		}
+		
+		if (work == nullptr) {
+			std::cerr << "no workload named " << program->name << '\n';
+			failed = true;
+			continue;
+		}
+		
+		m32::translated_engine translated(program->name, program->run);
+		m32::reference_engine reference;
+		const m32::divergence result = m32::run_differential(reference, translated, *work);
+		
+		if (result.found) {
+			std::cout << program->name << " diverged" << (result.reversing ? " in reverse" : " forward")
+			          << " after " << result.step << " instructions, at PC 0x" << std::hex << result.pc << std::dec << ":\n"
+			          << result.diff;
+			failed = true;
+			continue;
+		}
+		
+		translated.load(work->initial);
+		translated.run(UINT64_MAX, work->end);
+		
+		if (not work->check(translated.context())) {
+			std::cout << program->name << " finished with the wrong result\n";
+			failed = true;
+			continue;
+		}
+		
+		const std::uint64_t instructions = 10 * (result.forward_steps + result.reverse_steps);
+		const double native = throughput(translated, *work, instructions);
+		const double interpreted = throughput(reference, *work, instructions);
+		std::cout << program->name << ": " << native << " instructions per second translated, "
+		          << interpreted << " interpreted (" << native / interpreted << "x)\n";
+	}
+	
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
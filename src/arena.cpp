@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <new>
+#include "arena.h"
+namespace p32 = metronome32;
+
+#define GP [[gnu::pure]]
+
+p32::arena::arena(const std::size_t chunk_size) noexcept
+	: chunk_bytes(chunk_size)
+{}
+
+p32::arena::~arena()
+{
+	for (const chunk& c : chunks) {
+		::operator delete(c.data);
+	}
+}
+
+static std::size_t round_up(const std::size_t bytes) noexcept
+{
+	return (bytes + p32::arena::granule - 1) / p32::arena::granule * p32::arena::granule;
+}
+
+void* p32::arena::allocate(const std::size_t bytes)
+{
+	const std::size_t size = round_up(bytes == 0 ? 1 : bytes);
+	in_use += size;
+	
+	if (size <= max_reused_bytes) {
+		free_block*& list = free_lists[size / granule - 1];
+		
+		if (list != nullptr) {
+			free_block* const block = list;
+			list = block->next;
+			
+			return block;
+		}
+	}
+	
+	if (static_cast<std::size_t>(limit - cursor) < size) {
+		next_chunk(size);
+	}
+	
+	void* const block = cursor;
+	cursor += size;
+	
+	return block;
+}
+
+void p32::arena::deallocate(void* const block, const std::size_t bytes) noexcept
+{
+	const std::size_t size = round_up(bytes == 0 ? 1 : bytes);
+	in_use -= size;
+	
+	// Bigger blocks stay where they are until the arena is reset.
+	if (size <= max_reused_bytes) {
+		free_block*& list = free_lists[size / granule - 1];
+		list = new (block) free_block{list};
+	}
+}
+
+void p32::arena::reset() noexcept
+{
+	current = 0;
+	cursor = chunks.empty() ? nullptr : chunks.front().data;
+	limit = chunks.empty() ? nullptr : chunks.front().data + chunks.front().size;
+	in_use = 0;
+	free_lists.fill(nullptr);
+}
+
+void p32::arena::next_chunk(const std::size_t bytes)
+{
+	// The chunk being bumped through, if there is one yet, is used up.
+	std::size_t next = cursor == nullptr ? 0 : current + 1;
+	
+	while (next < chunks.size() and chunks[next].size < bytes) {
+		next++;
+	}
+	
+	if (next >= chunks.size()) {
+		const std::size_t size = bytes > chunk_bytes ? bytes : chunk_bytes;
+		chunks.push_back({static_cast<char*>(::operator new(size)), size});
+		next = chunks.size() - 1;
+	}
+	
+	current = next;
+	cursor = chunks[next].data;
+	limit = cursor + chunks[next].size;
+}
+
+GP std::size_t p32::arena::used() const noexcept
+{
+	return in_use;
+}
+
+GP std::size_t p32::arena::capacity() const noexcept
+{
+	std::size_t total = 0;
+	
+	for (const chunk& c : chunks) {
+		total += c.size;
+	}
+	
+	return total;
+}
+
+#undef GP
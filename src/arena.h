@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifndef HEADER_P32_ARENA_H
+#define HEADER_P32_ARENA_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	// A bump allocator for one VM's (or one worker thread's) storage.
+	// Freed blocks are kept on per-size free lists and handed out again,
+	// and reset() takes back everything at once without visiting any of
+	// it. An arena isn't thread-safe, and it must outlive every
+	// container allocating from it.
+	class arena {
+		public:
+			// Every allocation is rounded up to and aligned on this.
+			static constexpr std::size_t granule = alignof(std::max_align_t);
+			// Freed blocks up to this size are reused.
+			static constexpr std::size_t max_reused_bytes = 1024;
+			
+			void* allocate(std::size_t bytes);
+			void deallocate(void* block, std::size_t bytes) noexcept;
+			// Forgets every allocation, keeping the memory for reuse.
+			// Containers still holding storage from the arena must not
+			// be used or destroyed afterwards.
+			void reset() noexcept;
+			
+			// The bytes handed out since the last reset, and the bytes
+			// the arena holds from the system.
+			GP std::size_t used() const noexcept;
+			GP std::size_t capacity() const noexcept;
+			
+			arena(const arena&) = delete;
+			arena& operator=(const arena&) = delete;
+			~arena();
+			explicit arena(std::size_t chunk_bytes = 64 * 1024) noexcept;
+		
+		private:
+			struct chunk {
+				char* data;
+				std::size_t size;
+			};
+			
+			// A freed block, linking to the next one of its size.
+			struct free_block {
+				free_block* next;
+			};
+			
+			std::size_t chunk_bytes;
+			std::vector<chunk> chunks;
+			// The chunk being bumped through, and the free part of it.
+			std::size_t current = 0;
+			char* cursor = nullptr;
+			char* limit = nullptr;
+			std::size_t in_use = 0;
+			std::array<free_block*, max_reused_bytes / granule> free_lists = {};
+			
+			// Moves on to a chunk with room for bytes, reusing chunks
+			// kept over a reset before asking the system for another.
+			void next_chunk(std::size_t bytes);
+	};
+	
+	// A standard allocator drawing from an arena. A default-constructed
+	// one has no arena and uses the global operator new instead, so
+	// containers using it behave as if they used std::allocator. Copies
+	// of a container are made on the heap, while assigning to one keeps
+	// its own allocator.
+	template <class T>
+	class arena_allocator {
+		public:
+			typedef T value_type;
+			
+			static_assert(alignof(T) <= arena::granule, "arenas can't align T");
+			
+			T* allocate(const std::size_t count)
+			{
+				if (storage == nullptr) {
+					return static_cast<T*>(::operator new(count * sizeof(T)));
+				} else {
+					return static_cast<T*>(storage->allocate(count * sizeof(T)));
+				}
+			}
+			
+			void deallocate(T* const block, const std::size_t count) noexcept
+			{
+				if (storage == nullptr) {
+					::operator delete(block);
+				} else {
+					storage->deallocate(block, count * sizeof(T));
+				}
+			}
+			
+			// Returns the arena in use, or nullptr for the global heap.
+			GP arena* get_arena() const noexcept {return storage;}
+			// A container copied from one using an arena is put on the
+			// heap, so the copy outlives a reset of the arena.
+			GP arena_allocator select_on_container_copy_construction() const noexcept {return arena_allocator();}
+			
+			arena_allocator() noexcept = default;
+			arena_allocator(arena& from) noexcept : storage(&from) {}
+			template <class U>
+			arena_allocator(const arena_allocator<U>& other) noexcept : storage(other.get_arena()) {}
+		
+		private:
+			arena* storage = nullptr;
+	};
+	
+	template <class T, class U>
+	GP bool operator==(const arena_allocator<T>& a, const arena_allocator<U>& b) noexcept
+	{
+		return a.get_arena() == b.get_arena();
+	}
+	
+	template <class T, class U>
+	GP bool operator!=(const arena_allocator<T>& a, const arena_allocator<U>& b) noexcept
+	{
+		return a.get_arena() != b.get_arena();
+	}
+}
+
+#undef GP
+
+#endif
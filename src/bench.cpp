@@ -0,0 +1,755 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "instruction.h"
+#include "arena.h"
+#include "memory.h"
+#include "vm.h"
+#include "pool.h"
+#include "verifier.h"
+#include "generator.h"
+#include "cfg.h"
+#include "corpus.h"
+#include "engine.h"
+#include "counters.h"
+namespace m32 = metronome32;
+
+typedef std::chrono::steady_clock bench_clock;
+
+// Stops the compiler from discarding work whose result isn't used.
+static volatile std::uint64_t sink;
+
+// A benchmark returns one measurement of operations per second, and
+// may write what else it measured after its row.
+struct benchmark {
+	std::string name;
+	std::function<double()> run;
+	std::function<void(std::ostream&)> details = nullptr;
+};
+
+struct result {
+	std::string name;
+	std::vector<double> rates;
+	
+	double min() const {return *std::min_element(rates.begin(), rates.end());}
+	double max() const {return *std::max_element(rates.begin(), rates.end());}
+	
+	double median() const
+	{
+		std::vector<double> sorted = rates;
+		std::sort(sorted.begin(), sorted.end());
+		const std::size_t mid = sorted.size() / 2;
+		
+		return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+	}
+	
+	double mean() const
+	{
+		double sum = 0;
+		for (const double rate : rates) sum += rate;
+		
+		return sum / rates.size();
+	}
+	
+	double stddev() const
+	{
+		const double average = mean();
+		double sum = 0;
+		for (const double rate : rates) sum += (rate - average) * (rate - average);
+		
+		return rates.size() > 1 ? std::sqrt(sum / (rates.size() - 1)) : 0;
+	}
+};
+
+static double seconds_since(const bench_clock::time_point start)
+{
+	return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+// A guest program exercising one opcode, made of blocks that each run
+// it once or twice and fall through to the next block.
+struct kernel {
+	std::string name;
+	std::vector<m32::memory_value> program;
+	std::vector<std::pair<unsigned int, m32::register_value>> registers;
+};
+
+constexpr std::size_t kernel_blocks = 1024;
+constexpr std::uint64_t instructions_per_sample = 200000;
+
+// Builds a kernel by repeating block(address) kernel_blocks times.
+template <class Block>
+static kernel make_kernel(const std::string& name, Block block, std::vector<std::pair<unsigned int, m32::register_value>> registers = {})
+{
+	kernel k{name, {}, std::move(registers)};
+	
+	for (std::size_t i = 0; i < kernel_blocks; i++) {
+		for (const m32::memory_value word : block(static_cast<m32::register_value>(k.program.size()))) {
+			k.program.push_back(word);
+		}
+	}
+	
+	return k;
+}
+
+// Registers used by the kernels: r1 and r2 are ALU operands, r3 holds a
+// data address, r4 is negative, r5 is a set link register, r6 walks
+// jump targets and r31 is the link register.
+static std::vector<kernel> opcode_kernels()
+{
+	typedef std::vector<m32::memory_value> words;
+	const std::vector<std::pair<unsigned int, m32::register_value>> operands = {
+		{1, 0x12345678}, {2, 7}, {3, 0x100000}, {4, static_cast<m32::register_value>(-1)}, {5, 1},
+	};
+	std::vector<kernel> kernels;
+	
+	const auto alu = [&](const char* name, m32::memory_value word) {
+		kernels.push_back(make_kernel(name, [=](m32::register_value) {return words{word};}, operands));
+	};
+	
+	alu("add", m32::new_add(1, 2));
+	alu("addi", m32::new_addi(1, 5));
+	alu("and", m32::new_and(1, 2));
+	alu("andi", m32::new_andi(1, 0xFFFF));
+	alu("cf", m32::new_cf());
+	alu("exchange", m32::new_exchange(1, 3));
+	alu("nor", m32::new_nor(1, 2));
+	alu("neg", m32::new_neg(1, 2));
+	// There's no "or" kernel: OR encodings currently decode as NAI.
+	alu("ori", m32::new_ori(1, 0x10));
+	alu("rl", m32::new_rl(1, 3));
+	alu("rlv", m32::new_rlv(1, 2));
+	alu("rr", m32::new_rr(1, 3));
+	alu("rrv", m32::new_rrv(1, 2));
+	alu("sll", m32::new_sll(1, 3));
+	alu("sllv", m32::new_sllv(1, 2));
+	alu("slt", m32::new_slt(1, 2));
+	alu("slti", m32::new_slti(1, 9));
+	alu("sra", m32::new_sra(1, 3));
+	alu("srav", m32::new_srav(1, 2));
+	alu("srl", m32::new_srl(1, 3));
+	alu("srlv", m32::new_srlv(1, 2));
+	alu("sub", m32::new_sub(1, 2));
+	alu("xor", m32::new_xor(1, 2));
+	alu("xori", m32::new_xori(1, 0x55));
+	
+	// Taken branches skip over the CF they land after.
+	const auto taken = [&](const char* name, m32::memory_value word) {
+		kernels.push_back(make_kernel(name, [=](m32::register_value) {return words{word, m32::new_cf()};}, operands));
+	};
+	
+	taken("beq", m32::new_beq(0, 0, 1));
+	taken("bne", m32::new_blne(1, 2, 1));
+	taken("bgez", m32::new_bgez(0, 1));
+	taken("bgtz", m32::new_bgtz(2, 1));
+	taken("blez", m32::new_blez(0, 1));
+	taken("bltz", m32::new_bltz(4, 1));
+	// Linking branches can't be repeated when taken without clearing
+	// the link, so these fall through with r5 set.
+	alu("bgezal/not-taken", m32::new_bgezal(5, 4, 1));
+	alu("bltzal/not-taken", m32::new_bltzal(5, 2, 1));
+	
+	kernels.push_back(make_kernel("j", [](m32::register_value at) {
+		return words{m32::new_j(at + 1), m32::new_cf()};
+	}));
+	kernels.push_back(make_kernel("jal", [](m32::register_value at) {
+		return words{m32::new_jal(31, 1), m32::new_cf(), m32::new_addi(31, -(at + 1))};
+	}));
+	kernels.push_back(make_kernel("jr", [](m32::register_value) {
+		return words{m32::new_addi(6, 3), m32::new_jr(6), m32::new_cf()};
+	}, {{6, static_cast<m32::register_value>(-1)}}));
+	kernels.push_back(make_kernel("jalr", [](m32::register_value at) {
+		return words{m32::new_addi(6, 4), m32::new_jalr(31, 6), m32::new_cf(), m32::new_addi(31, -(at + 2))};
+	}, {{6, static_cast<m32::register_value>(-2)}}));
+	
+	return kernels;
+}
+
+// Runs a kernel to its end and, if reversing, back to the start, timing
+// only the requested direction. Every pass starts from a fresh context.
+// Returns a negative rate if the guest stops with an error.
+static double run_kernel(const kernel& k, const bool reversing, const bool verified = false)
+{
+	m32::vm machine(k.program);
+	m32::context_data initial = machine.get_context();
+	m32::verified_code proof;
+	
+	if (verified) {
+		proof.verify(initial.sys_mem);
+	}
+	const m32::register_value end = k.program.size();
+	
+	for (const auto& reg : k.registers) {
+		initial.registers[reg.first] = reg.second;
+	}
+	
+	std::uint64_t retired = 0;
+	double elapsed = 0;
+	
+	while (retired < instructions_per_sample) {
+		machine.set_context(initial);
+		std::uint64_t steps = 0;
+		auto start = bench_clock::now();
+		
+		while (machine.get_context().counter != end) {
+			if (not (verified ? machine.step_verified(proof) : machine.step())) return -1;
+			steps++;
+		}
+		
+		if (not reversing) {
+			elapsed += seconds_since(start);
+			retired += steps;
+			continue;
+		}
+		
+		machine.reverse();
+		steps = 0;
+		start = bench_clock::now();
+		
+		while (machine.get_context().counter != 0) {
+			if (not machine.step()) return -1;
+			steps++;
+		}
+		
+		elapsed += seconds_since(start);
+		retired += steps;
+	}
+	
+	return retired / elapsed;
+}
+
+// A mix of instruction words, one block of every kernel.
+static std::vector<m32::instruction> decode_words()
+{
+	std::vector<m32::instruction> result;
+	
+	for (const kernel& k : opcode_kernels()) {
+		for (std::size_t i = 0; i < k.program.size() / kernel_blocks; i++) {
+			result.push_back(k.program[i]);
+		}
+	}
+	
+	return result;
+}
+
+template <class Decode>
+static double run_decode(const std::vector<m32::instruction>& words, Decode decode)
+{
+	const std::size_t rounds = instructions_per_sample * 5 / words.size();
+	std::uint64_t total = 0;
+	const auto start = bench_clock::now();
+	
+	for (std::size_t round = 0; round < rounds; round++) {
+		for (const m32::instruction& word : words) {
+			total += decode(word);
+		}
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = total;
+	
+	return rounds * words.size() / elapsed;
+}
+
+// Decodes with the is_* predicates, in instr_to_opcode's order.
+static unsigned int decode_predicates(const m32::instruction& word)
+{
+	const auto r = m32::instr_to_r(word);
+	const auto j = m32::instr_to_j(word);
+	const auto b = m32::instr_to_b(word);
+	const auto i = m32::instr_to_i(word);
+	const bool matches[] = {
+		m32::is_add(r), m32::is_addi(i), m32::is_and(r), m32::is_andi(i),
+		m32::is_beq(b), m32::is_bgez(b), m32::is_bgezal(b), m32::is_bgtz(b),
+		m32::is_blez(b), m32::is_bltz(b), m32::is_bltzal(b), m32::is_bne(b),
+		m32::is_cf(j), m32::is_exchange(b), m32::is_j(j), m32::is_jal(b),
+		m32::is_jalr(b), m32::is_jr(b), m32::is_nor(r), m32::is_neg(r),
+		m32::is_or(r), m32::is_ori(i), m32::is_rl(r), m32::is_rlv(r),
+		m32::is_rr(r), m32::is_rrv(r), m32::is_sll(r), m32::is_sllv(r),
+		m32::is_slt(r), m32::is_slti(i), m32::is_sra(r), m32::is_srav(r),
+		m32::is_srl(r), m32::is_srlv(r), m32::is_sub(r), m32::is_xor(r),
+		m32::is_xori(i),
+	};
+	
+	return std::find(std::begin(matches), std::end(matches), true) - std::begin(matches);
+}
+
+// Random addresses inside a working set of size words.
+static std::vector<m32::register_value> addresses(const std::size_t size, const std::size_t count)
+{
+	std::vector<m32::register_value> result(count);
+	std::uint32_t state = 2463534242U;
+	
+	for (m32::register_value& address : result) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		address = state % size;
+	}
+	
+	return result;
+}
+
+static double run_memory(const std::size_t size, const bool writing)
+{
+	m32::system_memory_t memory;
+	
+	for (std::size_t i = 0; i < size; i++) {
+		m32::memory::write_word(memory, i, i);
+	}
+	
+	const std::vector<m32::register_value> where = addresses(size, instructions_per_sample);
+	std::uint64_t total = 0;
+	const auto start = bench_clock::now();
+	
+	for (const m32::register_value address : where) {
+		if (writing) {
+			m32::memory::write_word(memory, address, address);
+		} else {
+			total += m32::memory::read_word(memory, address);
+		}
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = total;
+	
+	return where.size() / elapsed;
+}
+
+// Runs a corpus workload forward and back on an engine until enough
+// instructions have retired. Returns instructions per second.
+static double run_engine(const std::string& name, const m32::workload& work)
+{
+	const std::unique_ptr<m32::engine> engine = m32::make_engine(name);
+	std::uint64_t retired = 0;
+	const auto start = bench_clock::now();
+	
+	while (retired < 10 * instructions_per_sample) {
+		engine->load(work.initial);
+		retired += engine->run(UINT64_MAX, work.end);
+		engine->reverse(true);
+		retired += engine->run(UINT64_MAX, 0);
+		
+		if (engine->context().counter != 0 or engine->context().halted) {
+			return -1;
+		}
+	}
+	
+	return retired / seconds_since(start);
+}
+
+// Builds control flow graphs of a generated program with the given
+// number of loop body items. Returns words analysed per second.
+static double run_cfg(const unsigned int body_items)
+{
+	m32::generator_options options;
+	options.body_items = body_items;
+	const m32::instructions_t image = m32::generate_workload(options).initial.sys_mem;
+	std::uint64_t words = 0;
+	std::size_t blocks = 0;
+	const auto start = bench_clock::now();
+	
+	while (words < 4 * instructions_per_sample) {
+		const m32::control_flow_graph graph(image);
+		blocks += graph.blocks().size();
+		words += image.size();
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = blocks;
+	
+	return words / elapsed;
+}
+
+static double run_garbage_stack()
+{
+	m32::dp_garbage_stack_t stack;
+	std::uint64_t total = 0;
+	const auto start = bench_clock::now();
+	
+	for (std::uint64_t i = 0; i < instructions_per_sample; i++) {
+		stack.push(i);
+	}
+	
+	while (not stack.empty()) {
+		total += stack.top();
+		stack.pop();
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = total;
+	
+	return 2 * instructions_per_sample / elapsed;
+}
+
+// A short job: a loop writing 64 words and pushing onto both garbage
+// stacks, about 330 instructions in all.
+static const std::vector<m32::memory_value> short_job = {
+	m32::new_addi(0, 64),
+	m32::new_addi(3, 0x1000),
+	m32::new_cf(),
+	m32::new_andi(1, -1),
+	m32::new_exchange(4, 3),
+	m32::new_addi(3, 1),
+	m32::new_addi(0, -1),
+	m32::new_bgtz(0, -5),
+};
+constexpr std::size_t jobs_per_sample = 2000;
+
+// Runs short jobs, each in a new VM on the heap or in one VM recycled
+// through an arena, and returns jobs per second.
+static double run_jobs(const bool recycling)
+{
+	m32::arena storage;
+	m32::vm recycled(storage);
+	std::uint64_t total = 0;
+	const auto start = bench_clock::now();
+	
+	for (std::size_t i = 0; i < jobs_per_sample; i++) {
+		if (recycling) {
+			recycled.recycle();
+			recycled.load_words(short_job.data(), short_job.size());
+			while (recycled.get_context().counter != short_job.size() and recycled.step()) {}
+			total += recycled.get_context().dp_stack.size();
+		} else {
+			m32::vm fresh(short_job);
+			while (fresh.get_context().counter != short_job.size() and fresh.step()) {}
+			total += fresh.get_context().dp_stack.size();
+		}
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = total;
+	
+	return total == 64 * jobs_per_sample ? jobs_per_sample / elapsed : -1;
+}
+
+// Sets up and tears down a short job without running it, either as a
+// new VM or through a pool, and returns jobs per second.
+static double run_job_setup(const bool pooled)
+{
+	constexpr std::size_t jobs = 100000;
+	m32::vm_pool pool(1);
+	std::uint64_t total = 0;
+	const auto start = bench_clock::now();
+	
+	for (std::size_t i = 0; i < jobs; i++) {
+		if (pooled) {
+			m32::vm& machine = pool.acquire(short_job.data(), short_job.size());
+			total += machine.get_context().sys_mem.size();
+			pool.release(machine);
+		} else {
+			m32::vm fresh(short_job);
+			total += fresh.get_context().sys_mem.size();
+		}
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = total;
+	
+	return jobs / elapsed;
+}
+
+// Round-robins a VM over 100 contexts of 1024 words each, either by
+// setting each in turn or by switching handles, running 16 instructions
+// of a loop in each slice. Returns slices per second.
+static double run_context_switches(const bool by_handle)
+{
+	constexpr std::size_t guests = 100;
+	constexpr std::size_t slices = 20000;
+	m32::context_data guest = m32::fresh_context({
+		{0, m32::new_cf()},
+		{1, m32::new_addi(1, 1)},
+		{2, m32::new_bgtz(1, -2)},
+	});
+	guest.registers[1] = 1;
+	
+	for (m32::register_value address = 0x1000; address < 0x1000 + 1024; address++) {
+		m32::memory::write_word(guest.sys_mem, address, address);
+	}
+	
+	std::vector<m32::context_data> saved(guests, guest);
+	m32::vm machine;
+	machine.set_context(guest);
+	
+	for (std::size_t i = 1; i < guests; i++) {
+		machine.add_context(m32::context_data(guest));
+	}
+	
+	const auto start = bench_clock::now();
+	
+	for (std::size_t i = 0; i < slices; i++) {
+		const std::size_t next = i % guests;
+		
+		if (by_handle) {
+			machine.switch_to(next);
+			machine.step(16);
+		} else {
+			machine.set_context(saved[next]);
+			machine.step(16);
+			saved[next] = machine.get_context();
+		}
+	}
+	
+	const double elapsed = seconds_since(start);
+	sink = machine.get_context().registers[1];
+	
+	return machine.halted() ? -1 : slices / elapsed;
+}
+
+// The host cache misses counted over every run of run_cold_steps().
+static m32::counter_sample cold_step_events;
+
+// Round-robins a VM over 32768 small contexts, one step each, so that
+// every step starts with the context cold in the cache. Most steps are
+// plain ALU instructions. Returns steps per second, and counts cache
+// misses where the host allows.
+static double run_cold_steps()
+{
+	constexpr std::size_t guests = 32768;
+	constexpr std::size_t steps = 400000;
+	m32::context_data guest = m32::fresh_context({
+		{0, m32::new_cf()},
+		{1, m32::new_addi(2, 3)},
+		{2, m32::new_xor(3, 2)},
+		{3, m32::new_add(4, 3)},
+		{4, m32::new_sub(5, 4)},
+		{5, m32::new_addi(1, 1)},
+		{6, m32::new_bgtz(1, -6)},
+	});
+	guest.registers[1] = 1;
+	m32::vm machine;
+	machine.set_context(guest);
+	
+	for (std::size_t i = 1; i < guests; i++) {
+		machine.add_context(m32::context_data(guest));
+	}
+	
+	m32::hardware_counters counters;
+	counters.begin();
+	const auto start = bench_clock::now();
+	
+	for (std::size_t i = 0; i < steps; i++) {
+		machine.switch_to(i % guests);
+		machine.step();
+	}
+	
+	const double elapsed = seconds_since(start);
+	m32::counter_sample events = counters.end();
+	events.guest_instructions = steps;
+	sink = machine.get_context().registers[1];
+	
+	if (cold_step_events.guest_instructions == 0) {
+		cold_step_events = events;
+	} else {
+		cold_step_events += events;
+	}
+	
+	return machine.halted() ? -1 : steps / elapsed;
+}
+
+// Writes the cache misses per step of the cold-step runs, or "n/a" for
+// those the host couldn't count.
+static void write_cold_step_misses(std::ostream& out)
+{
+	out << "  misses/step:";
+	
+	for (const m32::hardware_event event : {m32::hardware_event::l1d_misses, m32::hardware_event::llc_misses}) {
+		const double per_step = cold_step_events.per_guest_instruction(event);
+		out << ' ' << m32::hardware_event_name(event) << ' ';
+		
+		if (per_step < 0) {
+			out << "n/a";
+		} else {
+			out << std::fixed << std::setprecision(2) << per_step;
+		}
+	}
+	
+	out << '\n';
+}
+
+static std::vector<benchmark> all_benchmarks()
+{
+	std::vector<benchmark> result;
+	
+	for (const kernel& k : opcode_kernels()) {
+		result.push_back({"step/forward/" + k.name, [k]() {return run_kernel(k, false);}});
+		result.push_back({"step/reverse/" + k.name, [k]() {return run_kernel(k, true);}});
+		result.push_back({"step/verified/" + k.name, [k]() {return run_kernel(k, false, true);}});
+	}
+	
+	const auto words = std::make_shared<std::vector<m32::instruction>>(decode_words());
+	result.push_back({"decode/instr_to_opcode", [words]() {
+		return run_decode(*words, [](const m32::instruction& w) {return static_cast<unsigned int>(m32::instr_to_opcode(w));});
+	}});
+	result.push_back({"decode/is_predicates", [words]() {return run_decode(*words, decode_predicates);}});
+	result.push_back({"decode/instr_to_r", [words]() {
+		return run_decode(*words, [](const m32::instruction& w) {return m32::instr_to_r(w).rs.to_ulong();});
+	}});
+	result.push_back({"decode/instr_to_j", [words]() {
+		return run_decode(*words, [](const m32::instruction& w) {return m32::instr_to_j(w).target.to_ulong();});
+	}});
+	result.push_back({"decode/instr_to_b", [words]() {
+		return run_decode(*words, [](const m32::instruction& w) {return m32::instr_to_b(w).offset.to_ulong();});
+	}});
+	result.push_back({"decode/instr_to_i", [words]() {
+		return run_decode(*words, [](const m32::instruction& w) {return m32::instr_to_i(w).immediate.to_ulong();});
+	}});
+	
+	for (const std::size_t size : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(1) << 20}) {
+		const std::string suffix = "/" + std::to_string(size) + "-words";
+		result.push_back({"memory/read_word" + suffix, [size]() {return run_memory(size, false);}});
+		result.push_back({"memory/write_word" + suffix, [size]() {return run_memory(size, true);}});
+	}
+	
+	for (const std::string& name : m32::engine_names()) {
+		for (const m32::workload& work : m32::workload_corpus()) {
+			result.push_back({"engine/" + name + "/" + work.name, [name, work]() {return run_engine(name, work);}});
+		}
+	}
+	
+	for (const unsigned int items : {1U << 10, 1U << 14, 1U << 18}) {
+		result.push_back({"analysis/cfg/" + std::to_string(items) + "-items", [items]() {return run_cfg(items);}});
+	}
+	
+	result.push_back({"garbage/push-pop", run_garbage_stack});
+	result.push_back({"jobs/new-vm", []() {return run_jobs(false);}});
+	result.push_back({"jobs/arena-recycle", []() {return run_jobs(true);}});
+	result.push_back({"jobs/setup-new-vm", []() {return run_job_setup(false);}});
+	result.push_back({"jobs/setup-pool", []() {return run_job_setup(true);}});
+	result.push_back({"switch/set-context", []() {return run_context_switches(false);}});
+	result.push_back({"switch/handle", []() {return run_context_switches(true);}});
+	result.push_back({"switch/cold-step", run_cold_steps, write_cold_step_misses});
+	
+	return result;
+}
+
+static void write_json(std::ostream& out, const std::vector<result>& results, const unsigned int repetitions)
+{
+	out << std::setprecision(6) << std::scientific;
+	out << "{\n\t\"unit\": \"operations per second\",\n\t\"repetitions\": " << repetitions << ",\n\t\"benchmarks\": [";
+	
+	for (std::size_t i = 0; i < results.size(); i++) {
+		const result& r = results[i];
+		out << (i ? ",\n" : "\n")
+		    << "\t\t{\"name\": \"" << r.name << "\""
+		    << ", \"min\": " << r.min()
+		    << ", \"median\": " << r.median()
+		    << ", \"mean\": " << r.mean()
+		    << ", \"max\": " << r.max()
+		    << ", \"stddev\": " << r.stddev()
+		    << "}";
+	}
+	
+	out << "\n\t]\n}\n";
+}
+
+static int usage(const char* program)
+{
+	std::cerr << "usage: " << program << " [--repetitions N] [--filter TEXT] [--json FILE]\n";
+	
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int repetitions = 5;
+	std::string filter;
+	const char* json_path = nullptr;
+	
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 == argc) {
+			return usage(argv[0]);
+		} else if (std::strcmp(argv[i], "--repetitions") == 0) {
+			repetitions = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--filter") == 0) {
+			filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--json") == 0) {
+			json_path = argv[++i];
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	
+	std::vector<result> results;
+	bool failed = false;
+	
+	std::cout << std::left << std::setw(36) << "benchmark" << std::right
+	          << std::setw(14) << "median/s" << std::setw(14) << "min/s" << std::setw(10) << "stddev" << '\n';
+	
+	for (const benchmark& bench : all_benchmarks()) {
+		if (bench.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		
+		// One untimed run to warm up caches and the allocator.
+		bench.run();
+		result r{bench.name, {}};
+		
+		for (unsigned int i = 0; i < repetitions; i++) {
+			r.rates.push_back(bench.run());
+		}
+		
+		if (r.min() < 0) {
+			std::cerr << bench.name << ": the guest stopped with an error\n";
+			failed = true;
+			continue;
+		}
+		
+		std::cout << std::left << std::setw(36) << r.name << std::right << std::setprecision(3) << std::scientific
+		          << std::setw(14) << r.median() << std::setw(14) << r.min()
+		          << std::fixed << std::setw(9) << 100 * r.stddev() / r.mean() << "%\n";
+		
+		if (bench.details) {
+			bench.details(std::cout);
+		}
+		
+		results.push_back(std::move(r));
+	}
+	
+	if (json_path != nullptr) {
+		std::ofstream out(json_path);
+		write_json(out, results, repetitions);
+		
+		if (not out) {
+			std::cerr << "couldn't write " << json_path << '\n';
+			failed = true;
+		}
+	}
+	
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
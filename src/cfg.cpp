@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "cfg.h"
+namespace p32 = metronome32;
+
+using p32::basic_block;
+using p32::cfg_edge;
+using p32::control_flow_graph;
+using p32::edge_kind;
+using p32::opcode;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::size_t control_flow_graph::no_block;
+
+namespace {
+	// Consecutive words of an image, starting at address first, which
+	// are words index onward in address order.
+	struct image_run {
+		register_value first;
+		std::size_t index;
+		std::size_t size;
+	};
+	
+	// Returns the index of the word at address, or SIZE_MAX if the
+	// image has no such word.
+	GP std::size_t index_of(const std::vector<image_run>& runs, const register_value address) noexcept
+	{
+		auto run = std::upper_bound(runs.begin(), runs.end(), address, [](const register_value a, const image_run& r) {
+			return a < r.first;
+		});
+		
+		if (run == runs.begin()) {
+			return SIZE_MAX;
+		}
+		
+		--run;
+		const std::size_t offset = address - run->first;
+		
+		return offset < run->size ? run->index + offset : SIZE_MAX;
+	}
+	
+	// Returns whether nothing after an instruction can be in its block.
+	GC bool ends_block(const opcode op) noexcept
+	{
+		switch (op) {
+			case opcode::beq: case opcode::bgez: case opcode::bgezal:
+			case opcode::bgtz: case opcode::blez: case opcode::bltz:
+			case opcode::bltzal: case opcode::bne: case opcode::cf:
+			case opcode::j: case opcode::jal: case opcode::jalr:
+			case opcode::jr: case opcode::nai:
+				return true;
+			default:
+				return false;
+		}
+	}
+}
+
+control_flow_graph::control_flow_graph(const instructions_t& image)
+{
+	const std::size_t count = image.size();
+	std::vector<register_value> addresses;
+	std::vector<opcode> ops;
+	std::vector<image_run> runs;
+	addresses.reserve(count);
+	ops.reserve(count);
+	
+	for (const auto& word : image) {
+		if (runs.empty() or word.first != addresses.back() + 1) {
+			runs.push_back({word.first, addresses.size(), 0});
+		}
+		
+		runs.back().size++;
+		addresses.push_back(word.first);
+		ops.push_back(p32::instr_to_opcode(word.second));
+	}
+	
+	// Find the first word of every block, and where each direct branch
+	// lands: on the word after its CF, which always starts a block.
+	std::vector<bool> leader(count + 1, false);
+	std::vector<std::pair<std::size_t, std::size_t>> landings;
+	std::size_t i = 0;
+	
+	for (const image_run& run : runs) {
+		leader[run.index] = true;
+	}
+	
+	for (const auto& word : image) {
+		register_value target;
+		
+		if (ops[i] == opcode::cf) {
+			leader[i] = true;
+		}
+		
+		if (ends_block(ops[i])) {
+			leader[i + 1] = true;
+		}
+		
+		if (p32::direct_target(word.second, word.first, target)) {
+			const std::size_t cf = index_of(runs, target);
+			
+			if (cf != SIZE_MAX and ops[cf] == opcode::cf and cf + 1 < count and addresses[cf + 1] == target + 1) {
+				landings.emplace_back(i, cf + 1);
+			}
+		}
+		
+		i++;
+	}
+	
+	std::vector<std::size_t> block_of(count);
+	
+	for (i = 0; i < count; i++) {
+		if (leader[i]) {
+			block_of[i] = all_blocks.size();
+			all_blocks.push_back({addresses[i], 0, 0, 0});
+		}
+		
+		all_blocks.back().size++;
+	}
+	
+	// Every direct branch ends a block, so the landings are met in
+	// order, at the ends of blocks.
+	std::size_t next = 0;
+	auto landing = landings.begin();
+	
+	for (std::size_t b = 0; b < all_blocks.size(); b++) {
+		basic_block& block = all_blocks[b];
+		next += block.size;
+		const std::size_t last = next - 1;
+		const bool falls = next < count and addresses[next] == addresses[last] + 1;
+		std::size_t target = no_block;
+		block.first_edge = all_edges.size();
+		
+		if (landing != landings.end() and landing->first == last) {
+			target = block_of[landing->second];
+			++landing;
+		}
+		
+		// The edge out of the last word, if any, then the one past it.
+		edge_kind kind = edge_kind::fallthrough;
+		bool continues = true;
+		
+		switch (ops[last]) {
+			case opcode::beq: case opcode::bgez: case opcode::bgtz:
+			case opcode::blez: case opcode::bltz: case opcode::bne:
+				kind = edge_kind::branch;
+				break;
+			case opcode::bgezal: case opcode::bltzal: case opcode::jal:
+				kind = edge_kind::call;
+				break;
+			case opcode::j:
+				kind = edge_kind::jump;
+				continues = false;
+				break;
+			case opcode::jalr:
+				kind = edge_kind::indirect;
+				break;
+			case opcode::jr:
+				kind = edge_kind::indirect;
+				continues = false;
+				break;
+			case opcode::nai:
+				continues = false;
+				break;
+			default:
+				break;
+		}
+		
+		if (kind == edge_kind::indirect) {
+			all_edges.push_back({b, no_block, kind});
+		} else if (kind != edge_kind::fallthrough and target != no_block) {
+			all_edges.push_back({b, target, kind});
+		}
+		
+		if (continues and falls) {
+			all_edges.push_back({b, b + 1, edge_kind::fallthrough});
+		}
+		
+		block.edge_count = all_edges.size() - block.first_edge;
+	}
+}
+
+GC const std::vector<basic_block>& control_flow_graph::blocks() const noexcept
+{
+	return all_blocks;
+}
+
+GC const std::vector<cfg_edge>& control_flow_graph::edges() const noexcept
+{
+	return all_edges;
+}
+
+GP std::size_t control_flow_graph::block_at(const register_value address) const noexcept
+{
+	auto block = std::upper_bound(all_blocks.begin(), all_blocks.end(), address, [](const register_value a, const basic_block& b) {
+		return a < b.start;
+	});
+	
+	if (block == all_blocks.begin()) {
+		return no_block;
+	}
+	
+	--block;
+	
+	return address - block->start < block->size ? block - all_blocks.begin() : no_block;
+}
+
+#undef GP
+#undef GC
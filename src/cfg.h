@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "instruction.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_CFG_H
+#define HEADER_P32_CFG_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// How control passes along an edge of a control_flow_graph.
+	enum class edge_kind : std::uint8_t {
+		// To the next word. After a call, this is where it returns.
+		fallthrough,
+		// The taken side of BEQ, BNE, BGEZ, BGTZ, BLEZ or BLTZ.
+		branch,
+		// J.
+		jump,
+		// JAL, and the taken side of BGEZAL or BLTZAL.
+		call,
+		// JR or JALR, whose target isn't known until it runs.
+		indirect,
+	};
+	
+	struct cfg_edge {
+		std::size_t from;
+		// The block reached, or control_flow_graph::no_block for
+		// indirect edges.
+		std::size_t to;
+		edge_kind kind;
+	};
+	
+	// A run of words entered only at its first and left only after its
+	// last, in the forward direction.
+	struct basic_block {
+		register_value start;
+		register_value size;
+		// The block's outgoing edges are edges()[first_edge] onward.
+		std::size_t first_edge;
+		std::size_t edge_count;
+	};
+	
+	// The basic blocks and edges of a program image, as loaded. Every
+	// word is taken for code. A CF is always a block of its own: a
+	// branch to a CF lands on the word after it, and in reverse it is
+	// where paths split. A block ends after any branch, jump or NAI,
+	// and before a gap in the image.
+	//
+	// Direct branches and jumps only get an edge if they target a CF
+	// followed by a word in the image; any others would fault or run
+	// off the image. Building the graph takes time linear in the size
+	// of the image, plus a search of its contiguous runs for each
+	// direct target.
+	class control_flow_graph {
+		public:
+			static constexpr std::size_t no_block = SIZE_MAX;
+			
+			// The blocks, in order of address, and their edges, in
+			// order of the block they leave.
+			GC const std::vector<basic_block>& blocks() const noexcept;
+			GC const std::vector<cfg_edge>& edges() const noexcept;
+			// Returns the block holding address, or no_block.
+			GP std::size_t block_at(register_value address) const noexcept;
+			
+			control_flow_graph() noexcept = default;
+			explicit control_flow_graph(const instructions_t& image);
+		
+		private:
+			std::vector<basic_block> all_blocks;
+			std::vector<cfg_edge> all_edges;
+	};
+}
+
+#undef GP
+#undef GC
+
+#endif
@@ -0,0 +1,421 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include "corpus.h"
+#include "memory.h"
+
+namespace p32 = metronome32;
+
+using p32::context_data;
+using p32::memory_value;
+using p32::register_value;
+using p32::offset_t;
+using p32::workload;
+
+namespace {
+	// Lays out a program, resolving branch and jump targets by label.
+	class assembler {
+		public:
+			// Appends an instruction.
+			void emit(const memory_value word)
+			{
+				words.push_back(word);
+			}
+			
+			// Names the next instruction's address.
+			void label(const std::string& name)
+			{
+				labels[name] = here();
+			}
+			
+			// Appends a branch whose offset is from itself to the CF
+			// at label, built by make(offset).
+			void branch(const std::string& target, std::function<memory_value(offset_t)> make)
+			{
+				fixups.push_back({here(), target, std::move(make), false});
+				words.push_back(0);
+			}
+			
+			// Appends a J to the CF at label.
+			void jump(const std::string& target)
+			{
+				fixups.push_back({here(), target, nullptr, true});
+				words.push_back(0);
+			}
+			
+			register_value here() const noexcept
+			{
+				return words.size();
+			}
+			
+			// Resolves every target and loads the program at zero.
+			context_data finish() const
+			{
+				std::vector<memory_value> program = words;
+				
+				for (const fixup& f : fixups) {
+					const register_value target = labels.at(f.target);
+					program[f.at] = f.absolute
+						? p32::new_j(target)
+						: f.make(static_cast<register_value>(target - f.at));
+				}
+				
+				context_data context;
+				
+				for (register_value i = 0; i < program.size(); i++) {
+					context.sys_mem[i] = program[i];
+				}
+				
+				return context;
+			}
+		
+		private:
+			struct fixup {
+				register_value at;
+				std::string target;
+				std::function<memory_value(offset_t)> make;
+				bool absolute;
+			};
+			
+			std::vector<memory_value> words;
+			std::map<std::string, register_value> labels;
+			std::vector<fixup> fixups;
+	};
+	
+	// Where workloads keep their data, well clear of their code.
+	constexpr register_value data_base = 0x10000;
+	
+	// A deterministic xorshift stream for filling data.
+	std::vector<memory_value> pseudorandom(const std::size_t count, std::uint32_t state)
+	{
+		std::vector<memory_value> result(count);
+		
+		for (memory_value& value : result) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			value = state & 0xFFFFF;
+		}
+		
+		return result;
+	}
+	
+	void load_data(context_data& context, const std::vector<memory_value>& data)
+	{
+		for (register_value i = 0; i < data.size(); i++) {
+			p32::memory::write_word(context.sys_mem, data_base + i, data[i]);
+		}
+	}
+	
+	std::vector<memory_value> read_data(const context_data& context, const std::size_t count)
+	{
+		std::vector<memory_value> result(count);
+		
+		for (register_value i = 0; i < count; i++) {
+			result[i] = p32::memory::read_word(context.sys_mem, data_base + i);
+		}
+		
+		return result;
+	}
+	
+	// R2 = R0 * R1 by repeated addition, counting R0 down to zero.
+	workload multiply(const unsigned int scale)
+	{
+		const register_value a = 5000 * scale;
+		const register_value b = 12345;
+		assembler code;
+		
+		code.branch("done", [](offset_t o) {return p32::new_blez(0, o);});
+		code.label("loop");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_add(2, 1));
+		code.emit(p32::new_addi(0, -1));
+		code.branch("loop", [](offset_t o) {return p32::new_bgtz(0, o);});
+		code.label("done");
+		code.emit(p32::new_cf());
+		
+		workload w{"multiply", "repeated-addition multiply loop", code.finish(), code.here(), nullptr};
+		w.initial.registers[0] = a;
+		w.initial.registers[1] = b;
+		w.check = [=](const context_data& c) {
+			return c.registers[0] == 0 and c.registers[2] == a * b;
+		};
+		
+		return w;
+	}
+	
+	// R2 = R0 / R1 and R0 = R0 % R1 by repeated subtraction. The loop
+	// overshoots by one step, which is then undone.
+	workload divide(const unsigned int scale)
+	{
+		const register_value n = 1000003 * scale;
+		const register_value d = 47;
+		assembler code;
+		
+		code.label("loop");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_sub(0, 1));
+		code.emit(p32::new_addi(2, 1));
+		code.branch("loop", [](offset_t o) {return p32::new_bgez(0, o);});
+		code.emit(p32::new_add(0, 1));
+		code.emit(p32::new_addi(2, -1));
+		
+		workload w{"divide", "repeated-subtraction divide loop", code.finish(), code.here(), nullptr};
+		w.initial.registers[0] = n;
+		w.initial.registers[1] = d;
+		w.check = [=](const context_data& c) {
+			return c.registers[0] == n % d and c.registers[2] == n / d;
+		};
+		
+		return w;
+	}
+	
+	// Sweeps R1 through a block of memory with EXCHANGE, incrementing
+	// it between words, so every word is read and rewritten each pass.
+	workload exchange_sweep(const unsigned int scale)
+	{
+		constexpr register_value words = 4096;
+		const register_value passes = 2 * scale;
+		const std::vector<memory_value> data = pseudorandom(words, 0x9E3779B9);
+		assembler code;
+		
+		code.label("pass");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_addi(0, words));
+		code.label("word");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_exchange(1, 3));
+		code.emit(p32::new_addi(1, 1));
+		code.emit(p32::new_addi(3, 1));
+		code.emit(p32::new_addi(0, -1));
+		code.branch("word", [](offset_t o) {return p32::new_bgtz(0, o);});
+		code.emit(p32::new_addi(3, -words));
+		code.emit(p32::new_addi(4, -1));
+		code.branch("pass", [](offset_t o) {return p32::new_bgtz(4, o);});
+		
+		workload w{"exchange-sweep", "EXCHANGE passes over a 4096-word block", code.finish(), code.here(), nullptr};
+		load_data(w.initial, data);
+		w.initial.registers[3] = data_base;
+		w.initial.registers[4] = passes;
+		w.check = [=](const context_data& c) {
+			std::vector<memory_value> memory = data;
+			register_value held = 0;
+			
+			for (register_value pass = 0; pass < passes; pass++) {
+				for (memory_value& word : memory) {
+					std::swap(held, word);
+					held++;
+				}
+			}
+			
+			return c.registers[1] == held and read_data(c, words) == memory;
+		};
+		
+		return w;
+	}
+	
+	// Calls down a chain of functions, each saving its link on a stack
+	// in memory before calling the next, and counts calls in R29.
+	workload call_chain(const unsigned int scale)
+	{
+		constexpr unsigned int depth = 64;
+		const register_value rounds = 50 * scale;
+		assembler code;
+		
+		code.label("round");
+		code.emit(p32::new_cf());
+		const register_value link = code.here() + 1;
+		code.branch("f0", [](offset_t o) {return p32::new_jal(31, o);});
+		code.emit(p32::new_cf());
+		code.emit(p32::new_addi(31, -link));
+		code.emit(p32::new_addi(0, -1));
+		code.branch("round", [](offset_t o) {return p32::new_bgtz(0, o);});
+		code.jump("end");
+		
+		for (unsigned int i = 0; i < depth; i++) {
+			code.label("f" + std::to_string(i));
+			code.emit(p32::new_cf());
+			code.emit(p32::new_addi(29, 1));
+			
+			if (i + 1 < depth) {
+				// Push the link, call the next function, clear the
+				// link it set, and pop ours.
+				code.emit(p32::new_exchange(31, 30));
+				code.emit(p32::new_addi(30, 1));
+				const register_value inner_link = code.here() + 1;
+				code.branch("f" + std::to_string(i + 1), [](offset_t o) {return p32::new_jal(31, o);});
+				code.emit(p32::new_cf());
+				code.emit(p32::new_addi(31, -inner_link));
+				code.emit(p32::new_addi(30, -1));
+				code.emit(p32::new_exchange(31, 30));
+			}
+			
+			code.emit(p32::new_jr(31));
+		}
+		
+		code.label("end");
+		code.emit(p32::new_cf());
+		
+		workload w{"call-chain", "JAL calls 64 functions deep", code.finish(), code.here(), nullptr};
+		w.initial.registers[0] = rounds;
+		w.initial.registers[30] = data_base;
+		w.check = [=](const context_data& c) {
+			return c.registers[29] == depth * rounds and c.registers[30] == data_base;
+		};
+		
+		return w;
+	}
+	
+	// Bubble sorts blocks of words in memory, one after another. Each
+	// comparison leaves its inputs on the datapath stack so the swap
+	// decision can be undone.
+	workload bubble_sort(const unsigned int scale)
+	{
+		constexpr register_value count = 48;
+		const register_value blocks = scale;
+		const std::vector<memory_value> data = pseudorandom(count * blocks, 0x2545F491);
+		assembler code;
+		
+		code.label("block");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_addi(6, count - 1));
+		code.label("pass");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_addi(7, count - 1));
+		code.label("compare");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_exchange(1, 3));
+		code.emit(p32::new_exchange(2, 4));
+		// R5 = whether the pair is out of order.
+		code.emit(p32::new_add(5, 2));
+		code.emit(p32::new_slt(5, 1));
+		code.branch("swap", [](offset_t o) {return p32::new_bgtz(5, o);});
+		code.jump("join");
+		code.label("swap");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_xor(1, 2));
+		code.emit(p32::new_xor(2, 1));
+		code.emit(p32::new_xor(1, 2));
+		code.label("join");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_andi(5, 0));
+		code.emit(p32::new_exchange(1, 3));
+		code.emit(p32::new_exchange(2, 4));
+		code.emit(p32::new_addi(3, 1));
+		code.emit(p32::new_addi(4, 1));
+		code.emit(p32::new_addi(7, -1));
+		code.branch("compare", [](offset_t o) {return p32::new_bgtz(7, o);});
+		code.emit(p32::new_addi(3, -(count - 1)));
+		code.emit(p32::new_addi(4, -(count - 1)));
+		code.emit(p32::new_addi(6, -1));
+		code.branch("pass", [](offset_t o) {return p32::new_bgtz(6, o);});
+		code.emit(p32::new_addi(3, count));
+		code.emit(p32::new_addi(4, count));
+		code.emit(p32::new_addi(9, -1));
+		code.branch("block", [](offset_t o) {return p32::new_bgtz(9, o);});
+		
+		workload w{"bubble-sort", "bubble sorts of 48-word blocks in memory", code.finish(), code.here(), nullptr};
+		load_data(w.initial, data);
+		w.initial.registers[3] = data_base;
+		w.initial.registers[4] = data_base + 1;
+		w.initial.registers[9] = blocks;
+		w.check = [=](const context_data& c) {
+			std::vector<memory_value> sorted = data;
+			
+			for (register_value i = 0; i < blocks; i++) {
+				std::sort(sorted.begin() + i * count, sorted.begin() + (i + 1) * count);
+			}
+			
+			return read_data(c, sorted.size()) == sorted;
+		};
+		
+		return w;
+	}
+	
+	// Mixes every word of a block into R8 with XOR, ADD and rotates.
+	workload hash(const unsigned int scale)
+	{
+		constexpr register_value words = 1024;
+		const register_value passes = 4 * scale;
+		const std::vector<memory_value> data = pseudorandom(words, 0x811C9DC5);
+		assembler code;
+		
+		code.label("pass");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_addi(0, words));
+		code.label("word");
+		code.emit(p32::new_cf());
+		code.emit(p32::new_exchange(1, 3));
+		code.emit(p32::new_xor(8, 1));
+		code.emit(p32::new_rl(8, 5));
+		code.emit(p32::new_add(8, 1));
+		code.emit(p32::new_rr(1, 3));
+		code.emit(p32::new_exchange(1, 3));
+		code.emit(p32::new_addi(3, 1));
+		code.emit(p32::new_addi(0, -1));
+		code.branch("word", [](offset_t o) {return p32::new_bgtz(0, o);});
+		code.emit(p32::new_addi(3, -words));
+		code.emit(p32::new_addi(4, -1));
+		code.branch("pass", [](offset_t o) {return p32::new_bgtz(4, o);});
+		
+		workload w{"hash", "rotate-and-XOR hash over a 1024-word block", code.finish(), code.here(), nullptr};
+		load_data(w.initial, data);
+		w.initial.registers[3] = data_base;
+		w.initial.registers[4] = passes;
+		w.initial.registers[8] = 0x811C9DC5;
+		w.check = [=](const context_data& c) {
+			std::vector<memory_value> memory = data;
+			register_value h = 0x811C9DC5;
+			
+			for (register_value pass = 0; pass < passes; pass++) {
+				for (memory_value& word : memory) {
+					h ^= word;
+					h = (h << 5) | (h >> 27);
+					h += word;
+					word = (word >> 3) | (word << 29);
+				}
+			}
+			
+			return c.registers[8] == h and read_data(c, words) == memory;
+		};
+		
+		return w;
+	}
+}
+
+std::vector<workload> p32::workload_corpus(unsigned int scale)
+{
+	scale = std::max(scale, 1U);
+	
+	return {
+		multiply(scale),
+		divide(scale),
+		exchange_sweep(scale),
+		call_chain(scale),
+		bubble_sort(scale),
+		hash(scale),
+	};
+}
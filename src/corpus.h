@@ -0,0 +1,58 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "instruction.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_CORPUS_H
+#define HEADER_P32_CORPUS_H
+
+namespace metronome32 {
+	// A complete guest program along with how to tell it finished
+	// correctly. Running from initial until the counter reaches end
+	// runs the whole program, and reversing until the counter is zero
+	// again undoes it.
+	struct workload {
+		std::string name;
+		// A one-line summary of what the guest does.
+		std::string description;
+		// The program, its data, and its starting registers.
+		context_data initial;
+		// The counter once the program is done.
+		register_value end;
+		// Returns whether a finished context holds the right result.
+		std::function<bool(const context_data&)> check;
+	};
+	
+	// Returns the standard set of guest workloads: multiplication and
+	// division loops, EXCHANGE sweeps over memory, deep JAL call chains,
+	// a bubble sort, and a hashing kernel. Work grows linearly with
+	// scale, which must be at least 1; at scale 1 each one executes a few
+	// tens of thousands of instructions.
+	std::vector<workload> workload_corpus(unsigned int scale = 1);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "generator.h"
+#include "vm.h"
+namespace m32 = metronome32;
+
+typedef std::chrono::steady_clock bench_clock;
+
+// One workload's results: the median throughput of each direction, in
+// guest instructions per second, and the most guest state held at once.
+struct measurement {
+	double forward = 0;
+	double reverse = 0;
+	std::uint64_t peak_bytes = 0;
+};
+
+static double median(std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+	const std::size_t mid = values.size() / 2;
+	
+	return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Runs a workload forward and back repetitions times. Returns false if
+// the guest stops with an error or computes the wrong result.
+static bool run(const m32::workload& work, const unsigned int repetitions, measurement& result)
+{
+	std::vector<double> forward;
+	std::vector<double> reverse;
+	m32::vm machine;
+	
+	for (unsigned int i = 0; i < repetitions; i++) {
+		machine.set_context(work.initial);
+		std::uint64_t steps = 0;
+		auto start = bench_clock::now();
+		
+		while (machine.get_context().counter != work.end) {
+			if (not machine.step()) return false;
+			steps++;
+		}
+		
+		forward.push_back(steps / std::chrono::duration<double>(bench_clock::now() - start).count());
+		// The VM keeps the context's peaks as it steps.
+		result.peak_bytes = std::max<std::uint64_t>(result.peak_bytes, machine.memory_usage().peak_bytes);
+		
+		if (not work.check(machine.get_context())) return false;
+		
+		machine.reverse();
+		steps = 0;
+		start = bench_clock::now();
+		
+		while (machine.get_context().counter != 0) {
+			if (not machine.step()) return false;
+			steps++;
+		}
+		
+		reverse.push_back(steps / std::chrono::duration<double>(bench_clock::now() - start).count());
+	}
+	
+	result.forward = median(forward);
+	result.reverse = median(reverse);
+	
+	return true;
+}
+
+// Baselines are lines of "name forward reverse peak_bytes", with '#'
+// starting a comment.
+static bool load_baseline(const char* path, std::map<std::string, measurement>& baseline)
+{
+	std::ifstream in(path);
+	std::string line;
+	
+	if (not in) {
+		return false;
+	}
+	
+	while (std::getline(in, line)) {
+		std::istringstream fields(line.substr(0, line.find('#')));
+		std::string name;
+		measurement m;
+		
+		if (fields >> name >> m.forward >> m.reverse >> m.peak_bytes) {
+			baseline[name] = m;
+		}
+	}
+	
+	return true;
+}
+
+static bool save_baseline(const char* path, const std::map<std::string, measurement>& results)
+{
+	std::ofstream out(path);
+	out << "# workload  forward/s  reverse/s  peak guest bytes\n" << std::setprecision(6) << std::scientific;
+	
+	for (const auto& r : results) {
+		out << r.first << ' ' << r.second.forward << ' ' << r.second.reverse << ' ' << r.second.peak_bytes << '\n';
+	}
+	
+	return static_cast<bool>(out);
+}
+
+static int usage(const char* program)
+{
+	std::cerr << "usage: " << program << " [--scale N] [--repetitions N] [--baseline FILE]"
+	          << " [--threshold PERCENT] [--save-baseline FILE] [--generate INSTRUCTIONS] [--seed N]\n";
+	
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int scale = 8;
+	unsigned int repetitions = 5;
+	double threshold = 10;
+	const char* baseline_path = nullptr;
+	const char* save_path = nullptr;
+	m32::generator_options generated;
+	generated.instructions = 0;
+	
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 == argc) {
+			return usage(argv[0]);
+		} else if (std::strcmp(argv[i], "--scale") == 0) {
+			scale = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--repetitions") == 0) {
+			repetitions = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--baseline") == 0) {
+			baseline_path = argv[++i];
+		} else if (std::strcmp(argv[i], "--threshold") == 0) {
+			threshold = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "--save-baseline") == 0) {
+			save_path = argv[++i];
+		} else if (std::strcmp(argv[i], "--generate") == 0) {
+			generated.instructions = std::strtoull(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--seed") == 0) {
+			generated.seed = std::strtoull(argv[++i], nullptr, 10);
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	
+	std::map<std::string, measurement> baseline;
+	
+	if (baseline_path != nullptr and not load_baseline(baseline_path, baseline)) {
+		std::cerr << "couldn't read " << baseline_path << '\n';
+		
+		return EXIT_FAILURE;
+	}
+	
+	std::map<std::string, measurement> results;
+	bool failed = false;
+	const double slower = 1 - threshold / 100;
+	const double bigger = 1 + threshold / 100;
+	
+	std::cout << std::left << std::setw(16) << "workload" << std::right << std::setw(14) << "forward/s"
+	          << std::setw(14) << "reverse/s" << std::setw(14) << "peak bytes" << '\n';
+	
+	std::vector<m32::workload> workloads = m32::workload_corpus(scale);
+	
+	if (generated.instructions != 0) {
+		workloads.push_back(m32::generate_workload(generated));
+	}
+	
+	for (const m32::workload& work : workloads) {
+		measurement m;
+		
+		if (not run(work, repetitions, m)) {
+			std::cout << std::left << std::setw(16) << work.name << "FAILED\n";
+			failed = true;
+			continue;
+		}
+		
+		results[work.name] = m;
+		std::cout << std::left << std::setw(16) << work.name << std::right << std::setprecision(3) << std::scientific
+		          << std::setw(14) << m.forward << std::setw(14) << m.reverse << std::setw(14) << m.peak_bytes;
+		
+		const auto base = baseline.find(work.name);
+		
+		if (base != baseline.end()) {
+			const bool regressed = m.forward < base->second.forward * slower
+			                    or m.reverse < base->second.reverse * slower
+			                    or m.peak_bytes > base->second.peak_bytes * bigger;
+			std::cout << std::fixed << std::setprecision(1)
+			          << "  (" << std::showpos << 100 * (m.forward / base->second.forward - 1) << "% / "
+			          << 100 * (m.reverse / base->second.reverse - 1) << "%" << std::noshowpos << ")"
+			          << (regressed ? "  REGRESSION" : "");
+			failed = failed or regressed;
+		}
+		
+		std::cout << '\n';
+	}
+	
+	if (save_path != nullptr and not save_baseline(save_path, results)) {
+		std::cerr << "couldn't write " << save_path << '\n';
+		failed = true;
+	}
+	
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <iomanip>
+#include "counters.h"
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #define _COUNTERSCPP_PERF 1
+#else
+ #define _COUNTERSCPP_PERF 0
+#endif
+
+namespace p32 = metronome32;
+
+using p32::hardware_event;
+using p32::counter_sample;
+using p32::hardware_counters;
+using p32::counter_report;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+GC const char* p32::hardware_event_name(const hardware_event event) noexcept
+{
+	switch (event) {
+		case hardware_event::cycles: return "cycles";
+		case hardware_event::instructions: return "instructions";
+		case hardware_event::branch_misses: return "branch-misses";
+		case hardware_event::l1d_misses: return "L1d-misses";
+		case hardware_event::llc_misses: return "LLC-misses";
+		default: return "unknown";
+	}
+}
+
+counter_sample& counter_sample::operator+=(const counter_sample& other) noexcept
+{
+	for (std::size_t i = 0; i < hardware_event_count; i++) {
+		values[i] += other.values[i];
+		valid[i] = valid[i] and other.valid[i];
+	}
+	
+	guest_instructions += other.guest_instructions;
+	
+	return *this;
+}
+
+GP double counter_sample::per_guest_instruction(const hardware_event event) const noexcept
+{
+	const std::size_t i = static_cast<std::size_t>(event);
+	
+	if (not valid[i] or guest_instructions == 0) {
+		return -1;
+	}
+	
+	return static_cast<double>(values[i]) / guest_instructions;
+}
+
+#if _COUNTERSCPP_PERF
+// Opens one user-space counter for the calling thread, or returns -1.
+static int open_event(const std::uint32_t type, const std::uint64_t config) noexcept
+{
+	perf_event_attr attr = {};
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	
+	return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static constexpr std::uint64_t cache_miss(const std::uint64_t cache) noexcept
+{
+	return cache
+	     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+	     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+hardware_counters::hardware_counters() noexcept
+{
+	fds.fill(-1);
+	
+#if _COUNTERSCPP_PERF
+	const std::array<std::pair<std::uint32_t, std::uint64_t>, hardware_event_count> events = {{
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+		{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+		{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+	}};
+	
+	for (std::size_t i = 0; i < hardware_event_count; i++) {
+		fds[i] = open_event(events[i].first, events[i].second);
+	}
+#endif
+}
+
+hardware_counters::~hardware_counters()
+{
+#if _COUNTERSCPP_PERF
+	for (const int fd : fds) {
+		if (fd >= 0) {
+			close(fd);
+		}
+	}
+#endif
+}
+
+GP bool hardware_counters::available() const noexcept
+{
+	for (const int fd : fds) {
+		if (fd >= 0) {
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+GP bool hardware_counters::available(const hardware_event event) const noexcept
+{
+	return fds[static_cast<std::size_t>(event)] >= 0;
+}
+
+void hardware_counters::begin() noexcept
+{
+#if _COUNTERSCPP_PERF
+	for (const int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+counter_sample hardware_counters::end() noexcept
+{
+	counter_sample sample;
+	
+#if _COUNTERSCPP_PERF
+	for (const int fd : fds) {
+		if (fd >= 0) {
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	
+	for (std::size_t i = 0; i < hardware_event_count; i++) {
+		// The value, then the time enabled and the time running.
+		std::uint64_t data[3];
+		
+		if (fds[i] < 0 or read(fds[i], data, sizeof(data)) != sizeof(data) or data[2] == 0) {
+			continue;
+		}
+		
+		sample.valid[i] = true;
+		sample.values[i] = data[2] == data[1]
+			? data[0]
+			: static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+	}
+#endif
+	
+	return sample;
+}
+
+void counter_report::add(const std::string& engine, const bool reversing, const counter_sample& sample)
+{
+	const auto inserted = rows.emplace(std::make_pair(engine, reversing), sample);
+	
+	if (not inserted.second) {
+		inserted.first->second += sample;
+	}
+}
+
+const counter_sample* counter_report::find(const std::string& engine, const bool reversing) const noexcept
+{
+	const auto row = rows.find({engine, reversing});
+	
+	return row == rows.end() ? nullptr : &row->second;
+}
+
+void counter_report::write(std::ostream& out) const
+{
+	// The caller's formatting, put back once the table is written.
+	const std::ios_base::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	
+	out << "engine               direction  guest instructions";
+	
+	for (std::size_t i = 0; i < hardware_event_count; i++) {
+		out << "  " << std::setw(13) << hardware_event_name(static_cast<hardware_event>(i));
+	}
+	
+	out << "  (per guest instruction)\n";
+	
+	for (const auto& row : rows) {
+		out << std::left << std::setw(20) << row.first.first << std::right
+		    << (row.first.second ? " backward " : " forward  ")
+		    << std::setw(19) << row.second.guest_instructions;
+		
+		for (std::size_t i = 0; i < hardware_event_count; i++) {
+			const double ratio = row.second.per_guest_instruction(static_cast<hardware_event>(i));
+			out << "  " << std::setw(13);
+			
+			if (ratio < 0) {
+				out << "n/a";
+			} else {
+				out << std::fixed << std::setprecision(3) << ratio;
+			}
+		}
+		
+		out << '\n';
+	}
+	
+	out.flags(flags);
+	out.precision(precision);
+}
+
+#undef GP
+#undef GC
+#undef _COUNTERSCPP_PERF
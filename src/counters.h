@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include "vm.h"
+
+#ifndef HEADER_P32_COUNTERS_H
+#define HEADER_P32_COUNTERS_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// Host hardware events that can be counted.
+	enum class hardware_event : std::uint8_t {
+		cycles,
+		instructions,
+		branch_misses,
+		l1d_misses,
+		llc_misses,
+	};
+	// The number of distinct hardware_event values.
+	constexpr std::size_t hardware_event_count = static_cast<std::size_t>(hardware_event::llc_misses) + 1;
+	
+	// Returns the name of a hardware event.
+	GC const char* hardware_event_name(hardware_event event) noexcept;
+	
+	// Host events counted over some guest instructions. Events the host
+	// couldn't count are marked invalid.
+	struct counter_sample {
+		std::array<std::uint64_t, hardware_event_count> values = {};
+		std::array<bool, hardware_event_count> valid = {};
+		// The number of guest instructions retired while counting.
+		std::uint64_t guest_instructions = 0;
+		
+		// Adds another sample's counts. An event stays valid only if
+		// it's valid in both.
+		counter_sample& operator+=(const counter_sample& other) noexcept;
+		// Returns the count of event per guest instruction, or a
+		// negative number if the event is invalid or nothing retired.
+		GP double per_guest_instruction(hardware_event event) const noexcept;
+	};
+	
+	// A set of perf_event_open counters for the calling thread, counting
+	// user-space events only. Any event the kernel refuses (no PMU, a
+	// strict perf_event_paranoid, a non-Linux host) is left closed, and
+	// every other member still works.
+	class hardware_counters {
+		public:
+			hardware_counters() noexcept;
+			hardware_counters(const hardware_counters&) = delete;
+			hardware_counters& operator=(const hardware_counters&) = delete;
+			~hardware_counters();
+			
+			// Whether any event, or a particular event, is counted.
+			GP bool available() const noexcept;
+			GP bool available(hardware_event event) const noexcept;
+			
+			// Zeroes and starts the counters.
+			void begin() noexcept;
+			// Stops the counters and reads them. Counts are scaled up
+			// if the kernel multiplexed them.
+			counter_sample end() noexcept;
+		
+		private:
+			std::array<int, hardware_event_count> fds;
+	};
+	
+	// Steps machine until it has executed max_steps instructions or stops,
+	// counting host events around it. guest_instructions is set to the
+	// number of steps that succeeded.
+	template <class Statistics>
+	counter_sample measure_steps(hardware_counters& counters, basic_vm<Statistics>& machine, std::uint64_t max_steps) noexcept;
+	
+	// Collects samples per engine and per direction, and reports host
+	// events per guest instruction.
+	class counter_report {
+		public:
+			// Adds a sample to the row for an engine and direction.
+			void add(const std::string& engine, bool reversing, const counter_sample& sample);
+			// Returns a row, or nullptr if nothing was added to it.
+			const counter_sample* find(const std::string& engine, bool reversing) const noexcept;
+			// Writes one line per row, with "n/a" for invalid events.
+			void write(std::ostream& out) const;
+		
+		private:
+			std::map<std::pair<std::string, bool>, counter_sample> rows;
+	};
+}
+
+#undef GP
+#undef GC
+
+template <class Statistics>
+metronome32::counter_sample metronome32::measure_steps(hardware_counters& counters, basic_vm<Statistics>& machine, const std::uint64_t max_steps) noexcept
+{
+	std::uint64_t retired = 0;
+	counters.begin();
+	
+	while (retired < max_steps and machine.step()) {
+		retired++;
+	}
+	
+	counter_sample sample = counters.end();
+	sample.guest_instructions = retired;
+	
+	return sample;
+}
+
+#endif
@@ -0,0 +1,318 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <stack>
+#include "differential.h"
+#include "memory.h"
+
+namespace p32 = metronome32;
+
+using p32::context_data;
+using p32::divergence;
+using p32::differential_options;
+using p32::engine;
+using p32::register_value;
+using p32::workload;
+
+#define GP [[gnu::pure]]
+
+namespace {
+	// Exposes a std::stack's container, which holds its entries from
+	// the bottom up.
+	template <class Stack>
+	struct stack_access : Stack {
+		GP static const typename Stack::container_type& of(const Stack& stack) noexcept
+		{
+			return stack.*&stack_access::c;
+		}
+	};
+	
+	template <class Stack>
+	GP const typename Stack::container_type& entries(const Stack& stack) noexcept
+	{
+		return stack_access<Stack>::of(stack);
+	}
+	
+	// 64-bit FNV-1a.
+	struct fnv {
+		std::uint64_t value = 0xCBF29CE484222325;
+		
+		void add(std::uint64_t word) noexcept
+		{
+			for (int i = 0; i < 8; i++) {
+				value ^= word & 0xFF;
+				value *= 0x100000001B3;
+				word >>= 8;
+			}
+		}
+	};
+	
+	template <class Stack>
+	void add_stack(fnv& hash, const Stack& stack, const bool deep) noexcept
+	{
+		hash.add(stack.size());
+		
+		if (deep) {
+			for (const register_value value : entries(stack)) {
+				hash.add(value);
+			}
+		} else if (not stack.empty()) {
+			hash.add(stack.top());
+		}
+	}
+	
+	void write_hex(std::ostream& out, const std::uint64_t value)
+	{
+		out << "0x" << std::hex << value << std::dec;
+	}
+	
+	template <class Stack>
+	void diff_stack(std::ostream& out, const char* name, const Stack& expected, const Stack& actual)
+	{
+		const auto& a = entries(expected);
+		const auto& b = entries(actual);
+		
+		if (a.size() != b.size()) {
+			out << name << " depth: " << a.size() << " != " << b.size() << '\n';
+		}
+		
+		for (std::size_t i = 0; i < a.size() and i < b.size(); i++) {
+			if (a[i] != b[i]) {
+				out << name << '[' << i << "]: ";
+				write_hex(out, a[i]);
+				out << " != ";
+				write_hex(out, b[i]);
+				out << '\n';
+				
+				break;
+			}
+		}
+	}
+	
+	// Both engines after loading the same context.
+	void start(engine& reference, engine& candidate, const context_data& initial, const bool reversing)
+	{
+		reference.load(initial);
+		candidate.load(initial);
+		reference.reverse(reversing);
+		candidate.reverse(reversing);
+	}
+	
+	// Whether both engines, loaded with from, agree after steps
+	// instructions, down to their memory.
+	bool agree_after(engine& reference, engine& candidate, const context_data& from, const register_value stop_at, const std::uint64_t steps)
+	{
+		reference.load(from);
+		candidate.load(from);
+		const std::uint64_t a = reference.run(steps, stop_at);
+		const std::uint64_t b = candidate.run(steps, stop_at);
+		
+		return a == b and p32::state_hash(reference.context(), true) == p32::state_hash(candidate.context(), true);
+	}
+	
+	// Finds the first instruction that diverged, knowing the engines
+	// fully agreed good steps after from, and disagreed bad steps
+	// after it. Both are replayed to good, then bisected from there.
+	void pinpoint(engine& reference, engine& candidate, const context_data& from, const register_value stop_at, const std::uint64_t good, const std::uint64_t bad, divergence& result)
+	{
+		start(reference, candidate, from, result.reversing);
+		reference.run(good, stop_at);
+		const context_data checkpoint = reference.context();
+		std::uint64_t low = 0;
+		std::uint64_t high = bad - good;
+		
+		while (high - low > 1) {
+			const std::uint64_t middle = low + (high - low) / 2;
+			
+			if (agree_after(reference, candidate, checkpoint, stop_at, middle)) {
+				low = middle;
+			} else {
+				high = middle;
+			}
+		}
+		
+		// Step to just before the divergent instruction, then over it.
+		agree_after(reference, candidate, checkpoint, stop_at, low);
+		const register_value counter = reference.context().counter;
+		const std::uint64_t a = reference.run(1, stop_at);
+		const std::uint64_t b = candidate.run(1, stop_at);
+		
+		result.step = good + low;
+		result.pc = result.reversing ? counter - 1 : counter;
+		result.diff = a == b ? "" : "retired: " + std::to_string(a) + " != " + std::to_string(b) + '\n';
+		result.diff += p32::state_diff(reference.context(), candidate.context());
+	}
+	
+	// Runs one direction. Returns false on divergence.
+	bool run_direction(engine& reference, engine& candidate, const context_data& from, const register_value stop_at, const differential_options& options, divergence& result)
+	{
+		std::uint64_t& total = result.reversing ? result.reverse_steps : result.forward_steps;
+		// Where the engines last fully agreed.
+		std::uint64_t good = 0;
+		std::uint64_t checks = 0;
+		start(reference, candidate, from, result.reversing);
+		
+		while (total < options.max_steps) {
+			const std::uint64_t chunk = std::min(options.interval, options.max_steps - total);
+			const std::uint64_t a = reference.run(chunk, stop_at);
+			const std::uint64_t b = candidate.run(chunk, stop_at);
+			const bool deep = ++checks % options.deep_every == 0 or a < chunk or b < chunk;
+			
+			if (a != b or p32::state_hash(reference.context(), deep) != p32::state_hash(candidate.context(), deep)) {
+				result.found = true;
+				pinpoint(reference, candidate, from, stop_at, good, total + std::max(a, b), result);
+				
+				return false;
+			}
+			
+			total += a;
+			
+			if (deep) {
+				good = total;
+			}
+			
+			if (a < chunk) {
+				break;
+			}
+		}
+		
+		return true;
+	}
+}
+
+GP std::uint64_t p32::state_hash(const context_data& context, const bool deep) noexcept
+{
+	fnv hash;
+	hash.add(context.counter);
+	hash.add(context.reversing);
+	hash.add(context.halted);
+	hash.add(static_cast<std::uint64_t>(context.errcode));
+	
+	for (const register_value value : context.registers) {
+		hash.add(value);
+	}
+	
+	add_stack(hash, context.dp_stack, deep);
+	add_stack(hash, context.pc_stack, deep);
+	
+	if (deep) {
+		// Words equal to the default are the same as absent ones.
+		for (const auto& word : context.sys_mem) {
+			if (word.second != memory_default) {
+				hash.add(word.first);
+				hash.add(word.second);
+			}
+		}
+	}
+	
+	return hash.value;
+}
+
+std::string p32::state_diff(const context_data& expected, const context_data& actual)
+{
+	std::ostringstream out;
+	
+	if (expected.counter != actual.counter) {
+		out << "counter: ";
+		write_hex(out, expected.counter);
+		out << " != ";
+		write_hex(out, actual.counter);
+		out << '\n';
+	}
+	
+	if (expected.reversing != actual.reversing) {
+		out << "reversing: " << expected.reversing << " != " << actual.reversing << '\n';
+	}
+	
+	if (expected.halted != actual.halted) {
+		out << "halted: " << expected.halted << " != " << actual.halted << '\n';
+	}
+	
+	if (expected.errcode != actual.errcode) {
+		out << "errcode: " << static_cast<int>(expected.errcode) << " != " << static_cast<int>(actual.errcode) << '\n';
+	}
+	
+	for (std::size_t i = 0; i < expected.registers.size(); i++) {
+		if (expected.registers[i] != actual.registers[i]) {
+			out << 'r' << i << ": ";
+			write_hex(out, expected.registers[i]);
+			out << " != ";
+			write_hex(out, actual.registers[i]);
+			out << '\n';
+		}
+	}
+	
+	diff_stack(out, "dp_stack", expected.dp_stack, actual.dp_stack);
+	diff_stack(out, "pc_stack", expected.pc_stack, actual.pc_stack);
+	
+	const auto diff_word = [&](const register_value address) {
+		const memory_value a = p32::memory::read_word(expected.sys_mem, address);
+		const memory_value b = p32::memory::read_word(actual.sys_mem, address);
+		
+		if (a != b) {
+			out << "memory[";
+			write_hex(out, address);
+			out << "]: ";
+			write_hex(out, a);
+			out << " != ";
+			write_hex(out, b);
+			out << '\n';
+		}
+	};
+	
+	for (const auto& word : expected.sys_mem) {
+		diff_word(word.first);
+	}
+	
+	for (const auto& word : actual.sys_mem) {
+		if (expected.sys_mem.count(word.first) == 0) {
+			diff_word(word.first);
+		}
+	}
+	
+	return out.str();
+}
+
+divergence p32::run_differential(engine& reference, engine& candidate, const workload& work, const differential_options& options)
+{
+	divergence result;
+	
+	if (not run_direction(reference, candidate, work.initial, work.end, options, result)) {
+		return result;
+	}
+	
+	// Both engines agree, so either one's context starts the reverse run.
+	const context_data finished = reference.context();
+	result.reversing = true;
+	
+	if (not run_direction(reference, candidate, finished, 0, options, result)) {
+		return result;
+	}
+	
+	result.reversing = false;
+	
+	return result;
+}
+
+#undef GP
@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <string>
+#include "corpus.h"
+#include "engine.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_DIFFERENTIAL_H
+#define HEADER_P32_DIFFERENTIAL_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	// Hashes a context. A shallow hash covers the counter, flags,
+	// registers, and the garbage stacks' depths and tops; a deep one
+	// also covers memory and every stack entry.
+	GP std::uint64_t state_hash(const context_data& context, bool deep) noexcept;
+	// Describes every difference between two contexts, one per line.
+	// Returns an empty string if they're equal.
+	std::string state_diff(const context_data& expected, const context_data& actual);
+	
+	struct differential_options {
+		// Steps between shallow comparisons.
+		std::uint64_t interval = 4096;
+		// Shallow comparisons between deep ones.
+		std::uint64_t deep_every = 64;
+		// Gives up on a direction after this many steps.
+		std::uint64_t max_steps = UINT64_MAX;
+	};
+	
+	// The result of a differential run.
+	struct divergence {
+		// Whether the engines disagreed.
+		bool found = false;
+		// Whether it happened while reversing.
+		bool reversing = false;
+		// The instructions retired in that direction before it.
+		std::uint64_t step = 0;
+		// The address of the instruction that diverged.
+		register_value pc = 0;
+		// The differences, from state_diff.
+		std::string diff;
+		// Instructions run forward and in reverse, by each engine.
+		std::uint64_t forward_steps = 0;
+		std::uint64_t reverse_steps = 0;
+	};
+	
+	// Runs a workload forward to its end and back to its start on both
+	// engines in lockstep, comparing state hashes between intervals.
+	// When they disagree, both are replayed from the start one
+	// instruction at a time to find the first one that differs.
+	divergence run_differential(engine& reference, engine& candidate, const workload& work, const differential_options& options = {});
+}
+
+#undef GP
+
+#endif
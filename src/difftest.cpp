@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "corpus.h"
+#include "differential.h"
+#include "engine.h"
+#include "generator.h"
+namespace m32 = metronome32;
+
+static int usage(const char* program)
+{
+	std::cerr << "usage: " << program << " [--candidate ENGINE] [--scale N] [--seeds N]"
+	          << " [--instructions N] [--interval N]\n";
+	
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> candidates;
+	unsigned int scale = 1;
+	std::uint64_t seeds = 8;
+	std::uint64_t instructions = 1000000;
+	m32::differential_options options;
+	
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 == argc) {
+			return usage(argv[0]);
+		} else if (std::strcmp(argv[i], "--candidate") == 0) {
+			candidates.push_back(argv[++i]);
+		} else if (std::strcmp(argv[i], "--scale") == 0) {
+			scale = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--seeds") == 0) {
+			seeds = std::strtoull(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--instructions") == 0) {
+			instructions = std::strtoull(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--interval") == 0) {
+			options.interval = std::max<std::uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	
+	// By default, check every engine other than the reference.
+	if (candidates.empty()) {
+		for (const std::string& name : m32::engine_names()) {
+			if (name != "reference") {
+				candidates.push_back(name);
+			}
+		}
+	}
+	
+	std::vector<m32::workload> workloads = m32::workload_corpus(scale);
+	
+	for (std::uint64_t seed = 1; seed <= seeds; seed++) {
+		m32::generator_options generated;
+		generated.seed = seed;
+		generated.instructions = instructions;
+		workloads.push_back(m32::generate_workload(generated));
+	}
+	
+	bool failed = false;
+	
+	for (const std::string& name : candidates) {
+		std::unique_ptr<m32::engine> candidate = m32::make_engine(name);
+		m32::reference_engine reference;
+		std::uint64_t checked = 0;
+		const auto start = std::chrono::steady_clock::now();
+		
+		if (candidate == nullptr) {
+			std::cerr << "unknown engine " << name << '\n';
+			failed = true;
+			continue;
+		}
+		
+		for (const m32::workload& work : workloads) {
+			const m32::divergence result = m32::run_differential(reference, *candidate, work, options);
+			checked += result.forward_steps + result.reverse_steps;
+			
+			if (result.found) {
+				std::cout << name << " diverged on " << work.name
+				          << (result.reversing ? " in reverse" : " forward")
+				          << " after " << result.step << " instructions, at PC 0x" << std::hex << result.pc << std::dec << ":\n"
+				          << result.diff;
+				failed = true;
+			}
+		}
+		
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << name << ": checked " << checked << " instructions in " << elapsed << "s ("
+		          << checked / elapsed << " per second)\n";
+	}
+	
+	if (candidates.empty()) {
+		std::cout << "no engines besides the reference to check\n";
+	}
+	
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,338 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "engine.h"
+#include "instruction.h"
+#include "memory.h"
+
+namespace p32 = metronome32;
+
+using p32::context_data;
+using p32::engine;
+using p32::fused_engine;
+using p32::idiom_engine;
+using p32::jit_engine;
+using p32::loop_idioms;
+using p32::native_code;
+using p32::predecoded_code;
+using p32::reference_engine;
+using p32::tier_manager;
+using p32::tiered_engine;
+using p32::verified_engine;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+GC const char* reference_engine::name() const noexcept
+{
+	return "reference";
+}
+
+void reference_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+}
+
+GP const context_data& reference_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void reference_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t reference_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	std::uint64_t retired = 0;
+	
+	while (retired < max_steps and machine.get_context().counter != stop_at and machine.step()) {
+		retired++;
+	}
+	
+	return retired;
+}
+
+GC const char* verified_engine::name() const noexcept
+{
+	return "verified";
+}
+
+void verified_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+	proof.verify(context.sys_mem);
+}
+
+GP const context_data& verified_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void verified_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t verified_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	std::uint64_t retired = 0;
+	
+	while (retired < max_steps and machine.get_context().counter != stop_at and machine.step_verified(proof)) {
+		retired++;
+	}
+	
+	return retired;
+}
+
+GC const char* fused_engine::name() const noexcept
+{
+	return "fused";
+}
+
+void fused_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+	code.clear();
+}
+
+GP const context_data& fused_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void fused_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t fused_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	return machine.run_predecoded(code, max_steps, stop_at);
+}
+
+GC const char* jit_engine::name() const noexcept
+{
+	return "jit";
+}
+
+void jit_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+	code.clear();
+	native.clear();
+}
+
+GP const context_data& jit_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void jit_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t jit_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	return machine.run_predecoded(code, max_steps, stop_at, &native);
+}
+
+GC const char* idiom_engine::name() const noexcept
+{
+	return "idioms";
+}
+
+void idiom_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+	code.clear();
+	native.clear();
+	loops = loop_idioms(context.sys_mem);
+}
+
+GP const context_data& idiom_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void idiom_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t idiom_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	return machine.run_predecoded(code, max_steps, stop_at, &native, &loops);
+}
+
+GC const loop_idioms& idiom_engine::idioms() const noexcept
+{
+	return loops;
+}
+
+tiered_engine::tiered_engine(const std::uint32_t threshold)
+	: manager(threshold)
+{
+	code.seal(true);
+}
+
+GC const char* tiered_engine::name() const noexcept
+{
+	return "tiered";
+}
+
+void tiered_engine::load(const context_data& context)
+{
+	machine.set_context(context);
+	manager.revalidate(context.sys_mem, code, native);
+}
+
+GP const context_data& tiered_engine::context() noexcept
+{
+	return machine.get_context();
+}
+
+void tiered_engine::reverse(const bool set_reverse) noexcept
+{
+	machine.reverse(set_reverse);
+}
+
+std::uint64_t tiered_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	const context_data& context = machine.get_context();
+	std::uint64_t retired = 0;
+	// Whether the counter is at the start of a basic block, where
+	// compiled pages may be switched in.
+	bool boundary = true;
+	
+	while (retired < max_steps and context.counter != stop_at) {
+		const bool backwards = context.reversing;
+		const register_value pc = backwards ? context.counter - 1 : context.counter;
+		
+		if (boundary and manager.ready()) {
+			manager.install(context.sys_mem, code, native);
+		}
+		
+		if (boundary and code.holds(pc)) {
+			const std::uint64_t done = machine.run_predecoded(code, max_steps - retired, stop_at, &native);
+			
+			if (done == 0) {
+				break;
+			}
+			
+			retired += done;
+			
+			// It stopped at a cold page, which is a block entry too.
+			const register_value next = context.reversing ? context.counter - 1 : context.counter;
+			
+			if (not code.holds(next)) {
+				manager.entered(context.sys_mem, code, next);
+			}
+			
+			continue;
+		}
+		
+		// The interpreter doesn't tell code about its writes, so an
+		// EXCHANGE's address is taken before it runs, once there are
+		// compiled pages it could write.
+		const bool watching = code.pages() != 0;
+		const p32::predecoded_word word = watching ? p32::predecode(p32::memory::read_word(context.sys_mem, pc)) : p32::predecoded_word();
+		const register_value address = word.op == p32::opcode::exchange ? context.registers[word.args.b.rb.to_ulong()] : 0;
+		
+		if (not machine.step()) {
+			break;
+		}
+		
+		retired++;
+		
+		if (word.op == p32::opcode::exchange) {
+			code.wrote(address);
+			native.wrote(address);
+		}
+		
+		// Anything but falling through to the next word enters a block.
+		const register_value next = backwards ? context.counter - 1 : context.counter;
+		boundary = backwards ? next != pc - 1 : next != pc + 1;
+		
+		if (boundary) {
+			manager.entered(context.sys_mem, code, next);
+		}
+	}
+	
+	return retired;
+}
+
+GC const predecoded_code& tiered_engine::compiled() const noexcept
+{
+	return code;
+}
+
+GC const tier_manager& tiered_engine::tiers() const noexcept
+{
+	return manager;
+}
+
+GC const native_code& tiered_engine::native_blocks() const noexcept
+{
+	return native;
+}
+
+std::vector<std::string> p32::engine_names()
+{
+	return {"reference", "verified", "fused", "jit", "idioms", "tiered"};
+}
+
+std::unique_ptr<engine> p32::make_engine(const std::string& name)
+{
+	if (name == "reference") {
+		return std::unique_ptr<engine>(new reference_engine());
+	}
+	
+	if (name == "verified") {
+		return std::unique_ptr<engine>(new verified_engine());
+	}
+	
+	if (name == "fused") {
+		return std::unique_ptr<engine>(new fused_engine());
+	}
+	
+	if (name == "jit") {
+		return std::unique_ptr<engine>(new jit_engine());
+	}
+	
+	if (name == "idioms") {
+		return std::unique_ptr<engine>(new idiom_engine());
+	}
+	
+	if (name == "tiered") {
+		return std::unique_ptr<engine>(new tiered_engine());
+	}
+	
+	return nullptr;
+}
+
+#undef GP
+#undef GC
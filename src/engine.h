@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "idioms.h"
+#include "predecode.h"
+#include "tiering.h"
+#include "verifier.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_ENGINE_H
+#define HEADER_P32_ENGINE_H
+
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// An execution engine: anything that can run a context the way
+	// vm::step does. Every engine must leave exactly the context the
+	// reference engine would, step for step, in both directions.
+	class engine {
+		public:
+			virtual ~engine() = default;
+			
+			// A short name, such as "reference".
+			virtual const char* name() const noexcept = 0;
+			// Replaces the engine's context.
+			virtual void load(const context_data& context) = 0;
+			// Returns the current context, bringing it up to date
+			// first if the engine keeps state elsewhere.
+			virtual const context_data& context() noexcept = 0;
+			// Sets the direction of execution.
+			virtual void reverse(bool set_reverse) noexcept = 0;
+			// Executes up to max_steps instructions, stopping before
+			// one would start at stop_at, or after one that didn't
+			// retire. Returns how many retired.
+			virtual std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept = 0;
+	};
+	
+	// The engine everything else is checked against, a plain vm.
+	class reference_engine final : public engine {
+		public:
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+		
+		private:
+			vm machine;
+	};
+	
+	// A vm that verifies each context it is given, and then skips the
+	// runtime checks the proof covers. Indirect jumps and code that
+	// EXCHANGE has written to are still checked.
+	class verified_engine final : public engine {
+		public:
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+		
+		private:
+			vm machine;
+			verified_code proof;
+	};
+	
+	// A vm running from a predecoded copy of memory, with idioms of two
+	// instructions fused into one dispatch. See predecoded_code.
+	class fused_engine final : public engine {
+		public:
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+		
+		private:
+			vm machine;
+			predecoded_code code;
+	};
+	
+	// A fused_engine that also compiles runs of ALU words to x86-64
+	// code and runs those natively. See native_code. Where nothing can
+	// be compiled, it is a fused_engine.
+	class jit_engine final : public engine {
+		public:
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+		
+		private:
+			vm machine;
+			predecoded_code code;
+			native_code native;
+	};
+	
+	// A jit_engine that also runs the counted loops of loop_idioms,
+	// found in each context as it is loaded, in closed form. A guest's
+	// multiply or divide loop then costs about as much as one of its
+	// passes.
+	class idiom_engine final : public engine {
+		public:
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+			
+			// The loops found in the context last loaded and not since
+			// written.
+			GC const loop_idioms& idioms() const noexcept;
+		
+		private:
+			vm machine;
+			predecoded_code code;
+			native_code native;
+			loop_idioms loops;
+	};
+	
+	// A vm that starts every program one instruction at a time, and
+	// moves each page to predecoded and native code once one of its
+	// basic blocks is hot, as a tier_manager compiles them. Compiled
+	// pages are switched in between blocks, and a page written is
+	// dropped back to the interpreter until it is hot again. Loading a
+	// context keeps the compiled pages its memory still matches.
+	class tiered_engine final : public engine {
+		public:
+			explicit tiered_engine(std::uint32_t threshold = tier_manager::default_threshold);
+			
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			const context_data& context() noexcept override;
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+			
+			// The pages of each tier, and the native blocks compiled for
+			// them.
+			GC const predecoded_code& compiled() const noexcept;
+			GC const tier_manager& tiers() const noexcept;
+			GC const native_code& native_blocks() const noexcept;
+		
+		private:
+			vm machine;
+			predecoded_code code;
+			native_code native;
+			tier_manager manager;
+	};
+	
+	// The names of every engine make_engine() can build.
+	std::vector<std::string> engine_names();
+	// Builds an engine by name, or returns nullptr for unknown names.
+	std::unique_ptr<engine> make_engine(const std::string& name);
+}
+
+#undef GC
+
+#endif
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "fuzz.h"
+
+namespace p32 = metronome32;
+
+using p32::edge_coverage;
+using p32::fuzz_harness;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::size_t edge_coverage::map_size;
+constexpr std::uint8_t fuzz_harness::flag_reverse;
+constexpr std::size_t fuzz_harness::max_words;
+
+edge_coverage::edge_coverage() noexcept
+	: map(own.data())
+{}
+
+edge_coverage::edge_coverage(const edge_coverage& other)
+	: own(other.own), map(other.map == other.own.data() ? own.data() : other.map), dirty(other.dirty)
+{}
+
+edge_coverage& edge_coverage::operator=(const edge_coverage& other)
+{
+	own = other.own;
+	map = other.map == other.own.data() ? own.data() : other.map;
+	dirty = other.dirty;
+	
+	return *this;
+}
+
+void edge_coverage::attach(std::uint8_t* const counters) noexcept
+{
+	map = counters == nullptr ? own.data() : counters;
+}
+
+GP const std::uint8_t* edge_coverage::counters() const noexcept
+{
+	return map;
+}
+
+GP std::size_t edge_coverage::edges() const noexcept
+{
+	return map_size - std::count(map, map + map_size, 0);
+}
+
+void edge_coverage::clear_counters() noexcept
+{
+	std::fill(map, map + map_size, 0);
+}
+
+fuzz_harness::fuzz_harness(const std::uint64_t step_budget)
+	: budget(step_budget)
+{
+	image = guest.get_context();
+	// Inputs hold up to max_words words, growing the dirty list by at
+	// most a page per 2^page_bits words.
+	guest.statistics().dirty_pages().reserve((max_words >> p32::memory::page_bits) + 1024);
+}
+
+void fuzz_harness::reset() noexcept
+{
+	std::vector<register_value>& dirty = guest.statistics().dirty_pages();
+	guest.restore(image, dirty);
+	dirty.clear();
+}
+
+void fuzz_harness::run(const std::uint8_t* const data, const std::size_t size) noexcept
+{
+	reset();
+	
+	if (size == 0) {
+		return;
+	}
+	
+	const std::uint8_t flags = data[0];
+	const std::size_t words = std::min((size - 1) / 4, max_words);
+	std::array<memory_value, 256> chunk;
+	
+	for (std::size_t done = 0; done < words; done += chunk.size()) {
+		const std::size_t count = std::min(chunk.size(), words - done);
+		
+		for (std::size_t i = 0; i < count; i++) {
+			const std::uint8_t* const bytes = data + 1 + 4 * (done + i);
+			chunk[i] = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | std::uint32_t(bytes[3]) << 24;
+		}
+		
+		guest.load_words(chunk.data(), count, done);
+	}
+	
+	for (register_value page = 0; page <= p32::memory::page_of(words); page++) {
+		guest.statistics().mark_dirty(page << p32::memory::page_bits);
+	}
+	
+	std::uint64_t retired = 0;
+	
+	while (retired < budget and guest.step()) {
+		retired++;
+	}
+	
+	if (flags & flag_reverse) {
+		guest.halt(false);
+		guest.reverse();
+		
+		for (std::uint64_t i = 0; i < retired and guest.step(); i++) {}
+	}
+}
+
+GC const p32::basic_vm<edge_coverage>& fuzz_harness::machine() const noexcept
+{
+	return guest;
+}
+
+GC p32::basic_vm<edge_coverage>& fuzz_harness::machine() noexcept
+{
+	return guest;
+}
+
+#undef GP
+#undef GC
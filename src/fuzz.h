@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "memory.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_FUZZ_H
+#define HEADER_P32_FUZZ_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// A statistics policy for fuzzing. It counts (PC, next PC) edges
+	// in a bitmap of byte counters, AFL-style, and remembers which
+	// memory pages EXCHANGE wrote so the VM can be reset cheaply.
+	class edge_coverage {
+		public:
+			static constexpr bool enabled = true;
+			static constexpr std::size_t map_size = 1 << 16;
+			
+			void record(const step_event& event, const context_data& context) noexcept;
+			
+			// Counts into counters, which must hold map_size bytes and
+			// outlive this policy, instead of the policy's own map.
+			// libFuzzer's extra counters can be used this way.
+			void attach(std::uint8_t* counters) noexcept;
+			// Returns the counters in use.
+			GP const std::uint8_t* counters() const noexcept;
+			// The number of distinct edges seen since the map was last
+			// cleared.
+			GP std::size_t edges() const noexcept;
+			// Zeroes the counters.
+			void clear_counters() noexcept;
+			
+			// Pages written since the list was last cleared. A page may
+			// be listed more than once.
+			GP std::vector<register_value>& dirty_pages() noexcept {return dirty;}
+			void mark_dirty(register_value address) noexcept;
+			
+			edge_coverage() noexcept;
+			edge_coverage(const edge_coverage& other);
+			edge_coverage& operator=(const edge_coverage& other);
+		
+		private:
+			std::array<std::uint8_t, map_size> own = {};
+			std::uint8_t* map;
+			std::vector<register_value> dirty;
+	};
+	
+	// Runs fuzzer inputs as guest programs on one VM, resetting it
+	// between inputs instead of rebuilding it. An input's first byte
+	// holds flags, and the rest is little-endian instruction words
+	// loaded at address zero.
+	class fuzz_harness {
+		public:
+			// Run in reverse after running forward.
+			static constexpr std::uint8_t flag_reverse = 1;
+			// The most words loaded from one input.
+			static constexpr std::size_t max_words = 1 << 12;
+			
+			// Each input runs for at most step_budget instructions in
+			// each direction.
+			explicit fuzz_harness(std::uint64_t step_budget = 1 << 12);
+			
+			// Resets the VM, loads an input, and runs it.
+			void run(const std::uint8_t* data, std::size_t size) noexcept;
+			// Puts the VM back to its pristine image.
+			void reset() noexcept;
+			
+			GC const basic_vm<edge_coverage>& machine() const noexcept;
+			GC basic_vm<edge_coverage>& machine() noexcept;
+		
+		private:
+			context_data image;
+			basic_vm<edge_coverage> guest;
+			std::uint64_t budget;
+	};
+}
+
+#undef GP
+#undef GC
+
+inline void metronome32::edge_coverage::record(const step_event& event, const context_data&) noexcept
+{
+	const std::uint32_t edge = event.pc * 0x9E3779B1U ^ event.next_pc;
+	map[(edge ^ (edge >> 16)) & (map_size - 1)]++;
+	
+	if (event.op == opcode::exchange) {
+		mark_dirty(event.address);
+	}
+}
+
+inline void metronome32::edge_coverage::mark_dirty(const register_value address) noexcept
+{
+	const register_value page = memory::page_of(address);
+	
+	if (dirty.empty() or dirty.back() != page) {
+		dirty.push_back(page);
+	}
+}
+
+#endif
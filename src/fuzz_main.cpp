@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// The fuzzing entry point. Built with clang's -fsanitize=fuzzer, it's a
+// libFuzzer target whose guest edges show up as extra counters. Built
+// with P32_FUZZ_STANDALONE defined, it has its own main, which replays
+// the inputs named on its command line or runs random ones and reports
+// executions per second.
+
+#include <cstddef>
+#include <cstdint>
+#include "fuzz.h"
+namespace m32 = metronome32;
+
+#if defined(__clang__) && defined(__linux__) && not defined(P32_FUZZ_STANDALONE)
+// libFuzzer treats counters in this section like its own edge counters.
+__attribute__((used, section("__libfuzzer_extra_counters")))
+static std::uint8_t guest_edges[m32::edge_coverage::map_size];
+#else
+static std::uint8_t* const guest_edges = nullptr;
+#endif
+
+static m32::fuzz_harness& harness()
+{
+	static m32::fuzz_harness instance;
+	static const bool attached = (instance.machine().statistics().attach(guest_edges), true);
+	static_cast<void>(attached);
+	
+	return instance;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+	harness().run(data, size);
+	
+	return 0;
+}
+
+#ifdef P32_FUZZ_STANDALONE
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	if (argc > 1) {
+		for (int i = 1; i < argc; i++) {
+			std::ifstream in(argv[i], std::ios::binary);
+			const std::vector<char> input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+			LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+		}
+		
+		return EXIT_SUCCESS;
+	}
+	
+	// Random inputs of 1 to 64 words.
+	constexpr std::uint64_t runs = 1000000;
+	std::vector<std::uint8_t> input(1 + 4 * 64);
+	std::uint32_t state = 2463534242U;
+	const auto start = std::chrono::steady_clock::now();
+	
+	for (std::uint64_t run = 0; run < runs; run++) {
+		for (std::uint8_t& byte : input) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			byte = state;
+		}
+		
+		LLVMFuzzerTestOneInput(input.data(), 5 + 4 * (state % 64));
+	}
+	
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << runs << " runs in " << elapsed << "s (" << runs / elapsed << " per second), "
+	          << harness().machine().statistics().edges() << " edges\n";
+	
+	return EXIT_SUCCESS;
+}
+#endif
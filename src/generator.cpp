@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "generator.h"
+#include "memory.h"
+
+namespace p32 = metronome32;
+
+using p32::context_data;
+using p32::generator_options;
+using p32::memory_value;
+using p32::register_value;
+using p32::workload;
+
+namespace {
+	// SplitMix64, so programs don't depend on the standard library's
+	// distributions.
+	class random_stream {
+		public:
+			explicit random_stream(const std::uint64_t seed) noexcept
+				: state(seed)
+			{}
+			
+			std::uint64_t next() noexcept
+			{
+				std::uint64_t z = (state += 0x9E3779B97F4A7C15);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+				
+				return z ^ (z >> 31);
+			}
+			
+			// A number in [0, bound).
+			std::uint64_t below(const std::uint64_t bound) noexcept
+			{
+				return next() % bound;
+			}
+		
+		private:
+			std::uint64_t state;
+	};
+	
+	// R1 to R23 hold data, R24 to R27 hold EXCHANGE addresses and R30
+	// counts loop iterations.
+	constexpr unsigned int data_registers = 23;
+	constexpr unsigned int first_address = 24;
+	constexpr unsigned int address_registers = 4;
+	constexpr unsigned int loop_register = 30;
+	constexpr register_value data_base = 0x10000;
+	// The largest positive ADDI immediate.
+	constexpr register_value max_step = (1 << 20) - 1;
+	// Branches skip over at most this many ALU instructions.
+	constexpr unsigned int max_skip = 4;
+	
+	unsigned int data_register(random_stream& random) noexcept
+	{
+		return 1 + random.below(data_registers);
+	}
+	
+	// Two different data registers.
+	std::pair<unsigned int, unsigned int> register_pair(random_stream& random) noexcept
+	{
+		const unsigned int rsd = data_register(random);
+		const unsigned int rs = 1 + (rsd + random.below(data_registers - 1)) % data_registers;
+		
+		return {rsd, rs};
+	}
+	
+	register_value immediate(random_stream& random) noexcept
+	{
+		return static_cast<register_value>(random.below(1 << 16)) - (1 << 15);
+	}
+	
+	memory_value alu(random_stream& random)
+	{
+		const auto regs = register_pair(random);
+		const unsigned int amount = random.below(32);
+		
+		switch (random.below(10)) {
+			case 0: return p32::new_add(regs.first, regs.second);
+			case 1: return p32::new_addi(regs.first, immediate(random));
+			case 2: return p32::new_sub(regs.first, regs.second);
+			case 3: return p32::new_xor(regs.first, regs.second);
+			case 4: return p32::new_xori(regs.first, immediate(random));
+			case 5: return p32::new_neg(regs.first, regs.second);
+			case 6: return p32::new_rl(regs.first, amount);
+			case 7: return p32::new_rlv(regs.first, regs.second);
+			case 8: return p32::new_rr(regs.first, amount);
+			default: return p32::new_rrv(regs.first, regs.second);
+		}
+	}
+	
+	memory_value garbage(random_stream& random)
+	{
+		const auto regs = register_pair(random);
+		const unsigned int amount = random.below(32);
+		
+		switch (random.below(12)) {
+			case 0: return p32::new_and(regs.first, regs.second);
+			case 1: return p32::new_andi(regs.first, immediate(random));
+			case 2: return p32::new_nor(regs.first, regs.second);
+			case 3: return p32::new_ori(regs.first, immediate(random));
+			case 4: return p32::new_slt(regs.first, regs.second);
+			case 5: return p32::new_slti(regs.first, immediate(random));
+			case 6: return p32::new_sll(regs.first, amount);
+			case 7: return p32::new_sllv(regs.first, regs.second);
+			case 8: return p32::new_sra(regs.first, amount);
+			case 9: return p32::new_srav(regs.first, regs.second);
+			case 10: return p32::new_srl(regs.first, amount);
+			default: return p32::new_srlv(regs.first, regs.second);
+		}
+	}
+	
+	// A branch with offset to the CF it skips to.
+	memory_value branch(random_stream& random, const register_value offset)
+	{
+		const auto regs = register_pair(random);
+		
+		switch (random.below(6)) {
+			case 0: return p32::new_beq(regs.first, regs.second, offset);
+			case 1: return p32::new_blne(regs.first, regs.second, offset);
+			case 2: return p32::new_bgez(regs.first, offset);
+			case 3: return p32::new_bgtz(regs.first, offset);
+			case 4: return p32::new_blez(regs.first, offset);
+			default: return p32::new_bltz(regs.first, offset);
+		}
+	}
+}
+
+workload p32::generate_workload(const generator_options& options)
+{
+	random_stream random(options.seed);
+	const std::uint64_t total_weight = std::max<std::uint64_t>(
+		1,
+		std::uint64_t(options.alu_weight) + options.garbage_weight + options.exchange_weight + options.branch_weight
+	);
+	const register_value span = std::min(std::max<register_value>(options.memory_words / address_registers, 1), max_step);
+	std::vector<memory_value> body;
+	// How far each address register has moved, to put it back at the
+	// end of the body so every iteration touches the same words.
+	std::vector<register_value> moved(address_registers, 0);
+	// Instructions that branches can skip, about half of which run.
+	std::uint64_t skippable = 0;
+	
+	for (unsigned int item = 0; item < options.body_items; item++) {
+		std::uint64_t pick = random.below(total_weight);
+		
+		if (pick < options.alu_weight) {
+			body.push_back(alu(random));
+		} else if ((pick -= options.alu_weight) < options.garbage_weight) {
+			body.push_back(garbage(random));
+		} else if ((pick -= options.garbage_weight) < options.exchange_weight) {
+			const unsigned int which = random.below(address_registers);
+			const register_value step = random.below(span);
+			body.push_back(p32::new_addi(first_address + which, step));
+			body.push_back(p32::new_exchange(data_register(random), first_address + which));
+			moved[which] += step;
+		} else {
+			const unsigned int skip = 1 + random.below(max_skip);
+			body.push_back(branch(random, skip + 1));
+			
+			for (unsigned int i = 0; i < skip; i++) {
+				body.push_back(alu(random));
+			}
+			
+			skippable += skip + 1;
+			
+			body.push_back(p32::new_cf());
+		}
+	}
+	
+	for (unsigned int i = 0; i < address_registers; i++) {
+		while (moved[i] != 0) {
+			const register_value chunk = std::min(moved[i], max_step);
+			body.push_back(p32::new_addi(first_address + i, -chunk));
+			moved[i] -= chunk;
+		}
+	}
+	
+	// The loop: CF, the body, then count down and branch back.
+	std::vector<memory_value> program;
+	program.push_back(p32::new_cf());
+	program.insert(program.end(), body.begin(), body.end());
+	program.push_back(p32::new_addi(loop_register, -1));
+	const register_value back = -static_cast<register_value>(program.size());
+	program.push_back(p32::new_bgtz(loop_register, back));
+	
+	const std::uint64_t per_iteration = program.size() - skippable / 2;
+	const std::uint64_t iterations = std::max<std::uint64_t>(1, options.instructions / per_iteration);
+	workload w{
+		"generated-" + std::to_string(options.seed),
+		std::to_string(body.size()) + " instruction body run " + std::to_string(iterations) + " times",
+		context_data(),
+		static_cast<register_value>(program.size()),
+		[](const context_data&) {return true;},
+	};
+	
+	for (register_value i = 0; i < program.size(); i++) {
+		w.initial.sys_mem[i] = program[i];
+	}
+	
+	for (unsigned int i = 1; i <= data_registers; i++) {
+		w.initial.registers[i] = random.next();
+	}
+	
+	for (unsigned int i = 0; i < address_registers; i++) {
+		w.initial.registers[first_address + i] = data_base + i * span;
+	}
+	
+	w.initial.registers[loop_register] = static_cast<register_value>(std::min<std::uint64_t>(iterations, 0x7FFFFFFF));
+	
+	return w;
+}
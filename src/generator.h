@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include "corpus.h"
+
+#ifndef HEADER_P32_GENERATOR_H
+#define HEADER_P32_GENERATOR_H
+
+namespace metronome32 {
+	// What a generated program should look like. The weights are
+	// relative proportions of the items making up the loop body.
+	struct generator_options {
+		// Programs with the same options and seed are identical.
+		std::uint64_t seed = 1;
+		// Roughly how many instructions a forward run executes.
+		std::uint64_t instructions = 1000000;
+		// How many items the loop body holds.
+		unsigned int body_items = 256;
+		// Instructions that leave no garbage: ADD, ADDI, SUB, XOR, XORI,
+		// NEG and the rotates.
+		unsigned int alu_weight = 50;
+		// Instructions that push onto the datapath stack: AND, ANDI,
+		// NOR, ORI, SLT, SLTI and the shifts.
+		unsigned int garbage_weight = 20;
+		// EXCHANGEs with memory.
+		unsigned int exchange_weight = 10;
+		// Conditional branches over a short run of ALU instructions.
+		unsigned int branch_weight = 20;
+		// Roughly how many distinct words EXCHANGE can touch, up to
+		// about four million.
+		register_value memory_words = 4096;
+	};
+	
+	// Generates a valid program: a loop around a random body, every
+	// branch target a CF, and no R-type instruction with RS == RSD. It
+	// starts at 0 and finishes at end. The loop count is chosen from
+	// options.instructions, so histories can grow as large as memory
+	// allows while the program itself stays small. Its check always
+	// passes, since nothing predicts the result.
+	workload generate_workload(const generator_options& options);
+}
+
+#endif
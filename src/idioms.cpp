@@ -0,0 +1,292 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "cfg.h"
+#include "idioms.h"
+#include "vm.h"
+
+namespace p32 = metronome32;
+
+using p32::basic_block;
+using p32::cfg_edge;
+using p32::context_data;
+using p32::counted_loop;
+using p32::edge_kind;
+using p32::loop_idioms;
+using p32::loop_update;
+using p32::opcode;
+using p32::pc_garbage_stack_t;
+using p32::predecoded_word;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::uint8_t loop_update::no_source;
+
+// Returns the word at address in image, split.
+static predecoded_word word_at(const p32::system_memory_t& image, const register_value address)
+{
+	return p32::predecode(p32::memory::read_word(image, address));
+}
+
+// Returns whether a branch can end a counted_loop.
+GC static bool tests_sign(const opcode op) noexcept
+{
+	return op == opcode::bgez or op == opcode::bgtz or op == opcode::blez or op == opcode::bltz;
+}
+
+// Returns whether a branch ending a counted_loop is taken for a value
+// of its tested register.
+GC static bool goes_back(const opcode test, const std::int64_t value) noexcept
+{
+	switch (test) {
+		case opcode::bgtz: return value > 0;
+		case opcode::bgez: return value >= 0;
+		case opcode::bltz: return value < 0;
+		default: return value <= 0;
+	}
+}
+
+// Reads a word of a loop body into update, or returns false if it
+// doesn't add a constant or another register.
+static bool read_update(const predecoded_word& word, loop_update& update) noexcept
+{
+	switch (word.op) {
+		case opcode::add: case opcode::sub:
+			update.target = word.args.r.rsd.to_ulong();
+			update.source = word.args.r.rs.to_ulong();
+			update.subtracts = word.op == opcode::sub;
+			update.constant = 0;
+			
+			return update.target != update.source;
+		case opcode::addi:
+			update.target = word.args.i.rsd.to_ulong();
+			update.source = loop_update::no_source;
+			update.subtracts = false;
+			update.constant = p32::immediate(word);
+			
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Gives access to the deque under a PC stack, which std::stack only
+// shows to classes derived from it.
+struct stack_view : pc_garbage_stack_t {
+	GP static const container_type& of(const pc_garbage_stack_t& stack) noexcept
+	{
+		return stack.*&stack_view::c;
+	}
+};
+
+loop_idioms::loop_idioms(const p32::system_memory_t& image)
+{
+	const p32::control_flow_graph graph(image);
+	const std::vector<basic_block>& blocks = graph.blocks();
+	
+	for (const cfg_edge& edge : graph.edges()) {
+		// The branch of a loop of one block lands back on the block.
+		if (edge.kind != edge_kind::branch or edge.to != edge.from) {
+			continue;
+		}
+		
+		const basic_block& block = blocks[edge.from];
+		const register_value branch = block.start + block.size - 1;
+		const predecoded_word last = word_at(image, branch);
+		
+		if (not tests_sign(last.op)) {
+			continue;
+		}
+		
+		counted_loop loop = {block.start - 1, branch, last.op, std::uint8_t(last.args.b.rb.to_ulong()), {}};
+		std::array<bool, 32> written = {};
+		bool linear = true;
+		
+		for (register_value address = block.start; linear and address != branch; address++) {
+			loop_update update;
+			linear = read_update(word_at(image, address), update);
+			
+			if (linear) {
+				written[update.target] = true;
+				loop.body.push_back(update);
+			}
+		}
+		
+		// What a pass adds must be the same every pass.
+		for (const loop_update& update : loop.body) {
+			if (update.source != loop_update::no_source and written[update.source]) {
+				linear = false;
+			}
+		}
+		
+		if (linear and written[loop.tested]) {
+			found.push_back(std::move(loop));
+		}
+	}
+	
+	std::sort(found.begin(), found.end(), [](const counted_loop& a, const counted_loop& b) {
+		return a.head < b.head;
+	});
+}
+
+GP const counted_loop* loop_idioms::at(const register_value address, const bool reversing) const noexcept
+{
+	// The last loop whose head is before address.
+	auto loop = std::lower_bound(found.begin(), found.end(), address, [](const counted_loop& l, const register_value a) {
+		return l.head < a;
+	});
+	
+	if (loop == found.begin()) {
+		return nullptr;
+	}
+	
+	--loop;
+	
+	if (reversing) {
+		return address == loop->branch or address == loop->branch + 1 ? &*loop : nullptr;
+	}
+	
+	return address == loop->head + 1 ? &*loop : nullptr;
+}
+
+std::uint64_t loop_idioms::run(const counted_loop& loop, context_data& context, const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	// The counter is in this range everywhere in the loop but on the
+	// way out.
+	if (stop_at - (loop.head + 1) <= loop.branch - (loop.head + 1)) {
+		return 0;
+	}
+	
+	p32::register_context_t& registers = context.registers;
+	const std::uint64_t words = loop.body.size() + 1;
+	// What a pass adds to each register.
+	std::array<register_value, 32> step = {};
+	
+	for (const loop_update& update : loop.body) {
+		const register_value amount = update.source == loop_update::no_source ? update.constant : registers[update.source];
+		step[update.target] += update.subtracts ? 0 - amount : amount;
+	}
+	
+	if (context.reversing) {
+		// Every pass but the first left the branch's address on top of
+		// whatever entered the loop, which the CF pops last.
+		const auto& entries = stack_view::of(context.pc_stack);
+		auto entry = entries.rbegin();
+		
+		while (entry != entries.rend() and *entry == loop.branch) {
+			++entry;
+		}
+		
+		if (entry == entries.rend()) {
+			return 0;
+		}
+		
+		const std::uint64_t passes = std::uint64_t(entry - entries.rbegin()) + 1;
+		// Going back over the branch itself, if it hasn't been.
+		const std::uint64_t over = context.counter == loop.branch + 1 ? 1 : 0;
+		
+		if (passes > (max_steps - over) / words) {
+			return 0;
+		}
+		
+		for (std::size_t i = 0; i < step.size(); i++) {
+			registers[i] -= register_value(passes) * step[i];
+		}
+		
+		for (std::uint64_t i = 1; i < passes; i++) {
+			context.pc_stack.pop();
+		}
+		
+		context.counter = context.pc_stack.top();
+		context.pc_stack.pop();
+		
+		return over + passes * words;
+	}
+	
+	// The tested register after the first pass, and what each pass
+	// after it adds, which must bring it to the way out before it
+	// wraps.
+	const std::int64_t first = std::int32_t(registers[loop.tested] + step[loop.tested]);
+	const std::int64_t change = std::int32_t(step[loop.tested]);
+	std::uint64_t passes = 1;
+	
+	if (goes_back(loop.test, first)) {
+		const bool falling = loop.test == opcode::bgtz or loop.test == opcode::bgez;
+		
+		if (falling ? change >= 0 : change <= 0) {
+			return 0;
+		}
+		
+		// The passes until it crosses zero, or reaches it when zero
+		// still goes back.
+		switch (loop.test) {
+			case opcode::bgtz: passes += (first - change - 1) / -change; break;
+			case opcode::bgez: passes += first / -change + 1; break;
+			case opcode::bltz: passes += (change - first - 1) / change; break;
+			default: passes += -first / change + 1; break;
+		}
+	}
+	
+	if (passes > max_steps / words) {
+		return 0;
+	}
+	
+	for (std::size_t i = 0; i < step.size(); i++) {
+		registers[i] += register_value(passes) * step[i];
+	}
+	
+	for (std::uint64_t i = 1; i < passes; i++) {
+		context.pc_stack.push(loop.branch);
+	}
+	
+	context.counter = loop.branch + 1;
+	
+	return passes * words;
+}
+
+void loop_idioms::wrote(const register_value address) noexcept
+{
+	const register_value number = p32::memory::page_of(address);
+	
+	found.erase(std::remove_if(found.begin(), found.end(), [number](const counted_loop& loop) {
+		return p32::memory::page_of(loop.head) <= number and number <= p32::memory::page_of(loop.branch);
+	}), found.end());
+}
+
+void loop_idioms::clear() noexcept
+{
+	found.clear();
+}
+
+GP std::size_t loop_idioms::loops() const noexcept
+{
+	return found.size();
+}
+
+#undef GP
+#undef GC
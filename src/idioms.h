@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "instruction.h"
+#include "memory.h"
+#include "predecode.h"
+
+#ifndef HEADER_P32_IDIOMS_H
+#define HEADER_P32_IDIOMS_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	struct context_data;
+	
+	// A word of a counted_loop's body, adding a constant or a register
+	// the loop never writes to another register.
+	struct loop_update {
+		static constexpr std::uint8_t no_source = UINT8_MAX;
+		
+		std::uint8_t target;
+		// The register added, or no_source to add constant.
+		std::uint8_t source;
+		bool subtracts;
+		register_value constant;
+	};
+	
+	// A loop of one basic block: a CF at head, a body of ADD, SUB and
+	// ADDI words, and a BGEZ, BGTZ, BLEZ or BLTZ at branch that goes
+	// back to head. Every pass adds the same amount to each register,
+	// so any number of passes can be run at once. This is the shape of
+	// the repeated additions and subtractions that multiply and divide
+	// in a guest, which has no instruction for either.
+	struct counted_loop {
+		register_value head;
+		register_value branch;
+		opcode test;
+		std::uint8_t tested;
+		std::vector<loop_update> body;
+	};
+	
+	// The counted loops in a program image, found from its control flow
+	// graph. A loop is run in closed form: each register gets what its
+	// passes would have added, and the PC stack gets the address of
+	// the branch once for every pass after the first, exactly as if it
+	// had been stepped, so it reverses the same way. None of its words
+	// leave datapath garbage. Like predecoded_code, every write to a
+	// page must be reported with wrote().
+	class loop_idioms {
+		public:
+			loop_idioms() noexcept = default;
+			explicit loop_idioms(const system_memory_t& image);
+			
+			// Returns the loop a context with its counter at address
+			// would run next, or nullptr. Going forward, that is a loop
+			// whose body starts at address. In reverse, the counter is
+			// after its branch or, between passes, at it.
+			GP const counted_loop* at(register_value address, bool reversing) const noexcept;
+			// Runs loop on a context whose counter at() found it at,
+			// until it leaves the loop, and returns how many
+			// instructions that retired. Returns 0 and leaves the
+			// context alone when it would take more than max_steps,
+			// pass stop_at, not end before its tested register wraps,
+			// or empty the PC stack, leaving stepping to find out what
+			// happens. The caller counts what retired and updates the
+			// peaks.
+			static std::uint64_t run(const counted_loop& loop, context_data& context, std::uint64_t max_steps, register_value stop_at) noexcept;
+			
+			// Drops the loops with a word on the page holding address,
+			// which has been written.
+			void wrote(register_value address) noexcept;
+			void clear() noexcept;
+			// The number of loops found and still held.
+			GP std::size_t loops() const noexcept;
+		
+		private:
+			// In order of head, which never overlap.
+			std::vector<counted_loop> found;
+	};
+}
+
+#undef GP
+
+#endif
@@ -97,6 +97,7 @@ SCULL itype_op_xori     = 0b011110;
 */
 
 #define GP [[gnu::pure]]
+#define GC [[gnu::const]]
 
 // Changes a bitset's size, truncating if it's smaller and optionally sign-extending.
 template <size_t N, size_t M>
@@ -217,6 +218,100 @@ GP instruction p32::type_to_instr(const itype& ii) noexcept
 	return instr;
 }
 
+/*
+	Decodes an instruction into its mnemonic
+*/
+
+GP p32::opcode p32::instr_to_opcode(const inst& instr) noexcept
+{
+	const unsigned long word = instr.to_ulong();
+	const unsigned long op = word >> 26;
+	const unsigned long upper = (word >> 21) & 0b11111;
+	const unsigned long lower = (word >> 16) & 0b11111;
+	const unsigned long shrot = (word >> 11) & 0b11111;
+	const unsigned long func = word & 0b11111111111;
+	const unsigned long offset = word & 0xFFFF;
+	const unsigned long target = word & 0x3FFFFFF;
+	
+	switch (op) {
+		case rtype_op_special:
+			switch (func) {
+				case rtype_func_add: return shrot == 0 ? opcode::add : opcode::nai;
+				case rtype_func_and: return shrot == 0 ? opcode::and_ : opcode::nai;
+				case rtype_func_nor: return shrot == 0 ? opcode::nor : opcode::nai;
+				case rtype_func_neg: return shrot == 0 ? opcode::neg : opcode::nai;
+				// is_or() compares against the NEG function code,
+				// so an OR encoding is never recognized.
+				case rtype_func_or: return opcode::nai;
+				case rtype_func_rl: return lower == 0 ? opcode::rl : opcode::nai;
+				case rtype_func_rlv: return shrot == 0 ? opcode::rlv : opcode::nai;
+				case rtype_func_rr: return lower == 0 ? opcode::rr : opcode::nai;
+				case rtype_func_rrv: return shrot == 0 ? opcode::rrv : opcode::nai;
+				case rtype_func_sll: return lower == 0 ? opcode::sll : opcode::nai;
+				case rtype_func_sllv: return shrot == 0 ? opcode::sllv : opcode::nai;
+				case rtype_func_slt: return shrot == 0 ? opcode::slt : opcode::nai;
+				case rtype_func_sra: return lower == 0 ? opcode::sra : opcode::nai;
+				case rtype_func_srav: return shrot == 0 ? opcode::srav : opcode::nai;
+				case rtype_func_srl: return lower == 0 ? opcode::srl : opcode::nai;
+				case rtype_func_srlv: return shrot == 0 ? opcode::srlv : opcode::nai;
+				case rtype_func_sub: return shrot == 0 ? opcode::sub : opcode::nai;
+				case rtype_func_xor: return shrot == 0 ? opcode::xor_ : opcode::nai;
+				default: return opcode::nai;
+			}
+		case jtype_op_cf: return target == 0 ? opcode::cf : opcode::nai;
+		case jtype_op_j: return opcode::j;
+		case btype_op_beq: return opcode::beq;
+		case btype_op_bgez: return upper == 0 ? opcode::bgez : opcode::nai;
+		case btype_op_bgezal: return opcode::bgezal;
+		case btype_op_bgtz: return upper == 0 ? opcode::bgtz : opcode::nai;
+		case btype_op_blez: return upper == 0 ? opcode::blez : opcode::nai;
+		case btype_op_bltz: return upper == 0 ? opcode::bltz : opcode::nai;
+		case btype_op_bltzal: return opcode::bltzal;
+		case btype_op_bne: return opcode::bne;
+		case btype_op_exchange: return offset == 0 ? opcode::exchange : opcode::nai;
+		case btype_op_jal: return lower == 0 ? opcode::jal : opcode::nai;
+		case btype_op_jalr: return offset == 0 ? opcode::jalr : opcode::nai;
+		case btype_op_jr:
+			return upper == 0 and offset == 0 ? opcode::jr : opcode::nai;
+		case itype_op_addi: return opcode::addi;
+		case itype_op_andi: return opcode::andi;
+		case itype_op_ori: return opcode::ori;
+		case itype_op_slti: return opcode::slti;
+		case itype_op_xori: return opcode::xori;
+		default: return opcode::nai;
+	}
+}
+
+GC const char* p32::opcode_name(const opcode op) noexcept
+{
+	static const char* const names[opcode_count] = {
+		"add", "addi", "and", "andi", "beq", "bgez", "bgezal", "bgtz",
+		"blez", "bltz", "bltzal", "bne", "cf", "exchange", "j", "jal",
+		"jalr", "jr", "nor", "neg", "or", "ori", "rl", "rlv", "rr",
+		"rrv", "sll", "sllv", "slt", "slti", "sra", "srav", "srl",
+		"srlv", "sub", "xor", "xori", "nai",
+	};
+	
+	return names[static_cast<std::size_t>(op)];
+}
+
+bool p32::direct_target(const instruction& instr, const register_value address, register_value& target) noexcept
+{
+	switch (instr_to_opcode(instr)) {
+		case opcode::beq: case opcode::bgez: case opcode::bgezal:
+		case opcode::bgtz: case opcode::blez: case opcode::bltz:
+		case opcode::bltzal: case opcode::bne: case opcode::jal:
+			target = address + change_shape<16, 32>(instr_to_b(instr).offset, true).to_ulong();
+			return true;
+		case opcode::j:
+			target = address & 0b11111100000000000000000000000000;
+			target += change_shape<26, 32>(instr_to_j(instr).target, true).to_ulong();
+			return true;
+		default:
+			return false;
+	}
+}
+
 /*
 	Checks if an instruction refers to a specific function
 */
@@ -875,6 +970,22 @@ memory_value p32::new_jr(
 	return type_to_instr(instr).to_ullong();
 }
 
+memory_value p32::new_nor(
+	const gpregister& rsd,
+	const gpregister& rs) noexcept
+{
+	assert(rsd != rs);
+	
+	instr_type::r instr;
+	instr.op = rtype_op_special;
+	instr.rsd = rsd;
+	instr.rs = rs;
+	instr.shrot = 0;
+	instr.func = rtype_func_nor;
+	
+	return type_to_instr(instr).to_ullong();
+}
+
 memory_value p32::new_neg(
 	const gpregister& rsd,
 	const gpregister& rs) noexcept
@@ -1144,3 +1255,4 @@ memory_value p32::new_xori(
 }
 
 #undef GP
+#undef GC
@@ -22,12 +22,15 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 
 #ifndef HEADER_P32_INSTRUCTION_H
 #define HEADER_P32_INSTRUCTION_H
 
 #define GP [[gnu::pure]]
+#define GC [[gnu::const]]
 
 namespace metronome32 {
 	// The type of a register value.
@@ -72,6 +75,19 @@ namespace metronome32 {
 		};
 	}
 	
+	// Every mnemonic the VM can execute. Mnemonics that collide with
+	// C++ alternative tokens get a trailing underscore.
+	enum class opcode : std::uint8_t {
+		add, addi, and_, andi, beq, bgez, bgezal, bgtz, blez, bltz,
+		bltzal, bne, cf, exchange, j, jal, jalr, jr, nor, neg, or_,
+		ori, rl, rlv, rr, rrv, sll, sllv, slt, slti, sra, srav, srl,
+		srlv, sub, xor_, xori,
+		// Not an instruction.
+		nai,
+	};
+	// The number of distinct opcode values, including opcode::nai.
+	constexpr std::size_t opcode_count = static_cast<std::size_t>(opcode::nai) + 1;
+	
 	// Splits an instruction into a specific instruction type.
 	GP instr_type::r instr_to_r(const instruction& instr) noexcept;
 	GP instr_type::j instr_to_j(const instruction& instr) noexcept;
@@ -84,6 +100,19 @@ namespace metronome32 {
 	GP instruction type_to_instr(const instr_type::b& bi) noexcept;
 	GP instruction type_to_instr(const instr_type::i& ii) noexcept;
 	
+	// Returns the mnemonic of an instruction, or opcode::nai. It agrees
+	// with the is_* functions below, tested in the order they're listed.
+	GP opcode instr_to_opcode(const instruction& instr) noexcept;
+	// Returns the lowercase mnemonic of an opcode, such as "addi".
+	GC const char* opcode_name(opcode op) noexcept;
+	// If instr is a direct branch or jump (BEQ through BNE, J or JAL),
+	// stores the address of the word it must target when it sits at
+	// address, and returns true. Otherwise returns false.
+	bool direct_target(const instruction& instr, register_value address, register_value& target) noexcept;
+	// Returns value with its low bits bits sign-extended to the whole
+	// register.
+	GC constexpr register_value sign_extend(const register_value value, const unsigned int bits) noexcept {return (value ^ (register_value(1) << (bits - 1))) - (register_value(1) << (bits - 1));}
+	
 	// Returns whether an instruction corresponds to a given mnemonic.
 	GP bool is_add(const instr_type::r& structure) noexcept;
 	GP bool is_addi(const instr_type::i& structure) noexcept;
@@ -178,6 +207,9 @@ namespace metronome32 {
 		const gpregister& jreg) noexcept;
 	GP memory_value new_jr(
 		const gpregister& jreg) noexcept;
+	GP memory_value new_nor(
+		const gpregister& rsd,
+		const gpregister& rs) noexcept;
 	GP memory_value new_neg(
 		const gpregister& rsd,
 		const gpregister& rs) noexcept;
@@ -235,5 +267,6 @@ namespace metronome32 {
 }
 
 #undef GP
+#undef GC
 
 #endif
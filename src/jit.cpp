@@ -0,0 +1,703 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include "jit.h"
+#include "vm.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+ #include <sys/mman.h>
+ #define _JITCPP_X86_64 1
+#else
+ #define _JITCPP_X86_64 0
+#endif
+
+namespace p32 = metronome32;
+
+using p32::branch_target;
+using p32::conditional_branch;
+using p32::context_data;
+using p32::i_form;
+using p32::immediate;
+using p32::native_block;
+using p32::native_code;
+using p32::opcode;
+using p32::predecoded_word;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::size_t native_code::page_words;
+constexpr std::uint32_t native_code::min_words;
+
+// Executable memory is mapped this much at a time.
+constexpr std::size_t chunk_bytes = 64 * 1024;
+
+GP bool p32::compiles(const predecoded_word& word) noexcept
+{
+	switch (word.op) {
+		case opcode::add: case opcode::and_: case opcode::nor:
+		case opcode::or_: case opcode::rlv: case opcode::rrv:
+		case opcode::sllv: case opcode::slt: case opcode::srav:
+		case opcode::srlv: case opcode::sub: case opcode::xor_:
+			return word.args.r.rsd != word.args.r.rs;
+		case opcode::addi: case opcode::andi: case opcode::ori:
+		case opcode::slti: case opcode::xori: case opcode::neg:
+		case opcode::rl: case opcode::rr: case opcode::sll:
+		case opcode::sra: case opcode::srl:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Called from blocks for the garbage an instruction leaves.
+static void push_garbage(context_data* const context, const register_value value) noexcept
+{
+	context->dp_stack.push(value);
+}
+
+// Called from blocks for a CF or a taken branch at address.
+static void push_counter(context_data* const context, const register_value address) noexcept
+{
+	context->pc_stack.push(address);
+}
+
+// Called from reverse blocks to restore a register from garbage.
+// Leaves the context as pop_from_dpstack() does if there is none.
+static bool pop_garbage(context_data* const context, const unsigned int rsd) noexcept
+{
+	if (context->dp_stack.empty()) {
+		context->errcode = p32::context_error::dp_stack_empty;
+		context->halted = true;
+		
+		return false;
+	}
+	
+	context->registers[rsd] = context->dp_stack.top();
+	context->dp_stack.pop();
+	
+	return true;
+}
+
+// Blocks keep the context in RBP, the registers in RBX, the counter in
+// R12, the budget in R13 and how many have retired in R14. Each guest
+// register is a byte displacement from RBX.
+typedef std::vector<std::uint8_t> machine_code;
+
+static void emit(machine_code& out, std::initializer_list<std::uint8_t> bytes)
+{
+	out.insert(out.end(), bytes);
+}
+
+static void emit32(machine_code& out, const std::uint32_t value)
+{
+	for (unsigned int i = 0; i < 32; i += 8) {
+		out.push_back(static_cast<std::uint8_t>(value >> i));
+	}
+}
+
+static void emit64(machine_code& out, const std::uint64_t value)
+{
+	emit32(out, static_cast<std::uint32_t>(value));
+	emit32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+// Points the rel32 ending at from to the end of the code so far.
+static void patch(machine_code& out, const std::size_t from)
+{
+	const std::uint32_t distance = static_cast<std::uint32_t>(out.size() - from);
+	
+	for (unsigned int i = 0; i < 4; i++) {
+		out[from - 4 + i] = static_cast<std::uint8_t>(distance >> 8 * i);
+	}
+}
+
+GC static std::uint8_t guest(const std::bitset<5>& reg) noexcept
+{
+	return static_cast<std::uint8_t>(reg.to_ulong() * sizeof(register_value));
+}
+
+// The ModRM byte for [RBX + disp8], with reg or an opcode extension.
+GC static std::uint8_t at_rbx(const std::uint8_t reg) noexcept
+{
+	return static_cast<std::uint8_t>(0x43 | reg << 3);
+}
+
+static void prologue(machine_code& out)
+{
+	// push rbx; push rbp; push r12; push r13; push r14
+	emit(out, {0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56});
+	// mov rbp, rdi; mov rbx, rsi; mov r12, rdx; mov r13, rcx
+	emit(out, {0x48, 0x89, 0xFD, 0x48, 0x89, 0xF3, 0x49, 0x89, 0xD4, 0x49, 0x89, 0xCD});
+	// xor r14d, r14d
+	emit(out, {0x45, 0x31, 0xF6});
+}
+
+// Leaves the block with the counter at address and R14 retired.
+static void epilogue(machine_code& out, const register_value address)
+{
+	// mov dword [r12], address; mov rax, r14
+	emit(out, {0x41, 0xC7, 0x04, 0x24});
+	emit32(out, address);
+	emit(out, {0x4C, 0x89, 0xF0});
+	// pop r14; pop r13; pop r12; pop rbp; pop rbx; ret
+	emit(out, {0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B, 0xC3});
+}
+
+static void retire(machine_code& out, const std::uint32_t words)
+{
+	// add r14, words
+	emit(out, {0x49, 0x81, 0xC6});
+	emit32(out, words);
+}
+
+static void call(machine_code& out, const std::uintptr_t function)
+{
+	// mov rdi, rbp; mov rax, function; call rax
+	emit(out, {0x48, 0x89, 0xEF, 0x48, 0xB8});
+	emit64(out, function);
+	emit(out, {0xFF, 0xD0});
+}
+
+// Pushes a guest register as garbage.
+static void push(machine_code& out, const std::uint8_t reg)
+{
+	// mov esi, [rbx + reg]
+	emit(out, {0x8B, at_rbx(6), reg});
+	call(out, reinterpret_cast<std::uintptr_t>(&push_garbage));
+}
+
+// Pushes address onto the PC stack.
+static void push_address(machine_code& out, const register_value address)
+{
+	// mov esi, address
+	emit(out, {0xBE});
+	emit32(out, address);
+	call(out, reinterpret_cast<std::uintptr_t>(&push_counter));
+}
+
+// Pops a guest register from garbage, leaving the block with the
+// counter at address and done words retired if there was none.
+static void pop(machine_code& out, const std::uint8_t reg, const register_value address, const std::uint32_t done)
+{
+	// mov esi, index
+	emit(out, {0xBE});
+	emit32(out, reg / sizeof(register_value));
+	call(out, reinterpret_cast<std::uintptr_t>(&pop_garbage));
+	// test al, al; jnz past the exit
+	emit(out, {0x84, 0xC0, 0x0F, 0x85, 0, 0, 0, 0});
+	const std::size_t skip = out.size();
+	retire(out, done);
+	epilogue(out, address);
+	patch(out, skip);
+}
+
+// op [rbx + rsd], ecx, after loading rs into ECX.
+static void with_register(machine_code& out, const std::uint8_t op, const std::uint8_t rsd, const std::uint8_t rs)
+{
+	emit(out, {0x8B, at_rbx(1), rs, op, at_rbx(1), rsd});
+}
+
+// Group 1 op dword [rbx + rsd], imm32.
+static void with_immediate(machine_code& out, const std::uint8_t extension, const std::uint8_t rsd, const register_value imm)
+{
+	emit(out, {0x81, at_rbx(extension), rsd});
+	emit32(out, imm);
+}
+
+// Group 2 shift or rotate of [rbx + rsd] by a constant.
+static void shift(machine_code& out, const std::uint8_t extension, const std::uint8_t rsd, const unsigned long amount)
+{
+	emit(out, {0xC1, at_rbx(extension), rsd, static_cast<std::uint8_t>(amount)});
+}
+
+// Group 2 shift or rotate of [rbx + rsd] by rs, which x86 masks to
+// five bits as Pendulum does.
+static void shift_by(machine_code& out, const std::uint8_t extension, const std::uint8_t rsd, const std::uint8_t rs)
+{
+	emit(out, {0x8B, at_rbx(1), rs, 0xD3, at_rbx(extension), rsd});
+}
+
+// Sets [rbx + rsd] to whether it is less than the compared operand,
+// signed, after "cmp eax, ..." has been emitted by compare.
+template <class Compare>
+static void set_less(machine_code& out, const std::uint8_t rsd, Compare compare)
+{
+	emit(out, {0x8B, at_rbx(0), rsd});
+	compare();
+	// setl al; movzx eax, al; mov [rbx + rsd], eax
+	emit(out, {0x0F, 0x9C, 0xC0, 0x0F, 0xB6, 0xC0, 0x89, at_rbx(0), rsd});
+}
+
+// Opcode extensions of the x86 instruction groups used.
+enum extension : std::uint8_t {
+	x_add = 0, x_or = 1, x_and = 4, x_sub = 5, x_xor = 6, x_cmp = 7,
+	x_rol = 0, x_ror = 1, x_shl = 4, x_shr = 5, x_sar = 7,
+	x_not = 2, x_neg = 3,
+};
+
+// Emits an ALU word running forward.
+static void forward(machine_code& out, const predecoded_word& word)
+{
+	const bool i_type = i_form(word.op);
+	const std::uint8_t rsd = guest(i_type ? word.args.i.rsd : word.args.r.rsd);
+	const std::uint8_t rs = i_type ? 0 : guest(word.args.r.rs);
+	const unsigned long amount = i_type ? 0 : word.args.r.shrot.to_ulong();
+	
+	switch (word.op) {
+		case opcode::add: with_register(out, 0x01, rsd, rs); break;
+		case opcode::sub: with_register(out, 0x29, rsd, rs); break;
+		case opcode::xor_: with_register(out, 0x31, rsd, rs); break;
+		case opcode::addi: with_immediate(out, x_add, rsd, immediate(word)); break;
+		case opcode::xori: with_immediate(out, x_xor, rsd, immediate(word)); break;
+		case opcode::neg: emit(out, {0xF7, at_rbx(x_neg), rsd}); break;
+		case opcode::rl: shift(out, x_rol, rsd, amount); break;
+		case opcode::rr: shift(out, x_ror, rsd, amount); break;
+		case opcode::rlv: shift_by(out, x_rol, rsd, rs); break;
+		case opcode::rrv: shift_by(out, x_ror, rsd, rs); break;
+		default:
+			// Everything else leaves the old value as garbage.
+			push(out, rsd);
+			
+			switch (word.op) {
+				case opcode::and_: with_register(out, 0x21, rsd, rs); break;
+				case opcode::or_: with_register(out, 0x09, rsd, rs); break;
+				case opcode::nor:
+					with_register(out, 0x09, rsd, rs);
+					emit(out, {0xF7, at_rbx(x_not), rsd});
+					break;
+				case opcode::andi: with_immediate(out, x_and, rsd, immediate(word)); break;
+				case opcode::ori: with_immediate(out, x_or, rsd, immediate(word)); break;
+				case opcode::sll: shift(out, x_shl, rsd, amount); break;
+				case opcode::srl: shift(out, x_shr, rsd, amount); break;
+				case opcode::sra: shift(out, x_sar, rsd, amount); break;
+				case opcode::sllv: shift_by(out, x_shl, rsd, rs); break;
+				case opcode::srlv: shift_by(out, x_shr, rsd, rs); break;
+				case opcode::srav: shift_by(out, x_sar, rsd, rs); break;
+				case opcode::slt:
+					// cmp eax, [rbx + rs]
+					set_less(out, rsd, [&]() {emit(out, {0x3B, at_rbx(0), rs});});
+					break;
+				case opcode::slti:
+					// cmp eax, imm32
+					set_less(out, rsd, [&]() {emit(out, {0x3D}); emit32(out, immediate(word));});
+					break;
+				default:
+					break;
+			}
+	}
+}
+
+// Emits an ALU word running in reverse with the counter at address,
+// done words into the block.
+static void reverse(machine_code& out, const predecoded_word& word, const register_value address, const std::uint32_t done)
+{
+	const bool i_type = i_form(word.op);
+	const std::uint8_t rsd = guest(i_type ? word.args.i.rsd : word.args.r.rsd);
+	const std::uint8_t rs = i_type ? 0 : guest(word.args.r.rs);
+	const unsigned long amount = i_type ? 0 : word.args.r.shrot.to_ulong();
+	
+	switch (word.op) {
+		case opcode::add: with_register(out, 0x29, rsd, rs); break;
+		case opcode::sub: with_register(out, 0x01, rsd, rs); break;
+		case opcode::xor_: with_register(out, 0x31, rsd, rs); break;
+		case opcode::addi: with_immediate(out, x_sub, rsd, immediate(word)); break;
+		case opcode::xori: with_immediate(out, x_xor, rsd, immediate(word)); break;
+		case opcode::neg: emit(out, {0xF7, at_rbx(x_neg), rsd}); break;
+		case opcode::rl: shift(out, x_ror, rsd, amount); break;
+		case opcode::rr: shift(out, x_rol, rsd, amount); break;
+		case opcode::rlv: shift_by(out, x_ror, rsd, rs); break;
+		case opcode::rrv: shift_by(out, x_rol, rsd, rs); break;
+		default: pop(out, rsd, address, done); break;
+	}
+}
+
+// Emits a jump past the taken path of a branch unless it is taken,
+// returning where its rel32 ends.
+static std::size_t unless_taken(machine_code& out, const predecoded_word& word)
+{
+	const std::uint8_t ra = guest(word.args.b.ra);
+	const std::uint8_t rb = guest(word.args.b.rb);
+	std::uint8_t skip = 0;
+	
+	if (word.op == opcode::beq or word.op == opcode::bne) {
+		// mov eax, [rbx + ra]; cmp eax, [rbx + rb]
+		emit(out, {0x8B, at_rbx(0), ra, 0x3B, at_rbx(0), rb});
+		skip = word.op == opcode::beq ? 0x85 : 0x84;
+	} else {
+		// cmp dword [rbx + rb], 0
+		emit(out, {0x83, at_rbx(x_cmp), rb, 0x00});
+		
+		switch (word.op) {
+			case opcode::bgez: skip = 0x8C; break;
+			case opcode::bgtz: skip = 0x8E; break;
+			case opcode::blez: skip = 0x8F; break;
+			default: skip = 0x8D; break;
+		}
+	}
+	
+	// jcc rel32
+	emit(out, {0x0F, skip, 0, 0, 0, 0});
+	
+	return out.size();
+}
+
+native_code::~native_code()
+{
+	clear();
+}
+
+GC bool native_code::available() noexcept
+{
+	return _JITCPP_X86_64;
+}
+
+native_block native_code::block(predecoded_code& code, const system_memory_t& memory, const register_value address, const bool reversing, std::uint32_t& words)
+{
+	if (not available()) {
+		return nullptr;
+	}
+	
+	// A reverse block starts with the word before the counter.
+	const register_value first = reversing ? address - 1 : address;
+	const register_value number = memory::page_of(first);
+	
+	if (last == nullptr or number != last_number) {
+		std::unique_ptr<page>& held = pages[number];
+		
+		if (held == nullptr) {
+			held.reset(new page());
+		}
+		
+		last = held.get();
+		last_number = number;
+	}
+	
+	entry& slot = (reversing ? last->reverse : last->forward)[first % page_words];
+	
+	// A sealed code's blocks are compiled elsewhere and adopted, so an
+	// entry point nobody compiled there is left to the interpreter.
+	if (not slot.tried and code.sealed()) {
+		words = 0;
+		
+		return nullptr;
+	}
+	
+	if (not slot.tried) {
+		slot.tried = true;
+		compile(slot, *last, code, memory, first, reversing);
+	}
+	
+	words = slot.words;
+	
+	return slot.run;
+}
+
+void native_code::compile(entry& slot, page& held, predecoded_code& code, const system_memory_t& memory, const register_value first, const bool reversing)
+{
+	const register_value number = memory::page_of(first);
+	machine_code out;
+	std::uint32_t words = 0;
+	bool branched = false;
+	bool looping = false;
+	prologue(out);
+	const std::size_t top = out.size();
+	
+	for (; words < page_words; words++) {
+		const register_value address = reversing ? first - words : first + words;
+		
+		if (memory::page_of(address) != number) {
+			break;
+		}
+		
+		const predecoded_word& word = code.fetch(memory, address);
+		
+		if (reversing) {
+			if (not compiles(word)) {
+				break;
+			}
+			
+			reverse(out, word, address + 1, words);
+		} else if (word.op == opcode::cf) {
+			push_address(out, address);
+		} else if (compiles(word)) {
+			forward(out, word);
+		} else if (conditional_branch(word)) {
+			const register_value target = branch_target(word, address);
+			
+			// The branch's check is made now, so its target must stay
+			// on the page.
+			if (memory::page_of(target) != number or code.fetch(memory, target).op != opcode::cf) {
+				break;
+			}
+			
+			words++;
+			branched = true;
+			const std::size_t not_taken = unless_taken(out, word);
+			push_address(out, address);
+			retire(out, words);
+			
+			if (target + 1 == first) {
+				looping = true;
+				// mov rax, r14; add rax, words; cmp rax, r13; jbe top
+				emit(out, {0x4C, 0x89, 0xF0, 0x48, 0x05});
+				emit32(out, words);
+				emit(out, {0x4C, 0x39, 0xE8, 0x0F, 0x86});
+				emit32(out, static_cast<std::uint32_t>(top - (out.size() + 4)));
+			}
+			
+			epilogue(out, target + 1);
+			patch(out, not_taken);
+			retire(out, words);
+			epilogue(out, address + 1);
+			break;
+		} else {
+			break;
+		}
+	}
+	
+	// A block that loops is worth calling even when it is short.
+	if (words < (looping ? 2 : min_words)) {
+		return;
+	}
+	
+	if (not branched) {
+		retire(out, words);
+		epilogue(out, reversing ? first + 1 - words : first + words);
+	}
+	
+	const std::uint8_t* const start = place(out);
+	
+	if (start != nullptr) {
+		slot.run = reinterpret_cast<native_block>(reinterpret_cast<std::uintptr_t>(start));
+		slot.words = words;
+		held.compiled++;
+		compiled++;
+	}
+}
+
+const std::uint8_t* native_code::place(const machine_code& bytes) noexcept
+{
+#if _JITCPP_X86_64
+	if (chunks.empty() or chunks.back().size - chunks.back().used < bytes.size()) {
+		const std::size_t size = std::max(chunk_bytes, (bytes.size() + 4095) / 4096 * 4096);
+		void* const base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		
+		if (base == MAP_FAILED) {
+			return nullptr;
+		}
+		
+		chunks.push_back({static_cast<std::uint8_t*>(base), size, 0, 0});
+	} else if (mprotect(chunks.back().base, chunks.back().size, PROT_READ | PROT_WRITE) != 0) {
+		return nullptr;
+	}
+	
+	// The chunk is never writable and executable at once.
+	chunk& into = chunks.back();
+	std::uint8_t* const start = into.base + into.used;
+	std::memcpy(start, bytes.data(), bytes.size());
+	into.used += (bytes.size() + 15) / 16 * 16;
+	
+	if (mprotect(into.base, into.size, PROT_READ | PROT_EXEC) != 0) {
+		return nullptr;
+	}
+	
+	into.live++;
+	
+	return start;
+#else
+	static_cast<void>(bytes);
+	
+	return nullptr;
+#endif
+}
+
+void native_code::wrote(const register_value address) noexcept
+{
+	const register_value number = memory::page_of(address);
+	const auto held = pages.find(number);
+	
+	if (held == pages.end()) {
+		return;
+	}
+	
+	if (last == held->second.get()) {
+		last = nullptr;
+	}
+	
+	drop(*held->second);
+	pages.erase(held);
+}
+
+void native_code::drop(const page& held) noexcept
+{
+	compiled -= held.compiled;
+	
+	for (const std::array<entry, page_words>* const direction : {&held.forward, &held.reverse}) {
+		for (const entry& slot : *direction) {
+			if (slot.run == nullptr) {
+				continue;
+			}
+			
+			const std::uint8_t* const start = reinterpret_cast<const std::uint8_t*>(reinterpret_cast<std::uintptr_t>(slot.run));
+			const auto home = std::find_if(chunks.begin(), chunks.end(), [start](const chunk& mapped) {
+				return start >= mapped.base and start < mapped.base + mapped.used;
+			});
+			
+			if (home == chunks.end() or --home->live > 0) {
+				continue;
+			}
+			
+			if (home + 1 == chunks.end()) {
+				home->used = 0;
+			} else {
+#if _JITCPP_X86_64
+				munmap(home->base, home->size);
+#endif
+				chunks.erase(home);
+			}
+		}
+	}
+}
+
+void native_code::adopt(native_code& other)
+{
+	for (auto& held : other.pages) {
+		std::unique_ptr<page>& slot = pages[held.first];
+		
+		compiled += held.second->compiled;
+		
+		if (slot != nullptr) {
+			drop(*slot);
+		}
+		
+		slot = std::move(held.second);
+	}
+	
+	// The other code's chunks go in front, so the one being filled
+	// here stays last.
+	chunks.insert(chunks.begin(), other.chunks.begin(), other.chunks.end());
+	last = nullptr;
+	other.pages.clear();
+	other.chunks.clear();
+	other.last = nullptr;
+	other.compiled = 0;
+}
+
+void native_code::pack() noexcept
+{
+#if _JITCPP_X86_64
+	std::size_t total = 0;
+	
+	for (const chunk& mapped : chunks) {
+		total += mapped.used;
+	}
+	
+	const std::size_t size = (total + 4095) / 4096 * 4096;
+	
+	if (total == 0 or (chunks.size() == 1 and chunks[0].size == size)) {
+		return;
+	}
+	
+	void* const base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	
+	if (base == MAP_FAILED) {
+		return;
+	}
+	
+	chunk packed = {static_cast<std::uint8_t*>(base), size, 0, 0};
+	
+	for (const chunk& mapped : chunks) {
+		std::memcpy(packed.base + packed.used, mapped.base, mapped.used);
+		packed.used += mapped.used;
+	}
+	
+	if (mprotect(packed.base, packed.size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(packed.base, packed.size);
+		
+		return;
+	}
+	
+	// Each chunk's blocks keep their offsets, moved past the chunks
+	// before it.
+	std::size_t offset = 0;
+	
+	for (const chunk& mapped : chunks) {
+		for (auto& held : pages) {
+			for (std::array<entry, page_words>* const direction : {&held.second->forward, &held.second->reverse}) {
+				for (entry& slot : *direction) {
+					const std::uint8_t* const start = reinterpret_cast<const std::uint8_t*>(reinterpret_cast<std::uintptr_t>(slot.run));
+					
+					if (slot.run != nullptr and start >= mapped.base and start < mapped.base + mapped.used) {
+						slot.run = reinterpret_cast<native_block>(reinterpret_cast<std::uintptr_t>(packed.base + offset + (start - mapped.base)));
+					}
+				}
+			}
+		}
+		
+		offset += mapped.used;
+		packed.live += mapped.live;
+		munmap(mapped.base, mapped.size);
+	}
+	
+	chunks.assign(1, packed);
+#endif
+}
+
+void native_code::clear() noexcept
+{
+	pages.clear();
+	last = nullptr;
+	compiled = 0;
+	
+#if _JITCPP_X86_64
+	for (const chunk& mapped : chunks) {
+		munmap(mapped.base, mapped.size);
+	}
+#endif
+	
+	chunks.clear();
+}
+
+GP std::size_t native_code::blocks() const noexcept
+{
+	return compiled;
+}
+
+GP std::size_t native_code::mapped() const noexcept
+{
+	std::size_t bytes = 0;
+	
+	for (const chunk& mapped : chunks) {
+		bytes += mapped.size;
+	}
+	
+	return bytes;
+}
+
+#undef GP
+#undef GC
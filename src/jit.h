@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "instruction.h"
+#include "memory.h"
+#include "predecode.h"
+
+#ifndef HEADER_P32_JIT_H
+#define HEADER_P32_JIT_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	struct context_data;
+	
+	// A run of words compiled to host code. Runs them on a context
+	// whose registers and counter are given, leaving the counter after
+	// the last word run, and returns how many retired. A forward block
+	// whose branch lands back on its first word runs again while budget
+	// allows. Only a reverse block can stop early, on an empty datapath
+	// stack, which halts the context.
+	typedef std::uint64_t (*native_block)(context_data* context, register_value* registers, register_value* counter, std::uint64_t budget);
+	
+	// Returns whether a word can be compiled into a native_block in both
+	// directions: an ALU instruction, with different registers if it
+	// is R-type.
+	GP bool compiles(const predecoded_word& word) noexcept;
+	
+	// Blocks of x86-64 code compiled from runs of words, a forward and a
+	// reverse block for each address they are entered at. A reverse
+	// block is a run of ALU words. A forward block may also hold CFs and
+	// end with a conditional branch to a CF on its page, which is checked
+	// while compiling. A block keeps the registers in the context,
+	// pushes and pops garbage on the context's stacks, and never leaves
+	// the page its words are on, so like predecoded_code, every write to
+	// a page must be reported with wrote(). Code is written while mapped
+	// read-write and only run once remapped read-execute. On other hosts
+	// no block is ever compiled.
+	class native_code {
+		public:
+			static constexpr std::size_t page_words = std::size_t(1) << memory::page_bits;
+			// The fewest words worth compiling into a block that doesn't
+			// loop. Shorter ones run faster as fused pairs.
+			static constexpr std::uint32_t min_words = 4;
+			
+			native_code() noexcept = default;
+			native_code(const native_code&) = delete;
+			native_code& operator=(const native_code&) = delete;
+			~native_code();
+			
+			// Returns whether blocks can be compiled on this host.
+			GC static bool available() noexcept;
+			
+			// Returns the block starting at address, or with the counter
+			// at address in reverse, compiling it from the words in code
+			// the first time, and sets words to how many it runs before
+			// it could loop. Returns nullptr when too few words there
+			// compile. When code is sealed, nothing is compiled here,
+			// and only blocks already compiled or adopted are found.
+			native_block block(predecoded_code& code, const system_memory_t& memory, register_value address, bool reversing, std::uint32_t& words);
+			
+			// Drops the blocks on the page holding address, which has
+			// been written, unmapping code no block runs anymore.
+			void wrote(register_value address) noexcept;
+			// Moves every block compiled by other into this one, in place
+			// of any on the same pages, along with the code they run.
+			void adopt(native_code& other);
+			// Moves every block's code into one mapping just big enough
+			// for it, so code compiled to be adopted elsewhere holds no
+			// more memory than it needs.
+			void pack() noexcept;
+			// Drops every block and unmaps their code.
+			void clear() noexcept;
+			// The number of blocks compiled and still held.
+			GP std::size_t blocks() const noexcept;
+			// The bytes of executable memory mapped for them.
+			GP std::size_t mapped() const noexcept;
+		
+		private:
+			struct entry {
+				native_block run = nullptr;
+				std::uint32_t words = 0;
+				bool tried = false;
+			};
+			
+			// The forward and reverse blocks whose first word is on a
+			// page, by that word's offset in it.
+			struct page {
+				std::array<entry, page_words> forward;
+				std::array<entry, page_words> reverse;
+				std::size_t compiled = 0;
+			};
+			
+			// A mapping that blocks are copied into, one after another,
+			// and how many of them are still held.
+			struct chunk {
+				std::uint8_t* base;
+				std::size_t size;
+				std::size_t used;
+				std::size_t live;
+			};
+			
+			std::unordered_map<register_value, std::unique_ptr<page>> pages;
+			page* last = nullptr;
+			register_value last_number = 0;
+			std::vector<chunk> chunks;
+			std::size_t compiled = 0;
+			
+			// Compiles the block for a slot on a page, or leaves it empty.
+			void compile(entry& slot, page& held, predecoded_code& code, const system_memory_t& memory, register_value address, bool reversing);
+			// Copies code into executable memory, returning where it
+			// starts, or nullptr if it couldn't be mapped.
+			const std::uint8_t* place(const std::vector<std::uint8_t>& bytes) noexcept;
+			// Forgets a page's blocks, unmapping each chunk left without
+			// any. The last chunk is kept to be filled again instead.
+			void drop(const page& held) noexcept;
+	};
+}
+
+#undef GP
+#undef GC
+
+#endif
@@ -45,3 +45,14 @@ void p32mem::write_word(mem_t& memory, const reg_val& address, const mem_val& va
 	memory.erase(address);
 	memory[address] = val;
 }
+
+// Copy whole pages of memory back from an image.
+void p32mem::restore_pages(mem_t& memory, const mem_t& image, const std::vector<reg_val>& pages) noexcept
+{
+	for (const reg_val page : pages) {
+		const reg_val first = page << page_bits;
+		const reg_val last = first + ((reg_val(1) << page_bits) - 1);
+		memory.erase(memory.lower_bound(first), memory.upper_bound(last));
+		memory.insert(image.lower_bound(first), image.upper_bound(last));
+	}
+}
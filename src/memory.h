@@ -21,15 +21,25 @@ OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
 WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <functional>
 #include <map>
+#include <utility>
+#include <vector>
 #include "instruction.h"
+#include "arena.h"
 
 #ifndef HEADER_P32_MEMORY_H
 #define HEADER_P32_MEMORY_H
 
 namespace metronome32 {
-	// The container for all of system memory.
-	typedef std::map<register_value, memory_value> system_memory_t;
+	// The container for all of system memory. Its nodes come from the
+	// heap unless it is given an arena.
+	typedef std::map<
+		register_value,
+		memory_value,
+		std::less<register_value>,
+		arena_allocator<std::pair<const register_value, memory_value>>
+	> system_memory_t;
 	// The default value of anything in memory.
 	constexpr memory_value memory_default = 0;
 	
@@ -39,6 +49,15 @@ namespace metronome32 {
 		
 		memory_value read_word(const mem_t& memory, const register_value& address) noexcept;
 		void write_word(mem_t& memory, const register_value& address, const memory_value& val) noexcept;
+		
+		// Memory is tracked for fast resets in pages of 2^page_bits
+		// words.
+		constexpr unsigned int page_bits = 8;
+		// Returns the page holding an address.
+		constexpr register_value page_of(const register_value address) noexcept {return address >> page_bits;}
+		// Makes the given pages of memory match image, leaving every
+		// other page alone.
+		void restore_pages(mem_t& memory, const mem_t& image, const std::vector<register_value>& pages) noexcept;
 	}
 }
 
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <vector>
+#include "pool.h"
+namespace p32 = metronome32;
+
+using p32::vm_pool;
+
+#define GP [[gnu::pure]]
+
+vm_pool::slot::slot(const std::size_t arena_chunk_bytes)
+	: storage(arena_chunk_bytes), machine(storage)
+{}
+
+vm_pool::vm_pool(const std::size_t prewarmed, const std::size_t arena_chunk_bytes)
+	: chunk_bytes(arena_chunk_bytes)
+{
+	slots.reserve(prewarmed);
+	free_vms.reserve(prewarmed);
+	
+	for (std::size_t i = 0; i < prewarmed; i++) {
+		grow();
+	}
+}
+
+void vm_pool::grow()
+{
+	slots.emplace_back(new slot(chunk_bytes));
+	free_vms.push_back(&slots.back()->machine);
+}
+
+p32::vm& vm_pool::acquire() noexcept
+{
+	if (free_vms.empty()) {
+		grow();
+	}
+	
+	p32::vm& machine = *free_vms.back();
+	free_vms.pop_back();
+	machine.set_quota(quota);
+	
+	return machine;
+}
+
+p32::vm& vm_pool::acquire(const p32::memory_value* const program, const std::size_t count, const p32::register_value start_pc) noexcept
+{
+	p32::vm& machine = acquire();
+	
+	// Released VMs already start at zero.
+	if (start_pc != 0) {
+		machine.recycle(start_pc);
+	}
+	
+	machine.load_words(program, count);
+	
+	return machine;
+}
+
+void vm_pool::release(p32::vm& machine) noexcept
+{
+	// A job may have added contexts and switched between them, but
+	// the next one starts with only the first.
+	machine.keep_first_context();
+	machine.recycle();
+	free_vms.push_back(&machine);
+}
+
+void vm_pool::set_quota(const p32::resource_quota& limits) noexcept
+{
+	quota = limits;
+}
+
+GP std::size_t vm_pool::size() const noexcept
+{
+	return slots.size();
+}
+
+GP std::size_t vm_pool::idle() const noexcept
+{
+	return free_vms.size();
+}
+
+#undef GP
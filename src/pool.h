@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "arena.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_POOL_H
+#define HEADER_P32_POOL_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	// Hands out VMs for short jobs and takes them back for reuse. Every
+	// VM keeps its context in its own arena, so releasing one empties
+	// it in bulk while the arena keeps its memory, and the next
+	// program is loaded into that memory in place. A pool isn't
+	// thread-safe; give each worker thread its own.
+	class vm_pool {
+		public:
+			// Returns an idle VM with an empty context, building a new
+			// one if every VM is out.
+			vm& acquire() noexcept;
+			// The same, with count words of a program loaded at address
+			// zero and the counter set to start_pc.
+			vm& acquire(const memory_value* program, std::size_t count, register_value start_pc = 0) noexcept;
+			// Empties a VM acquired from this pool, dropping every
+			// context but handle 0, and makes it idle again. It must not
+			// be used afterwards. Results copied out of it first, such as
+			// a context_data from get_context(), are on the heap and stay
+			// valid after the VM is released and handed out again.
+			void release(vm& machine) noexcept;
+			
+			// Sets the quota every VM has when it is acquired.
+			void set_quota(const resource_quota& limits) noexcept;
+			
+			// The number of VMs the pool has built, and how many of
+			// them are idle.
+			GP std::size_t size() const noexcept;
+			GP std::size_t idle() const noexcept;
+			
+			vm_pool(const vm_pool&) = delete;
+			vm_pool& operator=(const vm_pool&) = delete;
+			// Builds prewarmed VMs up front, with arenas that ask the
+			// system for chunk_bytes at a time.
+			explicit vm_pool(std::size_t prewarmed = 0, std::size_t chunk_bytes = 64 * 1024);
+		
+		private:
+			// An arena and the VM living in it, built and destroyed in
+			// that order.
+			struct slot {
+				arena storage;
+				vm machine;
+				
+				explicit slot(std::size_t chunk_bytes);
+			};
+			
+			std::vector<std::unique_ptr<slot>> slots;
+			std::vector<vm*> free_vms;
+			resource_quota quota;
+			std::size_t chunk_bytes;
+			
+			// Builds one more VM and makes it idle.
+			void grow();
+	};
+}
+
+#undef GP
+
+#endif
@@ -0,0 +1,203 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include "predecode.h"
+namespace p32 = metronome32;
+
+using p32::fusion;
+using p32::opcode;
+using p32::predecoded_code;
+using p32::predecoded_word;
+using p32::register_value;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::size_t predecoded_code::page_words;
+
+GP predecoded_word p32::predecode(const instruction& instr) noexcept
+{
+	predecoded_word word;
+	word.instr = instr;
+	word.op = instr_to_opcode(instr);
+	
+	switch (word.op) {
+		case opcode::add: case opcode::and_: case opcode::nor:
+		case opcode::neg: case opcode::or_: case opcode::rl:
+		case opcode::rlv: case opcode::rr: case opcode::rrv:
+		case opcode::sll: case opcode::sllv: case opcode::slt:
+		case opcode::sra: case opcode::srav: case opcode::srl:
+		case opcode::srlv: case opcode::sub: case opcode::xor_:
+			word.args.r = instr_to_r(instr);
+			break;
+		case opcode::addi: case opcode::andi: case opcode::ori:
+		case opcode::slti: case opcode::xori:
+			word.args.i = instr_to_i(instr);
+			break;
+		case opcode::beq: case opcode::bgez: case opcode::bgezal:
+		case opcode::bgtz: case opcode::blez: case opcode::bltz:
+		case opcode::bltzal: case opcode::bne: case opcode::exchange:
+		case opcode::jal: case opcode::jalr: case opcode::jr:
+			word.args.b = instr_to_b(instr);
+			break;
+		case opcode::cf: case opcode::j:
+			word.args.j = instr_to_j(instr);
+			break;
+		case opcode::nai:
+			break;
+	}
+	
+	return word;
+}
+
+GC bool p32::i_form(const opcode op) noexcept
+{
+	return op == opcode::addi or op == opcode::andi or op == opcode::ori or op == opcode::slti or op == opcode::xori;
+}
+
+GP register_value p32::immediate(const predecoded_word& word) noexcept
+{
+	return sign_extend(word.args.i.immediate.to_ulong(), 21);
+}
+
+GP bool p32::conditional_branch(const predecoded_word& word) noexcept
+{
+	switch (word.op) {
+		case opcode::beq: case opcode::bne: case opcode::bgez:
+		case opcode::bgtz: case opcode::blez: case opcode::bltz:
+			return true;
+		default:
+			return false;
+	}
+}
+
+GP register_value p32::branch_target(const predecoded_word& word, const register_value address) noexcept
+{
+	return address + sign_extend(word.args.b.offset.to_ulong(), 16);
+}
+
+// Returns the idiom first and second make, first being run first going
+// forward and second first in reverse.
+GP static fusion idiom(const predecoded_word& first, const predecoded_word& second) noexcept
+{
+	if (first.op == opcode::andi and first.args.i.immediate.none() and second.op == opcode::add
+	    and second.args.r.rsd == first.args.i.rsd and second.args.r.rs != second.args.r.rsd) {
+		return fusion::move;
+	} else if (first.op == opcode::cf and second.op == opcode::addi) {
+		return fusion::loop_head;
+	} else if (first.op == opcode::addi and second.op == opcode::bgtz and second.args.b.rb == first.args.i.rsd) {
+		return fusion::count_down;
+	} else {
+		return fusion::none;
+	}
+}
+
+predecoded_code::page& predecoded_code::decode(const system_memory_t& memory, const register_value number)
+{
+	std::unique_ptr<page>& slot = decoded[number];
+	
+	if (slot != nullptr) {
+		return *slot;
+	}
+	
+	slot.reset(new page);
+	page& words = *slot;
+	const register_value first = number << memory::page_bits;
+	words.fill(predecode(memory_default));
+	
+	for (auto word = memory.lower_bound(first); word != memory.end() and memory::page_of(word->first) == number; ++word) {
+		words[word->first % page_words] = predecode(word->second);
+	}
+	
+	for (std::size_t i = 1; i < page_words; i++) {
+		const fusion pair = idiom(words[i - 1], words[i]);
+		words[i - 1].forward = pair;
+		words[i].reverse = pair;
+	}
+	
+	return words;
+}
+
+void predecoded_code::learn_target(const predecoded_word& site, const register_value target, const system_memory_t& memory)
+{
+	if (only_held and not holds(target)) {
+		return;
+	}
+	
+	decode(memory, memory::page_of(target));
+	site.target_key = generation << 32 | target;
+}
+
+void predecoded_code::wrote(const register_value address) noexcept
+{
+	const register_value number = memory::page_of(address);
+	
+	if (last != nullptr and number == last_number) {
+		last = nullptr;
+	}
+	
+	if (decoded.erase(number) == 0) {
+		return;
+	}
+	
+	// An empty target_key matches nothing until the last generation.
+	if (++generation == UINT32_MAX) {
+		clear();
+	}
+}
+
+void predecoded_code::clear() noexcept
+{
+	decoded.clear();
+	last = nullptr;
+	generation = 0;
+}
+
+GP std::size_t predecoded_code::pages() const noexcept
+{
+	return decoded.size();
+}
+
+void predecoded_code::adopt(predecoded_code& other)
+{
+	for (auto& held : other.decoded) {
+		decoded[held.first] = std::move(held.second);
+	}
+	
+	last = nullptr;
+	other.clear();
+}
+
+void predecoded_code::seal(const bool set_sealed) noexcept
+{
+	only_held = set_sealed;
+}
+
+GP bool predecoded_code::sealed() const noexcept
+{
+	return only_held;
+}
+
+#undef GP
+#undef GC
@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "instruction.h"
+#include "memory.h"
+
+#ifndef HEADER_P32_PREDECODE_H
+#define HEADER_P32_PREDECODE_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// A pair of adjacent words run as one instruction.
+	enum class fusion : std::uint8_t {
+		none,
+		// ANDI r, 0 then ADD r, s: a register move.
+		move,
+		// CF then ADDI: the head of a loop.
+		loop_head,
+		// ADDI r then BGTZ r: the back edge of a counted loop.
+		count_down,
+	};
+	
+	// An instruction split into its opcode and operands, and the idioms
+	// it starts. Only the operands for the opcode's type are set.
+	struct predecoded_word {
+		instruction instr;
+		opcode op = opcode::nai;
+		// The idiom this word starts with the word after it, going
+		// forward, and with the word before it, in reverse.
+		fusion forward = fusion::none;
+		fusion reverse = fusion::none;
+		// Set by the VM once native_code has no block starting here,
+		// forward in bit 0 and in reverse in bit 1.
+		mutable std::uint8_t no_native = 0;
+		// The same, once loop_idioms has no loop entered here.
+		mutable std::uint8_t no_idiom = 0;
+		// For JR and JALR, the inline cache predecoded_code keeps of
+		// the last target jumped to.
+		mutable std::uint64_t target_key = UINT64_MAX;
+		
+		union operands {
+			instr_type::r r;
+			instr_type::j j;
+			instr_type::b b;
+			instr_type::i i;
+			
+			operands() noexcept : r() {}
+		} args;
+	};
+	
+	// Splits an instruction, without looking for idioms.
+	GP predecoded_word predecode(const instruction& instr) noexcept;
+	// Returns whether an ALU opcode is I-type rather than R-type.
+	GC bool i_form(opcode op) noexcept;
+	// Returns an I-type word's immediate, sign-extended.
+	GP register_value immediate(const predecoded_word& word) noexcept;
+	// Returns whether a word is a conditional branch that doesn't link:
+	// BEQ, BNE, BGEZ, BGTZ, BLEZ or BLTZ.
+	GP bool conditional_branch(const predecoded_word& word) noexcept;
+	// Returns where a branch word at address goes when taken.
+	GP register_value branch_target(const predecoded_word& word, register_value address) noexcept;
+	
+	// A copy of a context's memory, split into predecoded_words a page
+	// at a time as it is fetched. It doesn't watch the memory, so every
+	// write made to a page must be reported with wrote(), and a context
+	// with different memory needs clear(). Idioms are only found within
+	// a page, so dropping one page never breaks an idiom on another.
+	// Every JR and JALR also caches the last target it jumped to, with
+	// the target's page kept split so that writing it is noticed.
+	class predecoded_code {
+		public:
+			static constexpr std::size_t page_words = std::size_t(1) << memory::page_bits;
+			
+			// Returns the word at address, splitting its page of memory
+			// first if needed.
+			const predecoded_word& fetch(const system_memory_t& memory, const register_value address)
+			{
+				const register_value number = memory::page_of(address);
+				
+				if (last == nullptr or number != last_number) {
+					last = &decode(memory, number);
+					last_number = number;
+				}
+				
+				return (*last)[address % page_words];
+			}
+			
+			// Returns whether a JR or JALR site's last target was target,
+			// so that it held a CF and hasn't been written to since.
+			GP bool knows_target(const predecoded_word& site, const register_value target) const noexcept
+			{
+				return site.target_key == (generation << 32 | target);
+			}
+			
+			// Remembers that site jumped to target, which held a CF.
+			void learn_target(const predecoded_word& site, register_value target, const system_memory_t& memory);
+			
+			// Drops the page holding address, which has been written.
+			// If the page was split, every jump site forgets its target.
+			void wrote(register_value address) noexcept;
+			// Drops every page.
+			void clear() noexcept;
+			// The number of pages split.
+			GP std::size_t pages() const noexcept;
+			
+			// Returns whether the page holding address has been split.
+			GP bool holds(const register_value address) const noexcept
+			{
+				const register_value number = memory::page_of(address);
+				
+				return (last != nullptr and number == last_number) or decoded.count(number) != 0;
+			}
+			
+			// Moves every page split in other into this copy, in place of
+			// any of its own. The pages must match this copy's memory.
+			void adopt(predecoded_code& other);
+			// Sets whether only pages already split, as by adopt(), are
+			// run: run_predecoded() stops before a word on any other
+			// page, and jumps to one aren't cached. native_code compiles
+			// nothing for a sealed code.
+			void seal(bool set_sealed) noexcept;
+			GP bool sealed() const noexcept;
+		
+		private:
+			typedef std::array<predecoded_word, page_words> page;
+			
+			std::unordered_map<register_value, std::unique_ptr<page>> decoded;
+			// The page fetched last, which most fetches hit.
+			page* last = nullptr;
+			register_value last_number = 0;
+			// Bumped whenever a split page is written, so that no cached
+			// target from before matches.
+			std::uint64_t generation = 0;
+			bool only_held = false;
+			
+			// Returns a page, splitting it if it hasn't been.
+			page& decode(const system_memory_t& memory, register_value number);
+	};
+}
+
+#undef GP
+#undef GC
+
+#endif
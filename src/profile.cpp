@@ -0,0 +1,554 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include "profile.h"
+namespace p32 = metronome32;
+
+using p32::register_value;
+using p32::opcode;
+using p32::step_event;
+using p32::shadow_call_stack;
+using p32::garbage_profiling;
+using p32::function_profiling;
+using p32::symbol_table;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr shadow_call_stack::path_id shadow_call_stack::root;
+constexpr std::size_t function_profiling::forward;
+constexpr std::size_t function_profiling::backward;
+
+shadow_call_stack::shadow_call_stack()
+	: nodes({path_node{root, 0}})
+{}
+
+void shadow_call_stack::update(const step_event& event) noexcept
+{
+	if (not event.retired) {
+		return;
+	}
+	
+	if (not event.reversing) {
+		switch (event.op) {
+			case opcode::jal:
+			case opcode::jalr:
+				call(event.next_pc - 1, event.pc + 1);
+				break;
+			case opcode::bgezal:
+			case opcode::bltzal:
+				if (event.pc_delta > 0) {
+					call(event.next_pc - 1, event.pc + 1);
+				}
+				
+				break;
+			case opcode::jr:
+				ret(event.pc, event.next_pc - 1);
+				break;
+			default:
+				break;
+		}
+	} else if (event.op == opcode::cf and event.next_pc != event.pc) {
+		// A CF popped the address of the jump that reached it.
+		if (not uncall(event.pc, event.next_pc)) {
+			unreturn(event.pc, event.next_pc);
+		}
+	}
+}
+
+void shadow_call_stack::clear() noexcept
+{
+	stack.clear();
+	returned.clear();
+}
+
+GP std::size_t shadow_call_stack::depth() const noexcept
+{
+	return stack.size();
+}
+
+GC const std::vector<shadow_call_stack::frame>& shadow_call_stack::frames() const noexcept
+{
+	return stack;
+}
+
+GP shadow_call_stack::path_id shadow_call_stack::path() const noexcept
+{
+	return stack.empty() ? root : stack.back().path;
+}
+
+GP shadow_call_stack::path_id shadow_call_stack::parent(const path_id node) const noexcept
+{
+	return nodes[node].parent;
+}
+
+GP register_value shadow_call_stack::entry(const path_id node) const noexcept
+{
+	return nodes[node].entry;
+}
+
+std::vector<register_value> shadow_call_stack::entries(path_id node) const
+{
+	std::vector<register_value> result;
+	
+	for (; node != root; node = nodes[node].parent) {
+		result.push_back(nodes[node].entry);
+	}
+	
+	std::reverse(result.begin(), result.end());
+	
+	return result;
+}
+
+GP std::size_t shadow_call_stack::path_count() const noexcept
+{
+	return nodes.size();
+}
+
+shadow_call_stack::path_id shadow_call_stack::intern(const path_id from, const register_value to) noexcept
+{
+	const std::uint64_t key = (std::uint64_t(from) << 32) | to;
+	const auto found = children.find(key);
+	
+	if (found != children.end()) {
+		return found->second;
+	}
+	
+	const path_id node = nodes.size();
+	nodes.push_back(path_node{from, to});
+	children.emplace(key, node);
+	
+	return node;
+}
+
+void shadow_call_stack::call(const register_value entry_cf, const register_value return_cf) noexcept
+{
+	stack.push_back(frame{entry_cf, return_cf, intern(path(), entry_cf)});
+}
+
+void shadow_call_stack::ret(const register_value source, const register_value target) noexcept
+{
+	auto found = std::find_if(
+		stack.rbegin(),
+		stack.rend(),
+		[target](const frame& f) {return f.return_cf == target;}
+	);
+	
+	if (found == stack.rend()) {
+		return;
+	}
+	
+	const std::size_t keep = stack.rend() - found - 1;
+	bool innermost = true;
+	
+	while (stack.size() > keep) {
+		returned.push_back(return_record{stack.back(), source, innermost});
+		stack.pop_back();
+		innermost = false;
+	}
+}
+
+bool shadow_call_stack::unreturn(const register_value return_cf, const register_value source) noexcept
+{
+	if (returned.empty()
+	    or returned.back().source != source
+	    or returned.back().popped.return_cf != return_cf) {
+		return false;
+	}
+	
+	bool innermost = false;
+	
+	while (not innermost) {
+		stack.push_back(returned.back().popped);
+		innermost = returned.back().innermost;
+		returned.pop_back();
+	}
+	
+	return true;
+}
+
+bool shadow_call_stack::uncall(const register_value entry_cf, const register_value source) noexcept
+{
+	// JAL pushes the address after itself, the other calls their own.
+	if (stack.empty()
+	    or stack.back().entry != entry_cf
+	    or (source != stack.back().return_cf and source != stack.back().return_cf - 1)) {
+		return false;
+	}
+	
+	stack.pop_back();
+	
+	return true;
+}
+
+bool symbol_table::load(const std::string& path)
+{
+	std::ifstream in(path);
+	std::string line;
+	
+	if (not in) {
+		return false;
+	}
+	
+	while (std::getline(in, line)) {
+		std::istringstream fields(line);
+		std::string address;
+		std::string name;
+		
+		if (not (fields >> address) or address[0] == '#') {
+			continue;
+		}
+		
+		char* end = nullptr;
+		const unsigned long value = std::strtoul(address.c_str(), &end, 0);
+		
+		if (*end != '\0' or not (fields >> name)) {
+			return false;
+		}
+		
+		add(static_cast<register_value>(value), name);
+	}
+	
+	return true;
+}
+
+void symbol_table::add(const register_value address, const std::string& name)
+{
+	names[address] = name;
+}
+
+GP const std::string* symbol_table::find(const register_value address) const noexcept
+{
+	const auto found = names.find(address);
+	
+	return found == names.end() ? nullptr : &found->second;
+}
+
+GP bool symbol_table::empty() const noexcept
+{
+	return names.empty();
+}
+
+void p32::write_symbol(std::ostream& out, const register_value address, const symbol_table* symbols)
+{
+	const std::string* name = symbols == nullptr ? nullptr : symbols->find(address);
+	
+	if (name != nullptr) {
+		out << *name;
+	} else {
+		write_address(out, address);
+	}
+}
+
+void p32::write_address(std::ostream& out, const register_value address)
+{
+	const auto flags = out.flags();
+	const auto fill = out.fill();
+	out << "0x" << std::hex << std::setw(8) << std::setfill('0') << address;
+	out.flags(flags);
+	out.fill(fill);
+}
+
+// Bytes of garbage represented by a number of garbage stack entries.
+GP static std::uint64_t garbage_bytes(const std::uint64_t entries) noexcept
+{
+	return entries * sizeof(register_value);
+}
+
+GP static std::uint64_t site_bytes(const garbage_profiling::site& s) noexcept
+{
+	return garbage_bytes(s.dp_pushes + s.pc_pushes);
+}
+
+void garbage_profiling::record(const step_event& event, const context_data&) noexcept
+{
+	if (event.retired and not event.reversing
+	    and (event.dp_delta > 0 or event.pc_delta > 0)) {
+		const std::uint64_t key = (std::uint64_t(stack.path()) << 32) | event.pc;
+		site& s = counts[key];
+		s.pc = event.pc;
+		s.path = stack.path();
+		s.dp_pushes += event.dp_delta > 0;
+		s.pc_pushes += event.pc_delta > 0;
+	}
+	
+	stack.update(event);
+}
+
+void garbage_profiling::reset() noexcept
+{
+	stack = shadow_call_stack();
+	counts.clear();
+}
+
+std::vector<garbage_profiling::site> garbage_profiling::sites() const
+{
+	std::vector<site> result;
+	result.reserve(counts.size());
+	
+	for (const auto& entry : counts) {
+		result.push_back(entry.second);
+	}
+	
+	std::sort(result.begin(), result.end(), [](const site& a, const site& b) {
+		if (site_bytes(a) != site_bytes(b)) {
+			return site_bytes(a) > site_bytes(b);
+		} else if (a.pc != b.pc) {
+			return a.pc < b.pc;
+		} else {
+			return a.path < b.path;
+		}
+	});
+	
+	return result;
+}
+
+GC const shadow_call_stack& garbage_profiling::calls() const noexcept
+{
+	return stack;
+}
+
+// Writes the counts of a row of a garbage table.
+static void write_row(std::ostream& out, const std::uint64_t dp, const std::uint64_t pc)
+{
+	out << ' ' << std::setw(12) << dp
+	    << ' ' << std::setw(12) << pc
+	    << ' ' << std::setw(14) << garbage_bytes(dp + pc) << "  ";
+}
+
+void garbage_profiling::write_report(std::ostream& out, const symbol_table* symbols) const
+{
+	typedef std::pair<std::uint64_t, std::uint64_t> pushes_t;
+	std::map<register_value, pushes_t> by_pc;
+	std::map<register_value, pushes_t> by_function;
+	std::uint64_t root_dp = 0;
+	std::uint64_t root_pc = 0;
+	
+	for (const site& s : sites()) {
+		by_pc[s.pc].first += s.dp_pushes;
+		by_pc[s.pc].second += s.pc_pushes;
+		
+		if (s.path == shadow_call_stack::root) {
+			root_dp += s.dp_pushes;
+			root_pc += s.pc_pushes;
+		} else {
+			by_function[stack.entry(s.path)].first += s.dp_pushes;
+			by_function[stack.entry(s.path)].second += s.pc_pushes;
+		}
+	}
+	
+	// Sorts the rows of a table by bytes, largest first.
+	const auto sorted = [](const std::map<register_value, pushes_t>& rows) {
+		std::vector<std::pair<register_value, pushes_t>> result(rows.begin(), rows.end());
+		std::stable_sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+			return a.second.first + a.second.second > b.second.first + b.second.second;
+		});
+		
+		return result;
+	};
+	
+	out << "Garbage by PC\n"
+	    << "    DP pushes    PC pushes          bytes  PC\n";
+	
+	for (const auto& row : sorted(by_pc)) {
+		write_row(out, row.second.first, row.second.second);
+		write_address(out, row.first);
+		out << '\n';
+	}
+	
+	out << "\nGarbage by function\n"
+	    << "    DP pushes    PC pushes          bytes  function\n";
+	
+	for (const auto& row : sorted(by_function)) {
+		write_row(out, row.second.first, row.second.second);
+		write_symbol(out, row.first, symbols);
+		out << '\n';
+	}
+	
+	if (root_dp + root_pc != 0) {
+		write_row(out, root_dp, root_pc);
+		out << "(none)\n";
+	}
+}
+
+void garbage_profiling::write_folded(std::ostream& out, const symbol_table* symbols) const
+{
+	for (const site& s : sites()) {
+		const std::uint64_t pushes[2] = {s.dp_pushes, s.pc_pushes};
+		const char* const stacks[2] = {"dp_stack", "pc_stack"};
+		
+		for (size_t i = 0; i < 2; i++) {
+			if (pushes[i] == 0) {
+				continue;
+			}
+			
+			out << stacks[i];
+			
+			for (const register_value entry : stack.entries(s.path)) {
+				out << ';';
+				write_symbol(out, entry, symbols);
+			}
+			
+			out << ';';
+			write_address(out, s.pc);
+			out << ' ' << garbage_bytes(pushes[i]) << '\n';
+		}
+	}
+}
+
+void function_profiling::record(const step_event& event, const context_data&) noexcept
+{
+	const shadow_call_stack::path_id path = stack.path();
+	const std::size_t depth = stack.depth();
+	
+	if (path >= per_path.size()) {
+		per_path.resize(stack.path_count());
+	}
+	
+	if (event.retired) {
+		per_path[path][event.reversing ? backward : forward]++;
+	}
+	
+	stack.update(event);
+	
+	if (not event.reversing and stack.depth() > depth) {
+		call_counts[stack.frames().back().entry]++;
+	}
+}
+
+void function_profiling::reset() noexcept
+{
+	stack = shadow_call_stack();
+	per_path.clear();
+	call_counts.clear();
+}
+
+std::vector<function_profiling::function> function_profiling::functions() const
+{
+	std::map<register_value, function> by_entry;
+	std::set<register_value> counted;
+	
+	for (shadow_call_stack::path_id path = 1; path < per_path.size(); path++) {
+		const auto& counts = per_path[path];
+		function& innermost = by_entry[stack.entry(path)];
+		innermost.exclusive[forward] += counts[forward];
+		innermost.exclusive[backward] += counts[backward];
+		
+		// Recursive functions appear on a path more than once, but
+		// only count once towards their inclusive total.
+		counted.clear();
+		
+		for (auto node = path; node != shadow_call_stack::root; node = stack.parent(node)) {
+			if (counted.insert(stack.entry(node)).second) {
+				function& f = by_entry[stack.entry(node)];
+				f.inclusive[forward] += counts[forward];
+				f.inclusive[backward] += counts[backward];
+			}
+		}
+	}
+	
+	std::vector<function> result;
+	result.reserve(by_entry.size());
+	
+	for (auto& entry : by_entry) {
+		const auto calls = call_counts.find(entry.first);
+		entry.second.entry = entry.first;
+		entry.second.calls = calls == call_counts.end() ? 0 : calls->second;
+		result.push_back(entry.second);
+	}
+	
+	std::stable_sort(result.begin(), result.end(), [](const function& a, const function& b) {
+		return a.inclusive[forward] + a.inclusive[backward]
+			> b.inclusive[forward] + b.inclusive[backward];
+	});
+	
+	return result;
+}
+
+GP std::array<std::uint64_t, 2> function_profiling::outside() const noexcept
+{
+	if (per_path.empty()) {
+		return {{0, 0}};
+	}
+	
+	return per_path[shadow_call_stack::root];
+}
+
+GC const shadow_call_stack& function_profiling::calls() const noexcept
+{
+	return stack;
+}
+
+void function_profiling::write_report(std::ostream& out, const symbol_table* symbols) const
+{
+	out << "Instructions by function\n"
+	    << "       calls  incl. fwd.  excl. fwd.  incl. bwd.  excl. bwd.  function\n";
+	
+	for (const function& f : functions()) {
+		out << std::setw(12) << f.calls
+		    << std::setw(12) << f.inclusive[forward]
+		    << std::setw(12) << f.exclusive[forward]
+		    << std::setw(12) << f.inclusive[backward]
+		    << std::setw(12) << f.exclusive[backward] << "  ";
+		write_symbol(out, f.entry, symbols);
+		out << '\n';
+	}
+	
+	const auto rest = outside();
+	
+	if (rest[forward] + rest[backward] != 0) {
+		out << std::setw(12) << 0
+		    << std::setw(24) << rest[forward]
+		    << std::setw(24) << rest[backward] << "  (none)\n";
+	}
+}
+
+void function_profiling::write_folded(std::ostream& out, const symbol_table* symbols) const
+{
+	for (shadow_call_stack::path_id path = 0; path < per_path.size(); path++) {
+		const std::uint64_t total = per_path[path][forward] + per_path[path][backward];
+		
+		if (total == 0) {
+			continue;
+		}
+		
+		out << "root";
+		
+		for (const register_value entry : stack.entries(path)) {
+			out << ';';
+			write_symbol(out, entry, symbols);
+		}
+		
+		out << ' ' << total << '\n';
+	}
+}
+
+#undef GP
+#undef GC
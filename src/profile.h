@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "instruction.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_PROFILE_H
+#define HEADER_P32_PROFILE_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// Reconstructs guest functions from calls and returns. A call is a
+	// retired JAL or JALR, or a taken BGEZAL or BLTZAL, and the function
+	// is named by the CF it lands on. A JR whose target is the return CF
+	// of a frame on the stack returns from that frame.
+	//
+	// Every distinct chain of functions gets a path_id, so callers can
+	// key data by call path without storing whole stacks.
+	class shadow_call_stack {
+		public:
+			typedef std::uint32_t path_id;
+			// The path of code outside any known function.
+			static constexpr path_id root = 0;
+			
+			struct frame {
+				// The CF that starts the function.
+				register_value entry;
+				// The CF that the function returns to.
+				register_value return_cf;
+				// The call path ending in this frame.
+				path_id path;
+			};
+			
+			shadow_call_stack();
+			
+			// Follows one step. Running backwards, a CF popping back
+			// out of a function entry leaves the function, and a CF
+			// popping into a function at its return site re-enters
+			// the frame that returned there.
+			void update(const step_event& event) noexcept;
+			// Forgets every frame, but keeps interned paths.
+			void clear() noexcept;
+			
+			GP std::size_t depth() const noexcept;
+			GC const std::vector<frame>& frames() const noexcept;
+			// The path of the innermost frame, or root.
+			GP path_id path() const noexcept;
+			GP path_id parent(path_id path) const noexcept;
+			// The entry CF of the innermost function on a path.
+			GP register_value entry(path_id path) const noexcept;
+			// The entries on a path, outermost first.
+			std::vector<register_value> entries(path_id path) const;
+			// The number of distinct paths seen, including root.
+			GP std::size_t path_count() const noexcept;
+			// Returns the path for calling entry from parent.
+			path_id intern(path_id parent, register_value entry) noexcept;
+		
+		private:
+			struct path_node {
+				path_id parent;
+				register_value entry;
+			};
+			
+			// A frame popped by a JR, kept so that running the
+			// return backwards can restore it.
+			struct return_record {
+				frame popped;
+				// The address of the JR.
+				register_value source;
+				// Whether this is the innermost frame popped by
+				// that JR.
+				bool innermost;
+			};
+			
+			std::vector<frame> stack;
+			std::vector<return_record> returned;
+			std::vector<path_node> nodes;
+			std::unordered_map<std::uint64_t, path_id> children;
+			
+			void call(register_value entry, register_value return_cf) noexcept;
+			void ret(register_value source, register_value target) noexcept;
+			bool unreturn(register_value return_cf, register_value source) noexcept;
+			bool uncall(register_value entry, register_value source) noexcept;
+	};
+	
+	// Names for guest addresses, read from a symbol file. Each line of
+	// a symbol file holds an address (decimal, or hexadecimal with a 0x
+	// prefix) followed by a name. Blank lines and lines starting with #
+	// are skipped.
+	class symbol_table {
+		public:
+			// Adds the symbols in a file. Returns false if it can't
+			// be read or has a malformed line.
+			bool load(const std::string& path);
+			void add(register_value address, const std::string& name);
+			// Returns the name of an address, or nullptr.
+			GP const std::string* find(register_value address) const noexcept;
+			GP bool empty() const noexcept;
+		
+		private:
+			std::unordered_map<register_value, std::string> names;
+	};
+	
+	// Writes an address the way profiles name functions and PCs.
+	void write_address(std::ostream& out, register_value address);
+	// Writes the symbol for an address if there is one, or the address.
+	void write_symbol(std::ostream& out, register_value address, const symbol_table* symbols);
+	
+	// A statistics policy attributing garbage to the code producing it.
+	// Every push to the datapath or PC garbage stack is charged to the
+	// PC that pushed it and to the call path it ran under.
+	class garbage_profiling {
+		public:
+			static constexpr bool enabled = true;
+			
+			// Garbage pushed by one PC under one call path.
+			struct site {
+				register_value pc;
+				shadow_call_stack::path_id path;
+				std::uint64_t dp_pushes;
+				std::uint64_t pc_pushes;
+			};
+			
+			void record(const step_event& event, const context_data& context) noexcept;
+			// Forgets all counts and the shadow call stack.
+			void reset() noexcept;
+			
+			// Every site with garbage, most garbage first.
+			std::vector<site> sites() const;
+			GC const shadow_call_stack& calls() const noexcept;
+			
+			// Writes a table of garbage by PC, then by function,
+			// each sorted by the number of bytes pushed.
+			void write_report(std::ostream& out, const symbol_table* symbols = nullptr) const;
+			// Writes the datapath and PC pushes in the folded stack
+			// format read by flamegraph.pl, one line per call path
+			// and PC, weighted by bytes of garbage.
+			void write_folded(std::ostream& out, const symbol_table* symbols = nullptr) const;
+		
+		private:
+			shadow_call_stack stack;
+			std::unordered_map<std::uint64_t, site> counts;
+	};
+	
+	// A statistics policy counting instructions per guest function, in
+	// each direction. An instruction counts exclusively towards the
+	// innermost function running it and inclusively towards every
+	// function on the call stack. Instructions outside any function are
+	// counted against shadow_call_stack::root.
+	class function_profiling {
+		public:
+			static constexpr bool enabled = true;
+			
+			// Indexes the per-direction arrays below.
+			static constexpr std::size_t forward = 0;
+			static constexpr std::size_t backward = 1;
+			
+			struct function {
+				// The CF that starts the function.
+				register_value entry;
+				// The number of calls made to it, run forwards.
+				std::uint64_t calls;
+				std::array<std::uint64_t, 2> inclusive;
+				std::array<std::uint64_t, 2> exclusive;
+			};
+			
+			void record(const step_event& event, const context_data& context) noexcept;
+			// Forgets all counts and the shadow call stack.
+			void reset() noexcept;
+			
+			// Every function seen, highest inclusive count first.
+			std::vector<function> functions() const;
+			// Instructions that ran outside any function.
+			GP std::array<std::uint64_t, 2> outside() const noexcept;
+			GC const shadow_call_stack& calls() const noexcept;
+			
+			// Writes a table of the functions seen.
+			void write_report(std::ostream& out, const symbol_table* symbols = nullptr) const;
+			// Writes exclusive counts of both directions in the
+			// folded stack format read by flamegraph.pl.
+			void write_folded(std::ostream& out, const symbol_table* symbols = nullptr) const;
+		
+		private:
+			shadow_call_stack stack;
+			// Exclusive counts, indexed by path_id.
+			std::vector<std::array<std::uint64_t, 2>> per_path;
+			std::unordered_map<register_value, std::uint64_t> call_counts;
+	};
+}
+
+#undef GP
+#undef GC
+
+#endif
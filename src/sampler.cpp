@@ -0,0 +1,327 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include "sampler.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+ #include <signal.h>
+ #include <sys/time.h>
+ #define _SAMPLERCPP_POSIX 1
+#else
+ #define _SAMPLERCPP_POSIX 0
+#endif
+
+namespace p32 = metronome32;
+
+using p32::register_value;
+using p32::sampling;
+using p32::sample_profiler;
+using p32::shadow_call_stack;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr std::uint64_t sampling::valid_bit;
+
+// The VM sampled on each thread.
+static thread_local sampling* bound = nullptr;
+// The profiler the signal handler reports to.
+static std::atomic<sample_profiler*> active(nullptr);
+// Hands out sampling ids.
+static std::atomic<std::uint32_t> next_owner(0);
+
+sampling::sampling() noexcept
+	: location(0), owner(next_owner.fetch_add(1, std::memory_order_relaxed))
+{}
+
+sampling::sampling(const sampling& other) noexcept
+	: location(0), owner(next_owner.fetch_add(1, std::memory_order_relaxed)),
+	  track(other.track), stack(other.stack)
+{}
+
+sampling& sampling::operator=(const sampling& other) noexcept
+{
+	track = other.track;
+	stack = other.stack;
+	
+	return *this;
+}
+
+sampling::~sampling()
+{
+	detach();
+}
+
+void sampling::attach(const bool track_calls) noexcept
+{
+	track = track_calls;
+	bound = this;
+}
+
+void sampling::detach() noexcept
+{
+	if (bound == this) {
+		bound = nullptr;
+	}
+}
+
+GP std::uint32_t sampling::id() const noexcept
+{
+	return owner;
+}
+
+GC const shadow_call_stack& sampling::calls() const noexcept
+{
+	return stack;
+}
+
+GC bool sampling::valid(const std::uint64_t loc) noexcept
+{
+	return (loc & valid_bit) != 0;
+}
+
+GC register_value sampling::location_pc(const std::uint64_t loc) noexcept
+{
+	return static_cast<register_value>(loc);
+}
+
+GC bool sampling::location_reversing(const std::uint64_t loc) noexcept
+{
+	return ((loc >> 32) & 1) != 0;
+}
+
+GC shadow_call_stack::path_id sampling::location_path(const std::uint64_t loc) noexcept
+{
+	return static_cast<shadow_call_stack::path_id>((loc >> 33) & 0x3FFFFFFF);
+}
+
+#if _SAMPLERCPP_POSIX
+// Runs on whichever thread SIGPROF interrupts. It only reads atomics and
+// claims a preallocated slot, so it's async-signal-safe.
+static void on_sigprof(int)
+{
+	sample_profiler* profiler = active.load(std::memory_order_acquire);
+	const sampling* policy = bound;
+	
+	if (profiler == nullptr) {
+		return;
+	}
+	
+	const std::uint64_t loc = policy == nullptr ? 0 : policy->location.load(std::memory_order_relaxed);
+	
+	if (sampling::valid(loc)) {
+		profiler->take(policy->id(), loc);
+	} else {
+		profiler->miss();
+	}
+}
+
+static struct sigaction previous_action;
+#endif
+
+sample_profiler::sample_profiler(const std::size_t capacity)
+	: samples(capacity), used(0), drops(0), misses(0)
+{}
+
+sample_profiler::~sample_profiler()
+{
+	stop();
+}
+
+bool sample_profiler::start(const unsigned int frequency)
+{
+#if _SAMPLERCPP_POSIX
+	sample_profiler* expected = nullptr;
+	
+	if (frequency == 0 or not active.compare_exchange_strong(expected, this)) {
+		return false;
+	}
+	
+	struct sigaction action;
+	action.sa_handler = on_sigprof;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	
+	const long period = std::max(1000000L / frequency, 1L);
+	struct itimerval timer;
+	timer.it_interval.tv_sec = period / 1000000;
+	timer.it_interval.tv_usec = period % 1000000;
+	timer.it_value = timer.it_interval;
+	
+	if (sigaction(SIGPROF, &action, &previous_action) != 0) {
+		active.store(nullptr, std::memory_order_release);
+		
+		return false;
+	} else if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+		sigaction(SIGPROF, &previous_action, nullptr);
+		active.store(nullptr, std::memory_order_release);
+		
+		return false;
+	}
+	
+	running = true;
+	
+	return true;
+#else
+	static_cast<void>(frequency);
+	
+	return false;
+#endif
+}
+
+void sample_profiler::stop() noexcept
+{
+#if _SAMPLERCPP_POSIX
+	if (not running) {
+		return;
+	}
+	
+	struct itimerval timer = {};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	sigaction(SIGPROF, &previous_action, nullptr);
+	active.store(nullptr, std::memory_order_release);
+	running = false;
+#endif
+}
+
+bool sample_profiler::running_any() noexcept
+{
+	return active.load(std::memory_order_relaxed) != nullptr;
+}
+
+void sample_profiler::clear() noexcept
+{
+	used.store(0, std::memory_order_relaxed);
+	drops.store(0, std::memory_order_relaxed);
+	misses.store(0, std::memory_order_relaxed);
+}
+
+GP std::size_t sample_profiler::size() const noexcept
+{
+	return kept();
+}
+
+GP std::uint64_t sample_profiler::dropped() const noexcept
+{
+	return drops.load(std::memory_order_relaxed);
+}
+
+GP std::uint64_t sample_profiler::missed() const noexcept
+{
+	return misses.load(std::memory_order_relaxed);
+}
+
+void sample_profiler::take(const std::uint32_t owner, const std::uint64_t loc) noexcept
+{
+	const std::size_t slot = used.fetch_add(1, std::memory_order_relaxed);
+	
+	if (slot < samples.size()) {
+		samples[slot] = sample{owner, loc};
+	} else {
+		drops.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void sample_profiler::miss() noexcept
+{
+	misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+GP std::size_t sample_profiler::kept() const noexcept
+{
+	return std::min(used.load(std::memory_order_acquire), samples.size());
+}
+
+std::vector<sample_profiler::pc_count> sample_profiler::histogram(const sampling& policy) const
+{
+	std::map<std::pair<register_value, bool>, std::uint64_t> counts;
+	
+	for (std::size_t i = 0; i < kept(); i++) {
+		if (samples[i].owner == policy.id()) {
+			const std::uint64_t loc = samples[i].location;
+			counts[{sampling::location_pc(loc), sampling::location_reversing(loc)}]++;
+		}
+	}
+	
+	std::vector<pc_count> result;
+	
+	for (const auto& count : counts) {
+		result.push_back(pc_count{count.first.first, count.first.second, count.second});
+	}
+	
+	std::stable_sort(result.begin(), result.end(), [](const pc_count& a, const pc_count& b) {
+		return a.samples > b.samples;
+	});
+	
+	return result;
+}
+
+void sample_profiler::write_histogram(std::ostream& out, const sampling& policy) const
+{
+	out << "     samples  direction  PC\n";
+	
+	for (const pc_count& count : histogram(policy)) {
+		out << std::setw(12) << count.samples
+		    << (count.reversing ? "  backward   " : "  forward    ");
+		p32::write_address(out, count.pc);
+		out << '\n';
+	}
+}
+
+void sample_profiler::write_folded(std::ostream& out, const sampling& policy, const symbol_table* symbols) const
+{
+	std::map<std::pair<std::uint64_t, register_value>, std::uint64_t> counts;
+	
+	for (std::size_t i = 0; i < kept(); i++) {
+		if (samples[i].owner == policy.id()) {
+			const std::uint64_t loc = samples[i].location;
+			// Keep the direction and path, keyed by PC.
+			const std::uint64_t key = loc >> 32;
+			counts[{key, sampling::location_pc(loc)}]++;
+		}
+	}
+	
+	for (const auto& count : counts) {
+		const std::uint64_t loc = count.first.first << 32;
+		const shadow_call_stack::path_id path = sampling::location_path(loc);
+		out << (sampling::location_reversing(loc) ? "backward" : "forward");
+		
+		if (path < policy.calls().path_count()) {
+			for (const register_value entry : policy.calls().entries(path)) {
+				out << ';';
+				p32::write_symbol(out, entry, symbols);
+			}
+		}
+		
+		out << ';';
+		p32::write_address(out, count.first.second);
+		out << ' ' << count.second << '\n';
+	}
+}
+
+#undef GP
+#undef GC
+#undef _SAMPLERCPP_POSIX
@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "instruction.h"
+#include "vm.h"
+#include "profile.h"
+
+#ifndef HEADER_P32_SAMPLER_H
+#define HEADER_P32_SAMPLER_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// A statistics policy that publishes where a VM is, for a
+	// sample_profiler to read from its signal handler. By default each
+	// step costs one relaxed store of its PC and direction, and the VM
+	// builds no step_event for it. Following calls, to label samples
+	// with call paths, is off by default. With it on, a step also calls
+	// into the library to ask whether a profiler is running, and while
+	// one is, the VM builds a full step_event and the shadow call stack
+	// is updated from it. Calls made while no profiler runs are missed.
+	class sampling {
+		public:
+			static constexpr bool enabled = true;
+			
+			// Publishes pc, and returns true, unless the step needs a
+			// step_event for record() instead.
+			bool quick_record(register_value pc, bool reversing) noexcept;
+			void record(const step_event& event, const context_data& context) noexcept;
+			// Makes this VM the one sampled on the calling thread,
+			// which must be the thread that steps it.
+			void attach(bool track_calls = false) noexcept;
+			// Stops this VM from being sampled on the calling thread.
+			void detach() noexcept;
+			
+			// Identifies this VM's samples.
+			GP std::uint32_t id() const noexcept;
+			GC const shadow_call_stack& calls() const noexcept;
+			
+			// Decoding a published location.
+			GC static bool valid(std::uint64_t location) noexcept;
+			GC static register_value location_pc(std::uint64_t location) noexcept;
+			GC static bool location_reversing(std::uint64_t location) noexcept;
+			GC static shadow_call_stack::path_id location_path(std::uint64_t location) noexcept;
+			
+			sampling() noexcept;
+			// Copies start out detached, with their own id.
+			sampling(const sampling& other) noexcept;
+			sampling& operator=(const sampling& other) noexcept;
+			~sampling();
+			
+			// Read by the signal handler.
+			std::atomic<std::uint64_t> location;
+		
+		private:
+			static constexpr std::uint64_t valid_bit = std::uint64_t(1) << 63;
+			
+			std::uint32_t owner;
+			bool track = false;
+			shadow_call_stack stack;
+	};
+	
+	// Samples whichever sampling VM is attached to the running thread
+	// when SIGPROF arrives, driven by setitimer(ITIMER_PROF). The timer
+	// counts the whole process's CPU time, and the kernel delivers its
+	// signal to any thread, so signals landing on a thread with no VM
+	// attached, or one not yet stepped, take no sample and are counted
+	// as missed. Only one sample_profiler can run at a time.
+	class sample_profiler {
+		public:
+			struct sample {
+				std::uint32_t owner;
+				std::uint64_t location;
+			};
+			
+			// How often one PC was seen running in one direction.
+			struct pc_count {
+				register_value pc;
+				bool reversing;
+				std::uint64_t samples;
+			};
+			
+			// At most capacity samples are kept, and later ones are
+			// counted as dropped.
+			explicit sample_profiler(std::size_t capacity = 1 << 20);
+			sample_profiler(const sample_profiler&) = delete;
+			sample_profiler& operator=(const sample_profiler&) = delete;
+			~sample_profiler();
+			
+			// Starts sampling at frequency samples per second of CPU
+			// time. Returns false if timer signals aren't available,
+			// or another profiler is running.
+			bool start(unsigned int frequency);
+			// Stops sampling. Samples taken so far are kept.
+			void stop() noexcept;
+			// Forgets every sample.
+			void clear() noexcept;
+			
+			// Whether any sample_profiler is running.
+			static bool running_any() noexcept;
+			
+			// The number of samples kept, and dropped for lack of room.
+			GP std::size_t size() const noexcept;
+			GP std::uint64_t dropped() const noexcept;
+			// The number of signals that found no VM to sample.
+			GP std::uint64_t missed() const noexcept;
+			
+			// PCs sampled for one VM, most samples first.
+			std::vector<pc_count> histogram(const sampling& policy) const;
+			// Writes the histogram for one VM as a table.
+			void write_histogram(std::ostream& out, const sampling& policy) const;
+			// Writes one VM's samples in the folded stack format read
+			// by flamegraph.pl, rooted at the direction of execution.
+			void write_folded(std::ostream& out, const sampling& policy, const symbol_table* symbols = nullptr) const;
+			
+			// Called from the signal handler.
+			void take(std::uint32_t owner, std::uint64_t location) noexcept;
+			void miss() noexcept;
+		
+		private:
+			std::vector<sample> samples;
+			std::atomic<std::size_t> used;
+			std::atomic<std::uint64_t> drops;
+			std::atomic<std::uint64_t> misses;
+			bool running = false;
+			
+			// The samples kept, once sampling has stopped.
+			std::size_t kept() const noexcept;
+	};
+}
+
+#undef GP
+#undef GC
+
+inline bool metronome32::sampling::quick_record(const register_value pc, const bool reversing) noexcept
+{
+	if (track and sample_profiler::running_any()) {
+		return false;
+	}
+	
+	location.store(valid_bit | (std::uint64_t(reversing) << 32) | pc, std::memory_order_relaxed);
+	
+	return true;
+}
+
+inline void metronome32::sampling::record(const step_event& event, const context_data&) noexcept
+{
+	std::uint64_t path = 0;
+	
+	if (track) {
+		path = stack.path() & 0x3FFFFFFF;
+		stack.update(event);
+	}
+	
+	location.store(
+		valid_bit | (path << 33) | (std::uint64_t(event.reversing) << 32) | event.pc,
+		std::memory_order_relaxed
+	);
+}
+
+#endif
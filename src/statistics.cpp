@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <numeric>
+#include "statistics.h"
+namespace p32 = metronome32;
+
+using p32::statistics_snapshot;
+using p32::opcode_statistics;
+
+#define GP [[gnu::pure]]
+
+// Copies an array of atomic counters into an array of plain counts.
+template <class From, class To>
+static void load_all(const From& from, To& to) noexcept
+{
+	for (size_t i = 0; i < from.size(); i++) {
+		to[i] = from[i].load(std::memory_order_relaxed);
+	}
+}
+
+// Stores an array of plain counts into an array of atomic counters.
+template <class From, class To>
+static void store_all(const From& from, To& to) noexcept
+{
+	for (size_t i = 0; i < from.size(); i++) {
+		to[i].store(from[i], std::memory_order_relaxed);
+	}
+}
+
+GP statistics_snapshot::count_t statistics_snapshot::total_retired(const std::size_t direction) const noexcept
+{
+	return std::accumulate(
+		retired[direction].begin(),
+		retired[direction].end(),
+		count_t(0)
+	);
+}
+
+GP statistics_snapshot::count_t statistics_snapshot::not_taken(const std::size_t direction, const p32::opcode op) const noexcept
+{
+	const std::size_t i = static_cast<std::size_t>(op);
+	
+	return retired[direction][i] - taken[direction][i];
+}
+
+#undef GP
+
+statistics_snapshot opcode_statistics::snapshot() const noexcept
+{
+	statistics_snapshot snap;
+	
+	for (size_t dir = 0; dir < 2; dir++) {
+		load_all(retired[dir], snap.retired[dir]);
+		load_all(taken[dir], snap.taken[dir]);
+		load_all(errors[dir], snap.errors[dir]);
+	}
+	
+	load_all(dp_pushes, snap.dp_pushes);
+	load_all(dp_pops, snap.dp_pops);
+	load_all(pc_pushes, snap.pc_pushes);
+	load_all(pc_pops, snap.pc_pops);
+	
+	return snap;
+}
+
+void opcode_statistics::reset() noexcept
+{
+	*this = opcode_statistics();
+}
+
+opcode_statistics::opcode_statistics(const opcode_statistics& other) noexcept
+{
+	*this = other;
+}
+
+opcode_statistics& opcode_statistics::operator=(const opcode_statistics& other) noexcept
+{
+	const statistics_snapshot snap = other.snapshot();
+	
+	for (size_t dir = 0; dir < 2; dir++) {
+		store_all(snap.retired[dir], retired[dir]);
+		store_all(snap.taken[dir], taken[dir]);
+		store_all(snap.errors[dir], errors[dir]);
+	}
+	
+	store_all(snap.dp_pushes, dp_pushes);
+	store_all(snap.dp_pops, dp_pops);
+	store_all(snap.pc_pushes, pc_pushes);
+	store_all(snap.pc_pops, pc_pops);
+	
+	return *this;
+}
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "instruction.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_STATISTICS_H
+#define HEADER_P32_STATISTICS_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	// A plain copy of the counters kept by opcode_statistics. Arrays
+	// are indexed first by direction (forward or backward), then by
+	// opcode or context_error.
+	struct statistics_snapshot {
+		typedef std::uint64_t count_t;
+		typedef std::array<count_t, opcode_count> per_opcode_t;
+		typedef std::array<count_t, context_error_count> per_error_t;
+		
+		static constexpr std::size_t forward = 0;
+		static constexpr std::size_t backward = 1;
+		
+		// Instructions that executed successfully.
+		std::array<per_opcode_t, 2> retired = {};
+		// Retired instructions that didn't leave the PC at the next
+		// sequential address. For a branch run forward, this means it
+		// was taken. Backwards, only CF returning to a branch counts.
+		std::array<per_opcode_t, 2> taken = {};
+		// Instructions that stopped with an error, by error code.
+		std::array<per_error_t, 2> errors = {};
+		// Garbage stack traffic.
+		std::array<count_t, 2> dp_pushes = {};
+		std::array<count_t, 2> dp_pops = {};
+		std::array<count_t, 2> pc_pushes = {};
+		std::array<count_t, 2> pc_pops = {};
+		
+		// The number of retired instructions in a direction.
+		GP count_t total_retired(std::size_t direction) const noexcept;
+		// The number of times op retired without being taken.
+		GP count_t not_taken(std::size_t direction, opcode op) const noexcept;
+	};
+	
+	// A statistics policy keeping per-opcode and per-direction counts.
+	// Only the thread stepping the VM updates the counters, but
+	// snapshot() may be called from any thread.
+	class opcode_statistics {
+		public:
+			static constexpr bool enabled = true;
+			
+			void record(const step_event& event, const context_data& context) noexcept;
+			// Copies the current counters.
+			statistics_snapshot snapshot() const noexcept;
+			// Zeroes every counter.
+			void reset() noexcept;
+			
+			opcode_statistics() = default;
+			opcode_statistics(const opcode_statistics& other) noexcept;
+			opcode_statistics& operator=(const opcode_statistics& other) noexcept;
+			~opcode_statistics() = default;
+		
+		private:
+			typedef std::atomic<std::uint64_t> counter_t;
+			typedef std::array<counter_t, opcode_count> per_opcode_t;
+			typedef std::array<counter_t, context_error_count> per_error_t;
+			
+			std::array<per_opcode_t, 2> retired = {};
+			std::array<per_opcode_t, 2> taken = {};
+			std::array<per_error_t, 2> errors = {};
+			std::array<counter_t, 2> dp_pushes = {};
+			std::array<counter_t, 2> dp_pops = {};
+			std::array<counter_t, 2> pc_pushes = {};
+			std::array<counter_t, 2> pc_pops = {};
+			
+			// Increments a counter. There's a single writer, so
+			// this doesn't need an atomic read-modify-write.
+			static void bump(counter_t& counter) noexcept
+			{
+				counter.store(
+					counter.load(std::memory_order_relaxed) + 1,
+					std::memory_order_relaxed
+				);
+			}
+	};
+}
+
+#undef GP
+
+inline void metronome32::opcode_statistics::record(const step_event& event, const context_data&) noexcept
+{
+	const std::size_t dir = event.reversing ? 1 : 0;
+	
+	if (event.retired) {
+		const std::size_t op = static_cast<std::size_t>(event.op);
+		const register_value sequential = event.reversing ? event.pc : event.pc + 1;
+		bump(retired[dir][op]);
+		
+		if (event.next_pc != sequential) {
+			bump(taken[dir][op]);
+		}
+	} else {
+		bump(errors[dir][static_cast<std::size_t>(event.errcode)]);
+	}
+	
+	if (event.dp_delta > 0) {
+		bump(dp_pushes[dir]);
+	} else if (event.dp_delta < 0) {
+		bump(dp_pops[dir]);
+	}
+	
+	if (event.pc_delta > 0) {
+		bump(pc_pushes[dir]);
+	} else if (event.pc_delta < 0) {
+		bump(pc_pops[dir]);
+	}
+}
+
+#endif
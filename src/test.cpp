@@ -21,10 +21,35 @@ OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
 WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include "instruction.h"
 #include "memory.h"
 #include "vm.h"
+#include "statistics.h"
+#include "trace.h"
+#include "profile.h"
+#include "sampler.h"
+#include "counters.h"
+#include "corpus.h"
+#include "generator.h"
+#include "engine.h"
+#include "differential.h"
+#include "fuzz.h"
+#include "arena.h"
+#include "pool.h"
+#include "verifier.h"
+#include "cfg.h"
+#include "predecode.h"
+#include "tiering.h"
+#include "translator.h"
+#include "idioms.h"
 namespace m32 = metronome32;
 
 [[gnu::pure]] int test_instruction_conversions()
@@ -241,6 +266,1445 @@ int test_program1()
 	return 0;
 }
 
+// A policy taking a byte, to measure the default policy against.
+struct one_byte_statistics {
+	static constexpr bool enabled = false;
+	char byte;
+	
+	void record(const m32::step_event&, const m32::context_data&) noexcept {}
+};
+
+int test_statistics()
+{
+	typedef m32::statistics_snapshot snap_t;
+	typedef m32::opcode op;
+	
+	// The default policy must not cost any space.
+	if (sizeof(m32::vm) >= sizeof(m32::basic_vm<one_byte_statistics>)) return 1;
+	
+	m32::basic_vm<m32::opcode_statistics> my_vm(std::vector<m32::memory_value>({
+		m32::new_addi(0, 4),
+		m32::new_andi(1, 0),
+		m32::new_cf(),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -2),
+	}));
+	
+	while (my_vm.get_context().counter != 5)
+		if (not my_vm.step()) return 1;
+	
+	my_vm.reverse();
+	
+	while (my_vm.get_context().counter != 0)
+		if (not my_vm.step()) return 1;
+	
+	const snap_t snap = my_vm.statistics().snapshot();
+	const size_t fwd = snap_t::forward;
+	const size_t bwd = snap_t::backward;
+	
+	if (snap.retired[fwd][size_t(op::addi)] != 5) return 1;
+	if (snap.retired[fwd][size_t(op::bgtz)] != 4) return 1;
+	if (snap.taken[fwd][size_t(op::bgtz)] != 3) return 1;
+	if (snap.not_taken(fwd, op::bgtz) != 1) return 1;
+	if (snap.dp_pushes[fwd] != 1 or snap.dp_pops[bwd] != 1) return 1;
+	if (snap.pc_pushes[fwd] != 4 or snap.pc_pops[bwd] != 4) return 1;
+	if (snap.taken[bwd][size_t(op::cf)] != 3) return 1;
+	if (snap.total_retired(fwd) != 11) return 1;
+	
+	// Errors are counted, and reset() clears everything.
+	my_vm.set_context(m32::fresh_context({}));
+	my_vm.step();
+	
+	if (my_vm.statistics().snapshot().errors[fwd][size_t(m32::context_error::naidefault)] != 1)
+		return 1;
+	
+	my_vm.statistics().reset();
+	if (my_vm.statistics().snapshot().total_retired(fwd) != 0) return 1;
+	
+	return 0;
+}
+
+// A file in the temporary directory, deleted when this goes out of
+// scope, however the test using it returns.
+struct temporary_file {
+	std::string path;
+	
+	explicit temporary_file(const char* name)
+	{
+		const char* directory = std::getenv("TMPDIR");
+		path = std::string(directory != nullptr and *directory != '\0' ? directory : "/tmp") + "/" + name;
+	}
+	
+	temporary_file(const temporary_file&) = delete;
+	temporary_file& operator=(const temporary_file&) = delete;
+	
+	~temporary_file()
+	{
+		std::remove(path.c_str());
+	}
+};
+
+int test_trace()
+{
+	const temporary_file file("metronome32_test_trace.bin");
+	const char* path = file.path.c_str();
+	std::vector<m32::trace_record> records;
+	
+	{
+		m32::trace_writer writer(path, 1024);
+		m32::basic_vm<m32::tracing> my_vm(std::vector<m32::memory_value>({
+			m32::new_addi(0, 3),
+			m32::new_cf(),
+			m32::new_addi(0, -1),
+			m32::new_bgtz(0, -2),
+		}));
+		
+		if (not writer.is_open()) return 1;
+		my_vm.statistics().attach(writer.ring());
+		
+		while (my_vm.get_context().counter != 4)
+			if (not my_vm.step()) return 1;
+		
+		writer.stop();
+		
+		if (writer.ring().dropped() != 0) return 1;
+		if (writer.written() != 8) return 1;
+		if (not m32::read_trace(path, records)) return 1;
+	}
+	
+	if (records.size() != 8) return 1;
+	if (records[0].pc != 0) return 1;
+	if (records[0].op != static_cast<std::uint8_t>(m32::opcode::addi)) return 1;
+	if (not (records[0].flags & m32::trace_record::has_delta)) return 1;
+	if (records[0].reg != 0 or records[0].value != 3) return 1;
+	
+	return 0;
+}
+
+int test_garbage_profile()
+{
+	m32::basic_vm<m32::garbage_profiling> my_vm(std::vector<m32::memory_value>({
+		m32::new_addi(0, 4),
+		m32::new_addi(1, 10),
+		// Call FUNC, returning to the CF at 3.
+		m32::new_jal(31, 0x03),
+		m32::new_cf(),
+		m32::new_addi(0, 0),
+		// Function: FUNC
+		m32::new_cf(),
+		m32::new_andi(2, 0),
+		m32::new_add(2, 0),
+		m32::new_jr(31),
+	}));
+	
+	while (my_vm.get_context().counter != 4)
+		if (not my_vm.step()) return 1;
+	
+	const auto& profile = my_vm.statistics();
+	const auto sites = profile.sites();
+	
+	if (profile.calls().depth() != 0) return 1;
+	if (sites.size() != 3) return 1;
+	
+	for (const auto& site : sites) {
+		if (site.pc == 6 and site.dp_pushes != 1) return 1;
+		if (site.pc == 2 and site.path != m32::shadow_call_stack::root) return 1;
+		if (site.pc == 8 and profile.calls().entry(site.path) != 5) return 1;
+	}
+	
+	std::ostringstream folded;
+	profile.write_folded(folded);
+	if (folded.str().find("dp_stack;0x00000005;0x00000006 4\n") == std::string::npos)
+		return 1;
+	
+	// Undoing the return re-enters FUNC, and undoing the call leaves it.
+	my_vm.reverse();
+	my_vm.step();
+	if (profile.calls().depth() != 1) return 1;
+	
+	while (my_vm.get_context().counter != 0)
+		if (not my_vm.step()) return 1;
+	
+	if (profile.calls().depth() != 0) return 1;
+	
+	return 0;
+}
+
+int test_function_profile()
+{
+	const temporary_file file("metronome32_test_symbols.txt");
+	const char* path = file.path.c_str();
+	m32::basic_vm<m32::function_profiling> my_vm(std::vector<m32::memory_value>({
+		m32::new_addi(0, 2),
+		m32::new_jal(31, 0x03),
+		m32::new_cf(),
+		m32::new_addi(1, 0),
+		// Function: COUNTDOWN
+		m32::new_cf(),
+		m32::new_cf(),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -2),
+		m32::new_jr(31),
+	}));
+	
+	while (my_vm.get_context().counter != 3)
+		if (not my_vm.step()) return 1;
+	
+	my_vm.reverse();
+	
+	while (my_vm.get_context().counter != 0)
+		if (not my_vm.step()) return 1;
+	
+	const auto& profile = my_vm.statistics();
+	const auto functions = profile.functions();
+	
+	if (functions.size() != 1) return 1;
+	if (functions[0].entry != 4 or functions[0].calls != 1) return 1;
+	// CF, (ADDI, BGTZ) * 2 and JR.
+	if (functions[0].exclusive[profile.forward] != 6) return 1;
+	if (functions[0].inclusive[profile.forward] != 6) return 1;
+	if (profile.outside()[profile.forward] != 2) return 1;
+	if (profile.calls().depth() != 0) return 1;
+	
+	{
+		std::FILE* symbols = std::fopen(path, "w");
+		if (symbols == nullptr) return 1;
+		std::fputs("# entry points\n0x4 COUNTDOWN\n", symbols);
+		std::fclose(symbols);
+	}
+	
+	m32::symbol_table symbols;
+	if (not symbols.load(path)) return 1;
+	
+	std::ostringstream folded;
+	profile.write_folded(folded, &symbols);
+	if (folded.str().find("root;COUNTDOWN ") == std::string::npos) return 1;
+	
+	return 0;
+}
+
+int test_sampler()
+{
+	m32::basic_vm<m32::sampling> my_vm(std::vector<m32::memory_value>({
+		m32::new_cf(),
+		m32::new_addi(0, 1),
+		m32::new_bgtz(0, -2),
+	}));
+	m32::sample_profiler profiler;
+	
+	// Without a running profiler, even a VM following calls only
+	// publishes where it is.
+	m32::basic_vm<m32::sampling> caller(std::vector<m32::memory_value>({
+		m32::new_jal(31, 0x02),
+		m32::new_cf(),
+		m32::new_cf(),
+		m32::new_addi(0, 1),
+	}));
+	caller.statistics().attach(true);
+	if (not caller.step(2) or caller.statistics().calls().depth() != 0) return 1;
+	if (m32::sampling::location_pc(caller.statistics().location.load()) != 3) return 1;
+	caller.statistics().detach();
+	
+	my_vm.statistics().attach(true);
+	
+	// Timer signals may be unavailable, which isn't a failure.
+	if (not profiler.start(1000)) return 0;
+	
+	const auto deadline = std::clock() + 2 * CLOCKS_PER_SEC;
+	
+	while (profiler.size() == 0 and std::clock() < deadline)
+		for (int i = 0; i < 10000; i++)
+			if (not my_vm.step()) return 1;
+	
+	profiler.stop();
+	my_vm.statistics().detach();
+	
+	if (profiler.size() == 0) return 1;
+	
+	for (const auto& count : profiler.histogram(my_vm.statistics())) {
+		if (count.pc > 2 or count.reversing) return 1;
+	}
+	
+	std::ostringstream folded;
+	profiler.write_folded(folded, my_vm.statistics());
+	if (folded.str().compare(0, 8, "forward;") != 0) return 1;
+	
+	// Signals landing where no VM is attached are counted as missed.
+	profiler.clear();
+	if (not profiler.start(1000)) return 1;
+	volatile std::uint64_t spin = 0;
+	while (profiler.missed() == 0 and std::clock() < deadline + 2 * CLOCKS_PER_SEC)
+		spin = spin + 1;
+	profiler.stop();
+	if (profiler.missed() == 0 or profiler.size() != 0) return 1;
+	
+	return 0;
+}
+
+int test_counters()
+{
+	m32::vm my_vm(std::vector<m32::memory_value>({
+		m32::new_cf(),
+		m32::new_addi(0, 1),
+		m32::new_bgtz(0, -2),
+	}));
+	m32::hardware_counters counters;
+	m32::counter_report report;
+	
+	// Without counters every event is simply invalid.
+	const m32::counter_sample sample = m32::measure_steps(counters, my_vm, 30000);
+	if (sample.guest_instructions != 30000) return 1;
+	
+	for (std::size_t i = 0; i < m32::hardware_event_count; i++) {
+		const auto event = static_cast<m32::hardware_event>(i);
+		if (sample.valid[i] != counters.available(event)) return 1;
+		if ((sample.per_guest_instruction(event) < 0) == sample.valid[i]) return 1;
+	}
+	
+	report.add("reference", false, sample);
+	report.add("reference", false, sample);
+	const m32::counter_sample* row = report.find("reference", false);
+	if (row == nullptr or row->guest_instructions != 60000) return 1;
+	if (report.find("reference", true) != nullptr) return 1;
+	
+	std::ostringstream out;
+	const std::ios_base::fmtflags flags = out.flags();
+	report.write(out);
+	if (out.str().find("reference") == std::string::npos) return 1;
+	
+	// The stream's formatting is left as it was.
+	if (out.flags() != flags or out.precision() != 6) return 1;
+	
+	return 0;
+}
+
+int test_corpus()
+{
+	for (const m32::workload& work : m32::workload_corpus()) {
+		m32::vm my_vm;
+		my_vm.set_context(work.initial);
+		
+		while (my_vm.get_context().counter != work.end)
+			if (not my_vm.step()) return 1;
+		
+		if (not work.check(my_vm.get_context())) return 1;
+		
+		my_vm.reverse();
+		
+		while (my_vm.get_context().counter != 0)
+			if (not my_vm.step()) return 1;
+		
+		// Reversing must leave no garbage and undo every write.
+		const m32::context_data& context = my_vm.get_context();
+		if (context.registers != work.initial.registers) return 1;
+		if (not context.dp_stack.empty() or not context.pc_stack.empty()) return 1;
+		
+		for (const auto& word : context.sys_mem) {
+			if (word.second != m32::memory::read_word(work.initial.sys_mem, word.first)) return 1;
+		}
+	}
+	
+	return 0;
+}
+
+int test_generator()
+{
+	m32::generator_options options;
+	options.seed = 7;
+	options.instructions = 50000;
+	const m32::workload work = m32::generate_workload(options);
+	
+	if (m32::generate_workload(options).initial.sys_mem != work.initial.sys_mem) return 1;
+	options.seed = 8;
+	if (m32::generate_workload(options).initial.sys_mem == work.initial.sys_mem) return 1;
+	
+	// Every branch, taken or not, must target a CF.
+	for (const auto& word : work.initial.sys_mem) {
+		const m32::instruction instr = word.second;
+		
+		switch (m32::instr_to_opcode(instr)) {
+			case m32::opcode::beq: case m32::opcode::bne: case m32::opcode::bgez:
+			case m32::opcode::bgtz: case m32::opcode::blez: case m32::opcode::bltz: {
+				const auto offset = m32::instr_to_b(instr).offset.to_ulong();
+				const m32::register_value target = word.first + static_cast<std::int16_t>(offset);
+				const auto cf = m32::instr_to_j(m32::memory::read_word(work.initial.sys_mem, target));
+				if (not m32::is_cf(cf)) return 1;
+				break;
+			}
+			case m32::opcode::nai: return 1;
+			default: break;
+		}
+	}
+	
+	m32::vm my_vm;
+	my_vm.set_context(work.initial);
+	
+	while (my_vm.get_context().counter != work.end)
+		if (not my_vm.step()) return 1;
+	
+	my_vm.reverse();
+	
+	while (my_vm.get_context().counter != 0)
+		if (not my_vm.step()) return 1;
+	
+	if (my_vm.get_context().registers != work.initial.registers) return 1;
+	
+	return 0;
+}
+
+// A deliberately broken engine, which flips a bit of R9 whenever the
+// instruction at fault_pc leaves R0 equal to fault_r0.
+class faulty_engine : public m32::engine {
+	public:
+		faulty_engine(m32::register_value pc, m32::register_value r0) : fault_pc(pc), fault_r0(r0) {}
+		
+		const char* name() const noexcept override {return "faulty";}
+		void load(const m32::context_data& context) override {machine.set_context(context);}
+		const m32::context_data& context() noexcept override {return machine.get_context();}
+		void reverse(bool set_reverse) noexcept override {machine.reverse(set_reverse);}
+		
+		std::uint64_t run(std::uint64_t max_steps, m32::register_value stop_at) noexcept override
+		{
+			std::uint64_t steps = 0;
+			
+			while (steps < max_steps and machine.get_context().counter != stop_at) {
+				const m32::register_value pc = machine.get_context().counter;
+				if (not machine.step()) break;
+				steps++;
+				
+				if (pc == fault_pc and machine.get_context().registers[0] == fault_r0) {
+					m32::context_data broken = machine.get_context();
+					broken.registers[9] ^= 1;
+					machine.set_context(broken);
+				}
+			}
+			
+			return steps;
+		}
+	
+	private:
+		m32::vm machine;
+		m32::register_value fault_pc;
+		m32::register_value fault_r0;
+};
+
+int test_differential()
+{
+	m32::reference_engine reference;
+	m32::differential_options options;
+	options.interval = 1000;
+	options.deep_every = 4;
+	
+	if (m32::make_engine("no such engine") != nullptr) return 1;
+	
+	for (const std::string& name : m32::engine_names()) {
+		const auto engine = m32::make_engine(name);
+		if (engine == nullptr or engine->name() != name) return 1;
+		
+		for (const m32::workload& work : m32::workload_corpus()) {
+			const m32::divergence result = m32::run_differential(reference, *engine, work, options);
+			if (result.found or result.forward_steps == 0 or result.reverse_steps == 0) return 1;
+		}
+	}
+	
+	// Break the multiply loop's ADDI when it counts R0 down to 1000.
+	// That's instruction 12001: BLEZ and CF, then ADD, ADDI and BGTZ
+	// for each iteration, since BGTZ lands after the CF.
+	faulty_engine faulty(3, 1000);
+	const m32::workload work = m32::workload_corpus()[0];
+	const m32::divergence result = m32::run_differential(reference, faulty, work, options);
+	
+	if (not result.found or result.reversing) return 1;
+	if (result.step != 12000 or result.pc != 3) return 1;
+	if (result.diff.compare(0, 4, "r9: ") != 0) return 1;
+	
+	return 0;
+}
+
+int test_fuzz()
+{
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 40),
+		m32::new_addi(3, 0x1234),
+		m32::new_cf(),
+		m32::new_exchange(0, 3),
+		m32::new_exchange(0, 3),
+		m32::new_addi(3, 0x100),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+	};
+	std::vector<std::uint8_t> input = {m32::fuzz_harness::flag_reverse};
+	
+	for (const m32::memory_value word : program) {
+		for (int i = 0; i < 4; i++) input.push_back(word >> (8 * i));
+	}
+	
+	m32::fuzz_harness harness;
+	harness.run(input.data(), input.size());
+	const m32::context_data first = harness.machine().get_context();
+	const auto& coverage = harness.machine().statistics();
+	// Forward edges 0-1, 1-2, 2-3, 3-4, 4-5, 5-6, 6-7, 7-3, and 7-8 into
+	// the NAI after the program, then the reverse ones.
+	if (coverage.edges() < 9) return 1;
+	if (not first.reversing or first.counter != 0) return 1;
+	
+	harness.run(input.data(), input.size());
+	if (harness.machine().get_context().sys_mem != first.sys_mem) return 1;
+	if (harness.machine().get_context().registers != first.registers) return 1;
+	
+	// Resetting forgets the program and the 40 pages EXCHANGE wrote to.
+	harness.reset();
+	const m32::context_data& context = harness.machine().get_context();
+	if (not context.sys_mem.empty() or context.counter != 0 or context.reversing) return 1;
+	if (not context.dp_stack.empty() or not context.pc_stack.empty()) return 1;
+	if (context.registers != m32::register_context_t{}) return 1;
+	
+	return 0;
+}
+
+int test_memory_usage()
+{
+	m32::vm my_vm(std::vector<m32::memory_value>({
+		m32::new_addi(0, 200),
+		m32::new_addi(3, 0x1000),
+		m32::new_cf(),
+		m32::new_andi(1, -1),
+		m32::new_exchange(4, 3),
+		m32::new_addi(3, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+	}));
+	
+	m32::memory_footprint usage = my_vm.memory_usage();
+	if (usage.memory_words != 8 or usage.dp_entries != 0 or usage.pc_entries != 0) return 1;
+	if (usage.peak_memory_words != 8 or usage.total_bytes != usage.memory_bytes + usage.dp_bytes + usage.pc_bytes) return 1;
+	
+	while (my_vm.get_context().counter != 8)
+		if (not my_vm.step()) return 1;
+	
+	// Every iteration writes one new word and pushes an entry onto each
+	// garbage stack.
+	usage = my_vm.memory_usage();
+	if (usage.memory_words != 208 or usage.dp_entries != 200 or usage.pc_entries != 200) return 1;
+	if (usage.peak_dp_entries != 200 or usage.peak_pc_entries != 200) return 1;
+	const std::size_t forward_bytes = usage.total_bytes;
+	
+	my_vm.reverse();
+	while (my_vm.get_context().counter != 0)
+		if (not my_vm.step()) return 1;
+	
+	// Reversing empties the garbage stacks but the peaks stay.
+	usage = my_vm.memory_usage();
+	if (usage.dp_entries != 0 or usage.pc_entries != 0 or usage.total_bytes >= forward_bytes) return 1;
+	if (usage.peak_dp_entries != 200 or usage.peak_pc_entries != 200 or usage.peak_memory_words != 208) return 1;
+	if (usage.peak_bytes != forward_bytes) return 1;
+	
+	// The peaks belong to the context, so a fresh one starts over.
+	my_vm.set_context(m32::fresh_context({{0, m32::new_cf()}}));
+	usage = my_vm.memory_usage();
+	if (usage.peak_memory_words != 1 or usage.peak_dp_entries != 0 or usage.peak_pc_entries != 0) return 1;
+	
+	return 0;
+}
+
+int test_quota()
+{
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 100),
+		m32::new_addi(3, 0x1000),
+		m32::new_cf(),
+		m32::new_andi(1, -1),
+		m32::new_exchange(4, 3),
+		m32::new_addi(3, 0x100),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+	};
+	const auto run_with = [&program](const m32::resource_quota& limits) {
+		m32::vm my_vm(program);
+		my_vm.set_quota(limits);
+		while (my_vm.get_context().counter != 8 and my_vm.step()) {}
+		return my_vm;
+	};
+	
+	// No quota lets the program finish.
+	m32::vm done = run_with({});
+	if (done.halted() or done.get_context().counter != 8 or done.get_context().retired != 503) return 1;
+	
+	// The instruction quota stops the VM before the 11th instruction.
+	m32::resource_quota limits;
+	limits.instructions = 10;
+	m32::vm stopped = run_with(limits);
+	if (stopped.get_error_code() != m32::context_error::instruction_quota) return 1;
+	if (stopped.get_context().retired != 10 or stopped.get_context().counter != 5) return 1;
+	if (stopped.step()) return 1;
+	
+	// Every EXCHANGE writes a new page, and the 4th is refused.
+	limits = {};
+	limits.memory_pages = 3;
+	stopped = run_with(limits);
+	if (stopped.get_error_code() != m32::context_error::memory_quota) return 1;
+	if (stopped.get_context().sys_mem.size() != 11 or stopped.get_context().counter != 4) return 1;
+	
+	// The ANDI pushing a 6th entry retires, then the VM halts.
+	limits = {};
+	limits.dp_depth = 5;
+	stopped = run_with(limits);
+	if (stopped.get_error_code() != m32::context_error::dp_stack_quota) return 1;
+	if (stopped.get_context().dp_stack.size() != 6 or stopped.get_context().counter != 4) return 1;
+	
+	limits = {};
+	limits.pc_depth = 5;
+	stopped = run_with(limits);
+	if (stopped.get_error_code() != m32::context_error::pc_stack_quota) return 1;
+	if (stopped.get_context().pc_stack.size() != 6 or stopped.get_error_name() != "PC stack quota exceeded") return 1;
+	
+	return 0;
+}
+
+int test_arena()
+{
+	// Freed blocks are reused, and reset() hands the first chunk out
+	// again without asking the system for more.
+	m32::arena storage(4096);
+	void* const first = storage.allocate(40);
+	storage.deallocate(first, 40);
+	if (storage.allocate(33) != first or storage.used() != 48) return 1;
+	storage.allocate(10000);
+	const std::size_t capacity = storage.capacity();
+	storage.reset();
+	if (storage.allocate(16) != first or storage.used() != 16 or storage.capacity() != capacity) return 1;
+	
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 300),
+		m32::new_addi(3, 0x1000),
+		m32::new_cf(),
+		m32::new_andi(1, -1),
+		m32::new_exchange(4, 3),
+		m32::new_addi(3, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+	};
+	
+	// A VM in an arena runs the same as one on the heap.
+	m32::vm on_heap(program);
+	while (on_heap.get_context().counter != 8)
+		if (not on_heap.step()) return 1;
+	
+	m32::arena vm_storage;
+	m32::vm in_arena(vm_storage, program);
+	m32::resource_quota limits;
+	limits.dp_depth = 1000;
+	in_arena.set_quota(limits);
+	
+	for (int job = 0; job < 3; job++) {
+		while (in_arena.get_context().counter != 8)
+			if (not in_arena.step()) return 1;
+		
+		const m32::context_data& context = in_arena.get_context();
+		if (context.sys_mem != on_heap.get_context().sys_mem or context.registers != on_heap.get_context().registers) return 1;
+		if (context.dp_stack.size() != 300 or vm_storage.used() == 0) return 1;
+		
+		// Recycling empties the context in bulk and keeps its quota,
+		// and later jobs fit in the chunks the first one needed.
+		const std::size_t job_capacity = vm_storage.capacity();
+		in_arena.recycle();
+		if (not context.sys_mem.empty() or not context.dp_stack.empty() or context.counter != 0) return 1;
+		if (in_arena.get_quota().dp_depth != 1000 or vm_storage.capacity() != job_capacity) return 1;
+		in_arena.load_words(program.data(), program.size());
+	}
+	
+	// A copy of the VM is made on the heap, so recycling the original
+	// resets the arena and the copy is left alone.
+	{
+		const m32::vm copied = in_arena;
+		in_arena.recycle();
+		in_arena.load_words(program.data(), program.size());
+		while (in_arena.get_context().counter != 8)
+			if (not in_arena.step()) return 1;
+		
+		const m32::context_data& context = copied.get_context();
+		if (context.sys_mem.size() != program.size() or context.counter != 0 or not context.dp_stack.empty()) return 1;
+		for (m32::register_value address = 0; address < program.size(); address++) {
+			if (context.sys_mem.at(address) != program[address]) return 1;
+		}
+	}
+	
+	// So is a context copied out, even when the next program needs
+	// more of the arena than the last.
+	{
+		while (in_arena.get_context().counter != 8)
+			if (not in_arena.step()) return 1;
+		
+		const m32::context_data saved = in_arena.get_context();
+		if (saved.sys_mem.get_allocator().get_arena() != nullptr) return 1;
+		in_arena.recycle();
+		std::vector<m32::memory_value> larger = program;
+		larger.resize(program.size() * 64);
+		in_arena.load_words(larger.data(), larger.size());
+		
+		if (saved.sys_mem != on_heap.get_context().sys_mem or saved.registers != on_heap.get_context().registers) return 1;
+		if (saved.dp_stack.size() != 300 or saved.counter != 8) return 1;
+	}
+	
+	// Copying a context into the VM keeps it in the VM's arena.
+	in_arena.set_context(on_heap.get_context());
+	if (in_arena.get_context().sys_mem.get_allocator().get_arena() != &vm_storage) return 1;
+	
+	return 0;
+}
+
+int test_pool()
+{
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 50),
+		m32::new_addi(3, 0x1000),
+		m32::new_cf(),
+		m32::new_andi(1, -1),
+		m32::new_exchange(0, 3),
+		m32::new_exchange(0, 3),
+		m32::new_addi(3, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -6),
+	};
+	m32::vm_pool pool(2);
+	m32::resource_quota limits;
+	limits.instructions = 100000;
+	pool.set_quota(limits);
+	if (pool.size() != 2 or pool.idle() != 2) return 1;
+	
+	m32::vm* previous = nullptr;
+	
+	for (int job = 0; job < 4; job++) {
+		m32::vm& machine = pool.acquire(program.data(), program.size());
+		if (job > 0 and &machine != previous) return 1;
+		if (machine.get_quota().instructions != 100000 or machine.get_context().retired != 0) return 1;
+		
+		while (machine.get_context().counter != program.size())
+			if (not machine.step()) return 1;
+		
+		if (machine.get_context().dp_stack.size() != 50 or machine.get_context().sys_mem.size() != 59) return 1;
+		previous = &machine;
+		pool.release(machine);
+	}
+	
+	// Only a VM that is out is replaced by a new one.
+	m32::vm& first = pool.acquire();
+	m32::vm& second = pool.acquire();
+	m32::vm& third = pool.acquire(program.data(), program.size(), 1);
+	if (pool.size() != 3 or pool.idle() != 0 or &first == &second or &second == &third) return 1;
+	if (not first.get_context().sys_mem.empty() or third.get_context().counter != 1) return 1;
+	pool.release(first);
+	pool.release(second);
+	pool.release(third);
+	if (pool.idle() != 3) return 1;
+	
+	// A VM released with other contexts comes back with only its
+	// first, active and in its arena, even if the job removed it.
+	for (int job = 0; job < 2; job++) {
+		m32::vm& machine = pool.acquire(program.data(), program.size());
+		if (not machine.switch_to(machine.add_context())) return 1;
+		machine.load_words(program.data(), program.size());
+		if (job == 1 and not machine.remove_context(0)) return 1;
+		pool.release(machine);
+		m32::vm& again = pool.acquire();
+		if (&again != &machine or again.context_count() != 1 or again.active_context() != 0) return 1;
+		if (not again.get_context().sys_mem.empty() or again.get_context().sys_mem.get_allocator().get_arena() == nullptr) return 1;
+		pool.release(again);
+	}
+	
+	// A context copied out of a VM outlives its release, even when
+	// the next job needs more of the VM's arena.
+	{
+		m32::vm& machine = pool.acquire(program.data(), program.size());
+		while (machine.get_context().counter != program.size())
+			if (not machine.step()) return 1;
+		
+		const m32::context_data result = machine.get_context();
+		pool.release(machine);
+		std::vector<m32::memory_value> larger = program;
+		larger.resize(program.size() * 64);
+		m32::vm& next = pool.acquire(larger.data(), larger.size());
+		if (&next != &machine or next.get_context().sys_mem.size() != larger.size()) return 1;
+		
+		if (result.dp_stack.size() != 50 or result.sys_mem.size() != 59 or result.counter != program.size()) return 1;
+		for (m32::register_value address = 0; address < program.size(); address++) {
+			if (result.sys_mem.at(address) != program[address]) return 1;
+		}
+		pool.release(next);
+	}
+	
+	return 0;
+}
+
+int test_context_switching()
+{
+	const auto counting_loop = [](m32::register_value times) {
+		return m32::fresh_context({
+			{0, m32::new_addi(0, times)},
+			{1, m32::new_cf()},
+			{2, m32::new_addi(1, 1)},
+			{3, m32::new_addi(0, -1)},
+			{4, m32::new_bgtz(0, -3)},
+		});
+	};
+	m32::arena storage;
+	m32::vm my_vm(storage);
+	my_vm.set_context(counting_loop(100));
+	const m32::context_handle second = my_vm.add_context(counting_loop(200));
+	const m32::context_handle third = my_vm.add_context();
+	if (second != 1 or third != 2 or my_vm.context_count() != 3 or my_vm.active_context() != 0) return 1;
+	
+	// Time-slice the two loops until both finish.
+	bool done[2] = {false, false};
+	
+	while (not done[0] or not done[1]) {
+		for (const m32::context_handle handle : {m32::context_handle(0), second}) {
+			if (not my_vm.switch_to(handle)) return 1;
+			
+			for (int slice = 0; slice < 7 and my_vm.get_context().counter != 5; slice++)
+				if (not my_vm.step()) return 1;
+			
+			done[handle == second] = my_vm.get_context().counter == 5;
+		}
+	}
+	
+	if (not my_vm.switch_to(0) or my_vm.get_context().registers[1] != 100) return 1;
+	if (not my_vm.switch_to(second) or my_vm.get_context().registers[1] != 200) return 1;
+	
+	// The empty context is kept out of the arena, and the active
+	// context can't be removed.
+	if (not my_vm.switch_to(third) or not my_vm.get_context().sys_mem.empty()) return 1;
+	if (my_vm.get_context().sys_mem.get_allocator().get_arena() != nullptr) return 1;
+	if (my_vm.remove_context(third) or not my_vm.remove_context(second)) return 1;
+	if (my_vm.switch_to(second) or my_vm.context_count() != 2) return 1;
+	if (my_vm.add_context(counting_loop(1)) != second) return 1;
+	
+	// Copies of the VM copy the whole table.
+	m32::vm copy = my_vm;
+	if (copy.context_count() != 3 or copy.active_context() != third) return 1;
+	if (not copy.switch_to(0) or copy.get_context().registers[1] != 100) return 1;
+	if (not my_vm.switch_to(0) or &copy.get_context() == &my_vm.get_context()) return 1;
+	
+	// Recycling the first context leaves an added one alone.
+	const std::vector<m32::memory_value> words(200, m32::new_addi(1, 1));
+	const std::vector<m32::memory_value> others(200, m32::new_cf());
+	m32::arena shared;
+	m32::vm recycled(shared);
+	if (not recycled.switch_to(recycled.add_context())) return 1;
+	recycled.load_words(words.data(), words.size());
+	if (not recycled.switch_to(0)) return 1;
+	recycled.recycle();
+	recycled.load_words(others.data(), others.size());
+	if (not recycled.switch_to(1) or recycled.get_context().sys_mem.size() != 200) return 1;
+	for (m32::register_value address = 0; address < 200; address++) {
+		if (recycled.get_context().sys_mem.at(address) != words[address]) return 1;
+	}
+	
+	return 0;
+}
+
+int test_verifier()
+{
+	std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 3),
+		m32::new_addi(3, 200),
+		m32::new_cf(),
+		m32::new_addi(1, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -3),
+		m32::new_exchange(4, 3),
+	};
+	const m32::memory_value jump = m32::new_j(2);
+	m32::vm my_vm(program);
+	my_vm.load_words(&jump, 1, 256);
+	
+	// Page 1's J relies on the CF on page 0.
+	m32::verified_code proof(my_vm.get_context().sys_mem);
+	if (proof.pages() != 2 or not proof.rejected().empty()) return 1;
+	if (not proof.covers(5) or not proof.covers(256) or proof.covers(512)) return 1;
+	
+	while (my_vm.get_context().counter != 6)
+		if (not my_vm.step_verified(proof)) return 1;
+	
+	if (my_vm.get_context().registers[1] != 3 or my_vm.get_context().pc_stack.size() != 3) return 1;
+	
+	// The EXCHANGE writes address 200, withdrawing both pages.
+	if (not my_vm.step_verified(proof) or proof.pages() != 0 or proof.covers(256)) return 1;
+	proof.verify(my_vm.get_context().sys_mem);
+	proof.wrote(0x1000);
+	if (proof.pages() != 2) return 1;
+	
+	// A BGTZ landing on ADDI and an ADD of R2 to itself are rejected,
+	// and their page is still checked.
+	program[5] = m32::new_bgtz(0, -2);
+	m32::instr_type::r same = m32::instr_to_r(m32::new_add(2, 3));
+	same.rs = same.rsd;
+	program.push_back(m32::type_to_instr(same).to_ulong());
+	m32::vm checked(program);
+	proof.verify(checked.get_context().sys_mem);
+	if (proof.pages() != 0 or proof.rejected() != std::vector<m32::register_value>{5, 7}) return 1;
+	while (checked.step_verified(proof)) {}
+	if (checked.get_error_code() != m32::context_error::missing_cf or checked.get_context().counter != 5) return 1;
+	
+	// A stale proof is trusted, so the BGTZ lands after the ADDI.
+	proof.verify(my_vm.get_context().sys_mem);
+	m32::vm trusting(program);
+	if (not trusting.step_verified(proof, 6)) return 1;
+	if (trusting.get_context().counter != 4) return 1;
+	
+	return 0;
+}
+
+int test_cfg()
+{
+	typedef m32::edge_kind kind;
+	const m32::instructions_t image = {
+		{0, m32::new_addi(0, 3)},
+		{1, m32::new_cf()},
+		{2, m32::new_jal(31, 4)},
+		{3, m32::new_cf()},
+		{4, m32::new_addi(0, -1)},
+		{5, m32::new_bgtz(0, -4)},
+		{6, m32::new_cf()},
+		{7, m32::new_xori(2, 1)},
+		{8, m32::new_jr(31)},
+		{100, m32::new_j(1)},
+		{101, m32::new_beq(0, 0, -101)},
+	};
+	const m32::control_flow_graph graph(image);
+	const auto& blocks = graph.blocks();
+	const auto& edges = graph.edges();
+	
+	// Every CF is alone, and the BGTZ lands after the CF at 1.
+	const std::vector<std::pair<m32::register_value, m32::register_value>> spans = {
+		{0, 1}, {1, 1}, {2, 1}, {3, 1}, {4, 2}, {6, 1}, {7, 2}, {100, 1}, {101, 1},
+	};
+	if (blocks.size() != spans.size()) return 1;
+	
+	for (std::size_t b = 0; b < spans.size(); b++) {
+		if (blocks[b].start != spans[b].first or blocks[b].size != spans[b].second) return 1;
+	}
+	
+	// The JAL returns to the CF after it, the JR isn't resolved, and
+	// the BEQ targets an ADDI, so it only falls through.
+	const std::vector<std::tuple<std::size_t, std::size_t, kind>> expected = {
+		std::make_tuple(0, 1, kind::fallthrough),
+		std::make_tuple(1, 2, kind::fallthrough),
+		std::make_tuple(2, 6, kind::call),
+		std::make_tuple(2, 3, kind::fallthrough),
+		std::make_tuple(3, 4, kind::fallthrough),
+		std::make_tuple(4, 2, kind::branch),
+		std::make_tuple(4, 5, kind::fallthrough),
+		std::make_tuple(5, 6, kind::fallthrough),
+		std::make_tuple(6, m32::control_flow_graph::no_block, kind::indirect),
+		std::make_tuple(7, 2, kind::jump),
+	};
+	if (edges.size() != expected.size()) return 1;
+	
+	for (std::size_t e = 0; e < expected.size(); e++) {
+		if (std::make_tuple(edges[e].from, edges[e].to, edges[e].kind) != expected[e]) return 1;
+	}
+	
+	if (blocks[4].first_edge != 5 or blocks[4].edge_count != 2 or blocks[8].edge_count != 0) return 1;
+	if (graph.block_at(5) != 4 or graph.block_at(9) != graph.no_block or graph.block_at(101) != 8) return 1;
+	
+	// A generated program is covered by its blocks exactly.
+	m32::generator_options options;
+	options.body_items = 4096;
+	const m32::workload work = m32::generate_workload(options);
+	const m32::control_flow_graph generated(work.initial.sys_mem);
+	std::size_t words = 0;
+	
+	for (const m32::basic_block& block : generated.blocks()) {
+		if (generated.block_at(block.start + block.size - 1) != generated.block_at(block.start)) return 1;
+		words += block.size;
+	}
+	
+	if (words != work.initial.sys_mem.size() or generated.edges().size() < generated.blocks().size()) return 1;
+	
+	return 0;
+}
+
+int test_fusion()
+{
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(1, 3),
+		// A move, a loop head and a count down.
+		m32::new_andi(2, 0),
+		m32::new_add(2, 1),
+		m32::new_cf(),
+		m32::new_addi(4, 3),
+		m32::new_addi(2, -1),
+		m32::new_bgtz(2, -3),
+	};
+	const m32::system_memory_t memory = m32::vm(program).get_context().sys_mem;
+	m32::predecoded_code code;
+	const m32::predecoded_word& head = code.fetch(memory, 3);
+	if (head.forward != m32::fusion::loop_head or head.reverse != m32::fusion::none) return 1;
+	if (code.fetch(memory, 4).reverse != m32::fusion::loop_head) return 1;
+	if (code.fetch(memory, 300).op != m32::opcode::nai or code.pages() != 2) return 1;
+	
+	// Fused pairs retire as two instructions, in both directions.
+	m32::vm reference(program);
+	m32::vm fused(program);
+	code.clear();
+	while (reference.get_context().counter != 7)
+		if (not reference.step()) return 1;
+	if (fused.run_predecoded(code, UINT64_MAX, 7) != 13) return 1;
+	if (fused.get_context().registers != reference.get_context().registers) return 1;
+	if (fused.get_context().retired != reference.get_context().retired or fused.get_context().pc_stack.size() != 3) return 1;
+	if (fused.get_context().dp_stack.size() != 1 or fused.get_context().peak_dp_entries != 1) return 1;
+	
+	reference.reverse();
+	fused.reverse();
+	while (reference.get_context().counter != 0)
+		if (not reference.step()) return 1;
+	if (fused.run_predecoded(code, UINT64_MAX, 0) != 13 or fused.get_context().registers != reference.get_context().registers) return 1;
+	if (not fused.get_context().dp_stack.empty() or not fused.get_context().pc_stack.empty()) return 1;
+	
+	// A pair isn't fused across stop_at, max_steps or a quota.
+	m32::vm stopped(program);
+	if (stopped.run_predecoded(code, UINT64_MAX, 2) != 2 or stopped.get_context().counter != 2) return 1;
+	if (stopped.run_predecoded(code, 3, 7) != 3 or stopped.get_context().counter != 5) return 1;
+	m32::resource_quota limits;
+	limits.dp_depth = 0;
+	m32::vm limited(program);
+	limited.set_quota(limits);
+	if (limited.run_predecoded(code, UINT64_MAX, 7) != 2 or limited.get_error_code() != m32::context_error::dp_stack_quota) return 1;
+	
+	// EXCHANGE drops the page it writes, so the new ADDI runs.
+	m32::vm modified({
+		m32::new_addi(3, 4),
+		m32::new_exchange(5, 3),
+		m32::new_andi(6, 0),
+		m32::new_add(6, 1),
+		m32::new_addi(6, 1),
+	});
+	m32::context_data start = modified.get_context();
+	start.registers[5] = m32::new_addi(6, 7);
+	modified.set_context(start);
+	code.clear();
+	code.fetch(start.sys_mem, 0);
+	if (modified.run_predecoded(code, UINT64_MAX, 5) != 5 or modified.get_context().registers[6] != 7) return 1;
+	
+	return 0;
+}
+
+int test_inline_cache()
+{
+	// JALR calls the function at 8 three times, and JR returns.
+	const std::vector<m32::memory_value> program = {
+		m32::new_addi(0, 3),
+		m32::new_cf(),
+		m32::new_jalr(31, 5),
+		m32::new_cf(),
+		m32::new_addi(31, -3),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+		m32::new_j(11),
+		m32::new_cf(),
+		m32::new_addi(2, 1),
+		m32::new_jr(31),
+		m32::new_cf(),
+	};
+	m32::vm reference(program);
+	m32::vm cached(program);
+	m32::context_data start = reference.get_context();
+	start.registers[5] = 8;
+	reference.set_context(start);
+	cached.set_context(start);
+	m32::predecoded_code code;
+	while (reference.get_context().counter != 12)
+		if (not reference.step()) return 1;
+	if (cached.run_predecoded(code, UINT64_MAX, 12) != reference.get_context().retired) return 1;
+	if (cached.get_context().registers != reference.get_context().registers or cached.get_context().registers[2] != 3) return 1;
+	if (not code.knows_target(code.fetch(start.sys_mem, 2), 8) or not code.knows_target(code.fetch(start.sys_mem, 10), 3)) return 1;
+	reference.reverse();
+	cached.reverse();
+	while (reference.get_context().counter != 0)
+		if (not reference.step()) return 1;
+	if (cached.run_predecoded(code, UINT64_MAX, 0) * 2 != reference.get_context().retired) return 1;
+	if (cached.get_context().registers != reference.get_context().registers) return 1;
+	
+	// Learning a target splits its page, and writing that page, but
+	// not another, makes every site forget.
+	const m32::system_memory_t memory = m32::vm({m32::new_jr(1)}).get_context().sys_mem;
+	code.clear();
+	const m32::predecoded_word& site = code.fetch(memory, 0);
+	if (code.knows_target(site, 300)) return 1;
+	code.learn_target(site, 300, memory);
+	if (not code.knows_target(site, 300) or code.knows_target(site, 301) or code.pages() != 2) return 1;
+	code.wrote(0x5000);
+	if (not code.knows_target(site, 300)) return 1;
+	code.wrote(301);
+	if (code.knows_target(site, 300) or code.pages() != 1) return 1;
+	
+	// The function at 256 overwrites its own CF, so the second call,
+	// which its site has seen succeed, stops.
+	m32::vm clobbered({
+		m32::new_addi(0, 2),
+		m32::new_cf(),
+		m32::new_jalr(31, 5),
+		m32::new_cf(),
+		m32::new_addi(31, -3),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -5),
+	});
+	start = clobbered.get_context();
+	m32::memory::write_word(start.sys_mem, 256, m32::new_cf());
+	m32::memory::write_word(start.sys_mem, 257, m32::new_exchange(4, 3));
+	m32::memory::write_word(start.sys_mem, 258, m32::new_jr(31));
+	start.registers[3] = 256;
+	start.registers[4] = m32::new_addi(7, 0);
+	start.registers[5] = 256;
+	clobbered.set_context(start);
+	code.clear();
+	clobbered.run_predecoded(code, UINT64_MAX, 7);
+	if (clobbered.get_error_code() != m32::context_error::missing_cf or clobbered.get_context().counter != 2) return 1;
+	
+	return 0;
+}
+
+// Runs a program to stop_at and back to 0 on the reference VM and with
+// native blocks, returning whether they agree at both ends.
+static bool native_agrees(const m32::context_data& start, const m32::register_value stop_at, m32::native_code& native)
+{
+	m32::vm reference;
+	m32::vm compiled;
+	m32::predecoded_code code;
+	reference.set_context(start);
+	compiled.set_context(start);
+	
+	for (int pass = 0; pass < 2; pass++) {
+		const m32::register_value until = pass == 0 ? stop_at : 0;
+		
+		while (reference.get_context().counter != until)
+			if (not reference.step()) return false;
+		compiled.run_predecoded(code, UINT64_MAX, until, &native);
+		const m32::context_data& a = reference.get_context();
+		const m32::context_data& b = compiled.get_context();
+		if (a.counter != b.counter or a.registers != b.registers or a.retired != b.retired) return false;
+		if (a.dp_stack != b.dp_stack or a.pc_stack != b.pc_stack or a.peak_dp_entries != b.peak_dp_entries) return false;
+		
+		reference.reverse();
+		compiled.reverse();
+	}
+	
+	return true;
+}
+
+int test_jit()
+{
+	// Every ALU instruction that decodes, forward and in reverse: OR
+	// never does.
+	m32::context_data alu = m32::vm({
+		m32::new_addi(1, 5),
+		m32::new_add(2, 1),
+		m32::new_sub(3, 2),
+		m32::new_xor(4, 1),
+		m32::new_xori(5, -7),
+		m32::new_neg(6, 0),
+		m32::new_rl(7, 3),
+		m32::new_rr(8, 29),
+		m32::new_rlv(9, 1),
+		m32::new_rrv(10, 1),
+		m32::new_and(11, 1),
+		m32::new_andi(12, 0x1F0F),
+		m32::new_sub(13, 2),
+		m32::new_ori(14, -2),
+		m32::new_nor(15, 3),
+		m32::new_sll(16, 4),
+		m32::new_srl(17, 5),
+		m32::new_sra(18, 31),
+		m32::new_sllv(19, 1),
+		m32::new_srlv(20, 1),
+		m32::new_srav(21, 1),
+		m32::new_slt(22, 18),
+		m32::new_slti(23, -3),
+	}).get_context();
+	for (unsigned int r = 0; r < 32; r++)
+		alu.registers[r] = 0x9E3779B9U * (r + 1);
+	m32::native_code native;
+	if (not native_agrees(alu, 23, native)) return 1;
+	if (m32::native_code::available() and native.blocks() != 2) return 1;
+	
+	// A loop runs natively until its branch falls through, or until
+	// max_steps would be passed.
+	m32::context_data loop = m32::vm({
+		m32::new_cf(),
+		m32::new_add(2, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -3),
+	}).get_context();
+	loop.registers[0] = 1000;
+	loop.registers[1] = 7;
+	native.clear();
+	if (not native_agrees(loop, 4, native)) return 1;
+	m32::vm reference;
+	m32::vm compiled;
+	m32::predecoded_code code;
+	reference.set_context(loop);
+	compiled.set_context(loop);
+	for (int i = 0; i < 100; i++)
+		if (not reference.step()) return 1;
+	if (compiled.run_predecoded(code, 100, 4, &native) != 100) return 1;
+	if (compiled.get_context().counter != reference.get_context().counter or compiled.get_context().registers != reference.get_context().registers) return 1;
+	
+	// A reverse block stops where the datapath stack runs out.
+	m32::context_data empty = m32::vm({
+		m32::new_andi(1, 3),
+		m32::new_andi(2, 3),
+		m32::new_andi(3, 3),
+		m32::new_andi(4, 3),
+	}).get_context();
+	empty.counter = 4;
+	empty.reversing = true;
+	empty.dp_stack.push(9);
+	m32::vm stranded;
+	stranded.set_context(empty);
+	code.clear();
+	if (stranded.run_predecoded(code, UINT64_MAX, 0, &native) != 1) return 1;
+	if (stranded.get_error_code() != m32::context_error::dp_stack_empty or stranded.get_context().counter != 3) return 1;
+	if (stranded.get_context().registers[4] != 9) return 1;
+	
+	// Writing a page drops its blocks.
+	const std::size_t held = native.blocks();
+	native.wrote(0x5000);
+	if (native.blocks() != held) return 1;
+	native.wrote(2);
+	if (native.blocks() != 0) return 1;
+	
+	// Its code is unmapped or reused, however often the page is
+	// compiled and written again.
+	m32::predecoded_code rewritten;
+	std::uint32_t words = 0;
+	for (int round = 0; round < 2000; round++) {
+		if (m32::native_code::available() and native.block(rewritten, alu.sys_mem, 0, false, words) == nullptr) return 1;
+		if (native.mapped() > 64 * 1024) return 1;
+		native.wrote(0);
+	}
+	if (native.blocks() != 0) return 1;
+	
+	// Nothing is compiled for a sealed code, which only finds the
+	// blocks adopted from elsewhere.
+	code.seal(true);
+	if (native.block(code, alu.sys_mem, 0, false, words) != nullptr or native.blocks() != 0) return 1;
+	
+	return 0;
+}
+
+int test_tiering()
+{
+	// A hot loop is interpreted until its page is compiled, then runs
+	// compiled, ending where the reference does in both directions.
+	m32::context_data loop = m32::vm({
+		m32::new_cf(),
+		m32::new_add(2, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -3),
+	}).get_context();
+	loop.registers[0] = 1000000;
+	loop.registers[1] = 7;
+	m32::tiered_engine tiered(8);
+	m32::reference_engine reference;
+	tiered.load(loop);
+	reference.load(loop);
+	while (tiered.compiled().pages() == 0) {
+		if (tiered.context().counter == 4) return 1;
+		tiered.run(50, 4);
+		std::this_thread::yield();
+	}
+	if (tiered.tiers().promoted() != 1) return 1;
+	
+	for (int pass = 0; pass < 2; pass++) {
+		const m32::register_value until = pass == 0 ? 4 : 0;
+		tiered.run(UINT64_MAX, until);
+		reference.run(UINT64_MAX, until);
+		const m32::context_data& a = reference.context();
+		const m32::context_data& b = tiered.context();
+		if (a.counter != until or b.counter != until or a.registers != b.registers) return 1;
+		if (a.retired != b.retired or a.dp_stack != b.dp_stack or a.pc_stack != b.pc_stack) return 1;
+		tiered.reverse(true);
+		reference.reverse(true);
+	}
+	
+	// A short job never promotes anything.
+	m32::tiered_engine cold;
+	loop.registers[0] = 100;
+	cold.load(loop);
+	if (cold.run(UINT64_MAX, 4) != 301) return 1;
+	if (cold.tiers().promoted() != 0 or cold.compiled().pages() != 0) return 1;
+	
+	// Loading the program again keeps its page, and it runs compiled
+	// from the start. Another program's memory drops it.
+	tiered.load(loop);
+	if (tiered.compiled().pages() != 1) return 1;
+	if (tiered.run(UINT64_MAX, 4) != 301 or tiered.context().registers[2] != 700) return 1;
+	loop.sys_mem[2] = m32::new_addi(0, -2);
+	tiered.load(loop);
+	if (tiered.compiled().pages() != 0) return 1;
+	
+	// A loop writing its own page backs off from compiling it again
+	// each time, and the code of the pages it drops is unmapped.
+	m32::context_data writer = m32::vm({
+		m32::new_cf(),
+		m32::new_addi(5, 1),
+		m32::new_addi(6, 2),
+		m32::new_addi(7, 3),
+		m32::new_addi(8, 4),
+		m32::new_exchange(4, 3),
+		m32::new_exchange(4, 3),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -8),
+	}).get_context();
+	writer.registers[0] = 200000;
+	writer.registers[3] = 0x40;
+	m32::tiered_engine rewriting(8);
+	rewriting.load(writer);
+	while (rewriting.context().counter != 9) {
+		rewriting.run(1000, 9);
+		if (rewriting.native_blocks().mapped() > 64 * 1024) return 1;
+	}
+	if (rewriting.tiers().promoted() > 40 or rewriting.context().retired != 1600001) return 1;
+	
+	return 0;
+}
+
+int test_translator()
+{
+	// step_context() runs a context exactly as a VM does, both ways.
+	m32::context_data loop = m32::vm({
+		m32::new_cf(),
+		m32::new_add(2, 1),
+		m32::new_addi(0, -1),
+		m32::new_bgtz(0, -3),
+	}).get_context();
+	loop.registers[0] = 5;
+	loop.registers[1] = 7;
+	m32::vm reference;
+	reference.set_context(loop);
+	m32::context_data stepped = loop;
+	for (int pass = 0; pass < 2; pass++) {
+		const m32::register_value until = pass == 0 ? 4 : 0;
+		while (reference.get_context().counter != until) {
+			if (not reference.step() or not m32::step_context(stepped)) return 1;
+		}
+		if (stepped.counter != until or stepped.registers != reference.get_context().registers) return 1;
+		if (stepped.retired != reference.get_context().retired or stepped.pc_stack != reference.get_context().pc_stack) return 1;
+		reference.reverse();
+		stepped.reversing = true;
+	}
+	stepped.halted = true;
+	if (m32::step_context(stepped)) return 1;
+	
+	// The loop's body becomes a case that loops within itself, and the
+	// unit lists the program.
+	std::ostringstream out;
+	m32::translate(out, {{"counted-loop", loop.sys_mem}});
+	const std::string unit = out.str();
+	if (unit.find("std::uint64_t translated_counted_loop(") == std::string::npos) return 1;
+	if (unit.find("case 0x1U:") == std::string::npos or unit.find("do {") == std::string::npos) return 1;
+	if (unit.find("{\"counted-loop\", &translated_counted_loop}") == std::string::npos) return 1;
+	
+	return 0;
+}
+
+int test_idioms()
+{
+	// Runs the reference and idiom engines from a context to until, in
+	// runs of at most chunk instructions and no more than limit in all,
+	// and then back to 0, and returns whether they agree all the way.
+	const auto agree = [](const m32::context_data& from, const m32::register_value until, const std::uint64_t chunk, const std::uint64_t limit = UINT64_MAX) {
+		m32::reference_engine reference;
+		m32::idiom_engine idioms;
+		reference.load(from);
+		idioms.load(from);
+		for (int pass = 0; pass < 2; pass++) {
+			const m32::register_value stop_at = pass == 0 ? until : 0;
+			std::uint64_t a = 0;
+			std::uint64_t b = 0;
+			std::uint64_t total = 0;
+			do {
+				a = reference.run(chunk, stop_at);
+				b = idioms.run(chunk, stop_at);
+				const m32::context_data& x = reference.context();
+				const m32::context_data& y = idioms.context();
+				if (a != b or x.counter != y.counter or x.registers != y.registers or x.retired != y.retired) return false;
+				if (x.pc_stack != y.pc_stack or x.dp_stack != y.dp_stack or x.peak_pc_entries != y.peak_pc_entries) return false;
+				total += a;
+			} while (a == chunk and total < limit);
+			reference.reverse(true);
+			idioms.reverse(true);
+		}
+		return true;
+	};
+	
+	// MULTIPLY's loop is found in program1, entered forward after its
+	// CF, and in reverse after or at its branch.
+	m32::context_data multiply = m32::vm({
+		m32::new_addi(0, 4),
+		m32::new_addi(1, 10),
+		m32::new_jal(31, 0x02),
+		m32::new_cf(),
+		m32::new_cf(),
+		m32::new_andi(2, 0),
+		m32::new_add(2, 0),
+		m32::new_andi(0, 0),
+		m32::new_beq(0, 1, +6),
+		m32::new_blez(2, +5),
+		m32::new_cf(),
+		m32::new_add(0, 1),
+		m32::new_addi(2, -1),
+		m32::new_bgtz(2, -3),
+		m32::new_cf(),
+		m32::new_jr(31),
+	}).get_context();
+	const m32::loop_idioms found(multiply.sys_mem);
+	if (found.loops() != 1 or found.at(11, false) == nullptr or found.at(12, false) != nullptr) return 1;
+	if (found.at(14, true) == nullptr or found.at(13, true) == nullptr or found.at(11, true) != nullptr) return 1;
+	if (found.at(11, false)->body.size() != 2 or found.at(11, false)->tested != 2) return 1;
+	if (not agree(multiply, 15, UINT64_MAX)) return 1;
+	
+	// A division by repeated subtraction, run whole, in small chunks,
+	// and with the counter stopped inside it. Its PC stack holds the
+	// branch once for every pass after the first.
+	m32::context_data divide = m32::vm({
+		m32::new_cf(),
+		m32::new_sub(0, 1),
+		m32::new_addi(2, 1),
+		m32::new_bgez(0, -3),
+	}).get_context();
+	divide.registers[0] = 1000;
+	divide.registers[1] = 7;
+	if (not agree(divide, 4, UINT64_MAX) or not agree(divide, 4, 5) or not agree(divide, 2, UINT64_MAX)) return 1;
+	m32::idiom_engine whole;
+	whole.load(divide);
+	if (whole.run(UINT64_MAX, 4) != 1 + 143 * 3 or whole.context().registers[2] != 143) return 1;
+	if (whole.context().pc_stack.size() != 143 or whole.context().pc_stack.top() != 3) return 1;
+	
+	// A loop that never ends, or only ends by wrapping, is left to
+	// stepping, as is one whose tested register counts up from below.
+	divide.registers[1] = 0;
+	if (not agree(divide, 4, 100, 1000)) return 1;
+	divide.registers[1] = -7;
+	if (not agree(divide, 4, 100, 1000)) return 1;
+	divide.sys_mem[3] = m32::new_bltz(0, -3);
+	divide.registers[0] = -1000;
+	if (not agree(divide, 4, UINT64_MAX)) return 1;
+	
+	// A body that adds a register it writes isn't a counted loop, and
+	// a write to a loop's page drops it.
+	divide.sys_mem[2] = m32::new_add(1, 0);
+	if (m32::loop_idioms(divide.sys_mem).loops() != 0) return 1;
+	m32::loop_idioms written(multiply.sys_mem);
+	written.wrote(0x100);
+	if (written.loops() != 1) return 1;
+	written.wrote(12);
+	if (written.loops() != 0) return 1;
+	
+	return 0;
+}
+
 int main()
 {
 	int success = 0;
@@ -250,6 +1714,29 @@ int main()
 	success |= test_context();
 	success |= test_vm();
 	success |= test_program1();
+	success |= test_statistics();
+	success |= test_trace();
+	success |= test_garbage_profile();
+	success |= test_function_profile();
+	success |= test_sampler();
+	success |= test_counters();
+	success |= test_corpus();
+	success |= test_generator();
+	success |= test_differential();
+	success |= test_fuzz();
+	success |= test_memory_usage();
+	success |= test_quota();
+	success |= test_arena();
+	success |= test_pool();
+	success |= test_context_switching();
+	success |= test_verifier();
+	success |= test_cfg();
+	success |= test_fusion();
+	success |= test_inline_cache();
+	success |= test_jit();
+	success |= test_tiering();
+	success |= test_translator();
+	success |= test_idioms();
 	
 	return success == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
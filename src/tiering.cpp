@@ -0,0 +1,273 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "cfg.h"
+#include "tiering.h"
+
+namespace p32 = metronome32;
+
+using p32::basic_block;
+using p32::native_code;
+using p32::predecoded_code;
+using p32::register_value;
+using p32::system_memory_t;
+using p32::tier_manager;
+
+#define GP [[gnu::pure]]
+
+constexpr std::uint32_t tier_manager::default_threshold;
+
+// A page written again and again waits at most this many doublings of
+// the threshold.
+constexpr std::uint32_t max_rewrites = 10;
+
+tier_manager::tier_manager(const std::uint32_t hot)
+	: threshold(std::max<std::uint32_t>(hot, 1)), finished_count(0)
+{
+}
+
+tier_manager::~tier_manager()
+{
+	stop();
+}
+
+void tier_manager::entered(const system_memory_t& memory, const predecoded_code& code, const register_value address)
+{
+	std::uint32_t& count = hits[address];
+	
+	if (count < threshold) {
+		count++;
+		
+		if (count < threshold) {
+			return;
+		}
+	}
+	
+	const register_value number = memory::page_of(address);
+	
+	if (code.holds(address) or in_flight.count(number) != 0) {
+		return;
+	}
+	
+	// An installed page code doesn't hold was dropped on a write.
+	const auto stale = installed.find(number);
+	
+	if (stale != installed.end()) {
+		installed.erase(stale);
+		rewritten(number);
+	}
+	
+	const auto waiting = written.find(number);
+	
+	if (waiting != written.end() and waiting->second.wait != 0) {
+		waiting->second.wait--;
+		
+		return;
+	}
+	
+	in_flight.insert(number);
+	std::unique_ptr<job> next(new job());
+	next->number = number;
+	const register_value first = number << memory::page_bits;
+	
+	for (auto word = memory.lower_bound(first); word != memory.end() and memory::page_of(word->first) == number; ++word) {
+		next->words.insert(next->words.end(), *word);
+	}
+	
+	{
+		std::lock_guard<std::mutex> held(lock);
+		next->epoch = epoch;
+		pending.push_back(std::move(next));
+	}
+	
+	promotions++;
+	
+	if (not compiler.joinable()) {
+		compiler = std::thread(&tier_manager::compile_pages, this);
+	}
+	
+	wake.notify_one();
+}
+
+bool tier_manager::ready() const noexcept
+{
+	return finished_count.load(std::memory_order_acquire) != 0;
+}
+
+// Returns whether memory holds exactly the words copied for a page.
+GP static bool matches(const system_memory_t& memory, const system_memory_t& words, const register_value number)
+{
+	auto word = memory.lower_bound(number << p32::memory::page_bits);
+	
+	for (const auto& copied : words) {
+		if (word == memory.end() or *word != copied) {
+			return false;
+		}
+		
+		++word;
+	}
+	
+	return word == memory.end() or p32::memory::page_of(word->first) != number;
+}
+
+std::size_t tier_manager::install(const system_memory_t& memory, predecoded_code& code, native_code& native)
+{
+	std::deque<std::unique_ptr<job>> done;
+	
+	{
+		std::lock_guard<std::mutex> held(lock);
+		done.swap(finished);
+		finished_count.store(0, std::memory_order_release);
+	}
+	
+	std::size_t count = 0;
+	
+	for (const std::unique_ptr<job>& compiled : done) {
+		in_flight.erase(compiled->number);
+		
+		if (matches(memory, compiled->words, compiled->number)) {
+			code.adopt(compiled->code);
+			native.adopt(compiled->native);
+			installed[compiled->number] = std::move(compiled->words);
+			count++;
+		} else {
+			rewritten(compiled->number);
+		}
+	}
+	
+	return count;
+}
+
+std::size_t tier_manager::revalidate(const system_memory_t& memory, predecoded_code& code, native_code& native)
+{
+	for (auto page = installed.begin(); page != installed.end();) {
+		const register_value first = page->first << memory::page_bits;
+		
+		// A page written since it was installed isn't held any more.
+		if (code.holds(first) and matches(memory, page->second, page->first)) {
+			++page;
+		} else {
+			if (not code.holds(first)) {
+				rewritten(page->first);
+			}
+			
+			code.wrote(first);
+			native.wrote(first);
+			page = installed.erase(page);
+		}
+	}
+	
+	return installed.size();
+}
+
+void tier_manager::clear() noexcept
+{
+	{
+		std::lock_guard<std::mutex> held(lock);
+		pending.clear();
+		finished.clear();
+		finished_count.store(0, std::memory_order_relaxed);
+		epoch++;
+	}
+	
+	hits.clear();
+	in_flight.clear();
+	installed.clear();
+	written.clear();
+	promotions = 0;
+}
+
+GP std::size_t tier_manager::promoted() const noexcept
+{
+	return promotions;
+}
+
+void tier_manager::rewritten(const register_value number) noexcept
+{
+	backoff& held = written[number];
+	held.rewrites = std::min(held.rewrites + 1, max_rewrites);
+	held.wait = std::uint64_t(threshold) << held.rewrites;
+}
+
+void tier_manager::compile_pages() noexcept
+{
+	for (;;) {
+		std::unique_ptr<job> next;
+		
+		{
+			std::unique_lock<std::mutex> held(lock);
+			wake.wait(held, [this]() {return stopping or not pending.empty();});
+			
+			if (stopping) {
+				return;
+			}
+			
+			next = std::move(pending.front());
+			pending.pop_front();
+		}
+		
+		// Native blocks start at each block, and in reverse, at each
+		// block's end.
+		const register_value first = next->number << memory::page_bits;
+		next->code.fetch(next->words, first);
+		const control_flow_graph graph(next->words);
+		std::uint32_t words = 0;
+		
+		for (const basic_block& block : graph.blocks()) {
+			next->native.block(next->code, next->words, block.start, false, words);
+			next->native.block(next->code, next->words, block.start + block.size, true, words);
+		}
+		
+		// Each job's blocks are installed for good, so they shouldn't
+		// keep a whole chunk mapped.
+		next->native.pack();
+		
+		{
+			std::lock_guard<std::mutex> held(lock);
+			
+			if (next->epoch == epoch) {
+				finished.push_back(std::move(next));
+				finished_count.fetch_add(1, std::memory_order_release);
+			}
+		}
+	}
+}
+
+void tier_manager::stop() noexcept
+{
+	if (not compiler.joinable()) {
+		return;
+	}
+	
+	{
+		std::lock_guard<std::mutex> held(lock);
+		stopping = true;
+	}
+	
+	wake.notify_all();
+	compiler.join();
+	stopping = false;
+}
+
+#undef GP
@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include "jit.h"
+#include "memory.h"
+#include "predecode.h"
+
+#ifndef HEADER_P32_TIERING_H
+#define HEADER_P32_TIERING_H
+
+#define GP [[gnu::pure]]
+
+namespace metronome32 {
+	// Decides which pages of a guest are hot enough to compile, and
+	// compiles them on a background thread. Entries into each basic
+	// block are counted, and once a block has been entered threshold
+	// times, its page is copied and queued. The thread predecodes the
+	// copy and compiles native blocks at every basic block in it, and
+	// install() moves the results into the caller's code at a point of
+	// its choosing, if the page still matches memory. The thread is only
+	// started by the first page queued, so a guest with nothing hot pays
+	// for its counters and nothing else. Counts and installed pages
+	// outlive a guest, so a program run again and again as short jobs
+	// still reaches its compiled pages. A page written after it was
+	// installed waits twice as many entries as the last time before it
+	// is queued again, so a page that keeps writing itself settles in
+	// the interpreter instead of being compiled over and over.
+	class tier_manager {
+		public:
+			static constexpr std::uint32_t default_threshold = 1000;
+			
+			explicit tier_manager(std::uint32_t threshold = default_threshold);
+			tier_manager(const tier_manager&) = delete;
+			tier_manager& operator=(const tier_manager&) = delete;
+			// Stops the thread, dropping pages it hasn't compiled.
+			~tier_manager();
+			
+			// Counts an entry into the basic block whose first word is at
+			// address, queueing its page once the block is hot, unless
+			// code already holds it or it is queued.
+			void entered(const system_memory_t& memory, const predecoded_code& code, register_value address);
+			// Returns whether compiled pages are waiting for install().
+			bool ready() const noexcept;
+			// Moves every compiled page that still matches memory into
+			// code and native, and returns how many were. A page that
+			// doesn't match is counted again.
+			std::size_t install(const system_memory_t& memory, predecoded_code& code, native_code& native);
+			// Drops every installed page that memory no longer matches,
+			// as after loading another guest, and returns how many are
+			// kept.
+			std::size_t revalidate(const system_memory_t& memory, predecoded_code& code, native_code& native);
+			// Forgets every count and page. A page the thread is
+			// compiling is dropped once it is done.
+			void clear() noexcept;
+			// The number of pages queued so far.
+			GP std::size_t promoted() const noexcept;
+		
+		private:
+			// A page copied from memory, and what the thread makes of it.
+			struct job {
+				std::uint64_t epoch;
+				register_value number;
+				system_memory_t words;
+				predecoded_code code;
+				native_code native;
+			};
+			
+			std::uint32_t threshold;
+			std::unordered_map<register_value, std::uint32_t> hits;
+			// Pages queued and not yet installed or dropped.
+			std::unordered_set<register_value> in_flight;
+			std::size_t promotions = 0;
+			// The words each installed page was compiled from.
+			std::unordered_map<register_value, system_memory_t> installed;
+			// How often each page has been written after it was
+			// compiled, and how many more entries it waits before it is
+			// queued again.
+			struct backoff {
+				std::uint32_t rewrites = 0;
+				std::uint64_t wait = 0;
+			};
+			std::unordered_map<register_value, backoff> written;
+			
+			// Guards pending, finished, epoch and stopping.
+			std::mutex lock;
+			std::condition_variable wake;
+			std::deque<std::unique_ptr<job>> pending;
+			std::deque<std::unique_ptr<job>> finished;
+			// Bumped by clear(), so that jobs from before are dropped.
+			std::uint64_t epoch = 0;
+			bool stopping = false;
+			std::atomic<std::size_t> finished_count;
+			std::thread compiler;
+			
+			// Makes a page compiled before wait longer to be queued again.
+			void rewritten(register_value number) noexcept;
+			// Runs on the thread, compiling jobs until stopped.
+			void compile_pages() noexcept;
+			// Stops and joins the thread, if it is running.
+			void stop() noexcept;
+	};
+}
+
+#undef GP
+
+#endif
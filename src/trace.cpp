@@ -0,0 +1,197 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "trace.h"
+namespace p32 = metronome32;
+
+using p32::trace_record;
+using p32::trace_ring;
+using p32::trace_writer;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+constexpr char trace_writer::magic[9];
+constexpr std::uint32_t trace_writer::version;
+
+// How many records the drain thread collects before each write.
+static constexpr std::size_t drain_batch = 1 << 16;
+
+// Rounds up to the next power of two.
+static std::size_t round_capacity(std::size_t capacity) noexcept
+{
+	std::size_t rounded = 1;
+	
+	while (rounded < capacity) {
+		rounded <<= 1;
+	}
+	
+	return rounded;
+}
+
+trace_ring::trace_ring(const std::size_t capacity)
+	: records(round_capacity(capacity)), mask(records.size() - 1),
+	  head(0), tail(0), drops(0)
+{}
+
+std::size_t trace_ring::pop(trace_record* out, const std::size_t max) noexcept
+{
+	const std::uint64_t t = tail.load(std::memory_order_relaxed);
+	const std::uint64_t h = head.load(std::memory_order_acquire);
+	const std::size_t n = std::min<std::uint64_t>(h - t, max);
+	
+	for (std::size_t i = 0; i < n; i++) {
+		out[i] = records[(t + i) & mask];
+	}
+	
+	tail.store(t + n, std::memory_order_release);
+	
+	return n;
+}
+
+std::uint64_t trace_ring::dropped() const noexcept
+{
+	return drops.load(std::memory_order_relaxed);
+}
+
+trace_writer::trace_writer(const std::string& path, const std::size_t capacity)
+	: records(capacity), file(std::fopen(path.c_str(), "wb")),
+	  running(file != nullptr), written_records(0)
+{
+	if (file == nullptr) {
+		return;
+	}
+	
+	const std::uint32_t header[2] = {version, sizeof(trace_record)};
+	std::fwrite(magic, 1, sizeof(magic) - 1, file);
+	std::fwrite(header, sizeof(header), 1, file);
+	drainer = std::thread(&trace_writer::drain, this);
+}
+
+trace_writer::~trace_writer()
+{
+	stop();
+}
+
+GP bool trace_writer::is_open() const noexcept
+{
+	return file != nullptr;
+}
+
+GC trace_ring& trace_writer::ring() noexcept
+{
+	return records;
+}
+
+#undef GP
+#undef GC
+
+void trace_writer::stop() noexcept
+{
+	if (file == nullptr) {
+		return;
+	}
+	
+	running.store(false, std::memory_order_release);
+	drainer.join();
+	std::fclose(file);
+	file = nullptr;
+}
+
+std::uint64_t trace_writer::written() const noexcept
+{
+	return written_records.load(std::memory_order_relaxed);
+}
+
+// Runs on the drain thread. Records are gathered into a batch and written
+// once the batch fills or the ring runs dry, so writes stay large while
+// the VM is busy.
+void trace_writer::drain() noexcept
+{
+	std::vector<trace_record> batch(drain_batch);
+	std::size_t filled = 0;
+	
+	for (;;) {
+		const bool last_pass = not running.load(std::memory_order_acquire);
+		const std::size_t got = records.pop(
+			batch.data() + filled,
+			batch.size() - filled
+		);
+		filled += got;
+		
+		if (filled == batch.size() or (got == 0 and filled > 0)) {
+			std::fwrite(batch.data(), sizeof(trace_record), filled, file);
+			written_records.fetch_add(filled, std::memory_order_relaxed);
+			filled = 0;
+		}
+		
+		if (got == 0) {
+			if (last_pass) {
+				break;
+			}
+			
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+bool p32::read_trace(const std::string& path, std::vector<trace_record>& out)
+{
+	std::FILE* in = std::fopen(path.c_str(), "rb");
+	
+	if (in == nullptr) {
+		return false;
+	}
+	
+	char file_magic[sizeof(trace_writer::magic) - 1];
+	std::uint32_t header[2];
+	bool good = std::fread(file_magic, sizeof(file_magic), 1, in) == 1
+		and std::fread(header, sizeof(header), 1, in) == 1
+		and std::memcmp(file_magic, trace_writer::magic, sizeof(file_magic)) == 0
+		and header[0] == trace_writer::version
+		and header[1] == sizeof(trace_record);
+	
+	trace_record rec;
+	
+	while (good and std::fread(&rec, sizeof(rec), 1, in) == 1) {
+		out.push_back(rec);
+	}
+	
+	std::fclose(in);
+	
+	return good;
+}
+
+void p32::tracing::attach(trace_ring& new_ring, const bool register_deltas) noexcept
+{
+	ring = &new_ring;
+	deltas = register_deltas;
+}
+
+void p32::tracing::detach() noexcept
+{
+	ring = nullptr;
+}
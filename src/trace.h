@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "instruction.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_TRACE_H
+#define HEADER_P32_TRACE_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// One executed instruction in an execution trace.
+	struct trace_record {
+		// Set in flags when the step ran in reverse.
+		static constexpr std::uint8_t reversing = 1;
+		// Set in flags when reg and value hold a register delta.
+		static constexpr std::uint8_t has_delta = 2;
+		// Set in flags when the instruction didn't retire.
+		static constexpr std::uint8_t failed = 4;
+		
+		// The address of the instruction.
+		std::uint32_t pc;
+		// The new value of register reg, if has_delta is set.
+		std::uint32_t value;
+		// The opcode, as a metronome32::opcode.
+		std::uint8_t op;
+		std::uint8_t flags;
+		std::uint8_t reg;
+		// The context_error after the step.
+		std::uint8_t errcode;
+	};
+	
+	// A lock-free ring of trace records with a single producer (the
+	// thread stepping the VM) and a single consumer. The producer never
+	// waits: when the ring is full, new records are dropped and counted.
+	class trace_ring {
+		public:
+			// capacity is rounded up to a power of two.
+			explicit trace_ring(std::size_t capacity);
+			trace_ring(const trace_ring&) = delete;
+			trace_ring& operator=(const trace_ring&) = delete;
+			
+			// Appends a record, or drops it if the ring is full.
+			void push(const trace_record& record) noexcept;
+			// Moves up to max records into out, oldest first.
+			// Returns how many were moved.
+			std::size_t pop(trace_record* out, std::size_t max) noexcept;
+			// The number of records dropped so far.
+			std::uint64_t dropped() const noexcept;
+		
+		private:
+			std::vector<trace_record> records;
+			std::size_t mask;
+			// Kept on separate cache lines so the producer and
+			// consumer don't contend.
+			alignas(64) std::atomic<std::uint64_t> head;
+			alignas(64) std::atomic<std::uint64_t> tail;
+			alignas(64) std::atomic<std::uint64_t> drops;
+	};
+	
+	// Owns a trace_ring and a background thread that drains it into a
+	// binary trace file in large sequential writes.
+	//
+	// A trace file starts with trace_writer::magic, then the 32-bit
+	// format version and the 32-bit record size, followed by raw
+	// trace_records in host byte order.
+	class trace_writer {
+		public:
+			static constexpr char magic[9] = "M32TRACE";
+			static constexpr std::uint32_t version = 1;
+			
+			// Opens path for writing and starts the drain thread. If
+			// the file can't be opened, is_open() returns false and
+			// every record is dropped.
+			explicit trace_writer(const std::string& path, std::size_t capacity = 1 << 20);
+			trace_writer(const trace_writer&) = delete;
+			trace_writer& operator=(const trace_writer&) = delete;
+			// Stops the thread, flushing everything left in the ring.
+			~trace_writer();
+			
+			GP bool is_open() const noexcept;
+			// The ring that VMs append to.
+			GC trace_ring& ring() noexcept;
+			// Stops the drain thread after writing out every record
+			// still in the ring, then closes the file.
+			void stop() noexcept;
+			// The number of records written to the file so far.
+			std::uint64_t written() const noexcept;
+		
+		private:
+			trace_ring records;
+			std::FILE* file;
+			std::atomic<bool> running;
+			std::atomic<std::uint64_t> written_records;
+			std::thread drainer;
+			
+			void drain() noexcept;
+	};
+	
+	// Reads a whole trace file written by trace_writer. Returns false if
+	// it can't be read or isn't a trace file.
+	bool read_trace(const std::string& path, std::vector<trace_record>& records);
+	
+	// A statistics policy that appends every step to a trace_ring. Until
+	// a ring is attached it records nothing.
+	class tracing {
+		public:
+			static constexpr bool enabled = true;
+			
+			void record(const step_event& event, const context_data& context) noexcept;
+			// Starts tracing into ring. If register_deltas is set,
+			// each record also carries the register it wrote.
+			void attach(trace_ring& ring, bool register_deltas = true) noexcept;
+			void detach() noexcept;
+		
+		private:
+			trace_ring* ring = nullptr;
+			bool deltas = true;
+	};
+}
+
+#undef GP
+#undef GC
+
+inline void metronome32::trace_ring::push(const trace_record& record) noexcept
+{
+	const std::uint64_t h = head.load(std::memory_order_relaxed);
+	
+	if (h - tail.load(std::memory_order_acquire) > mask) {
+		drops.store(
+			drops.load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed
+		);
+		
+		return;
+	}
+	
+	records[h & mask] = record;
+	head.store(h + 1, std::memory_order_release);
+}
+
+inline void metronome32::tracing::record(const step_event& event, const context_data& context) noexcept
+{
+	if (ring == nullptr) {
+		return;
+	}
+	
+	trace_record rec;
+	rec.pc = event.pc;
+	rec.value = 0;
+	rec.op = static_cast<std::uint8_t>(event.op);
+	rec.flags = event.reversing ? trace_record::reversing : 0;
+	rec.reg = 0;
+	rec.errcode = static_cast<std::uint8_t>(event.errcode);
+	
+	if (not event.retired) {
+		rec.flags |= trace_record::failed;
+	} else if (deltas) {
+		switch (event.op) {
+			case opcode::beq: case opcode::bgez: case opcode::bgtz:
+			case opcode::blez: case opcode::bltz: case opcode::bne:
+			case opcode::cf: case opcode::j: case opcode::jr:
+			case opcode::nai:
+				break;
+			default:
+				// Every other instruction writes the register
+				// in bits 21 to 25 (RSD, or RA for B-types).
+				rec.reg = (event.word >> 21) & 0b11111;
+				rec.value = context.registers[rec.reg];
+				rec.flags |= trace_record::has_delta;
+		}
+	}
+	
+	ring->push(rec);
+}
+
+#endif
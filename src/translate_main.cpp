@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "corpus.h"
+#include "translator.h"
+namespace m32 = metronome32;
+
+static int usage(const char* program)
+{
+	std::cerr << "usage: " << program << " [--scale N] [--out FILE]\n";
+	
+	return EXIT_FAILURE;
+}
+
+// Translates the workload corpus to a C++ translation unit.
+int main(int argc, char** argv)
+{
+	unsigned int scale = 1;
+	const char* path = nullptr;
+	
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 == argc) {
+			return usage(argv[0]);
+		} else if (std::strcmp(argv[i], "--scale") == 0) {
+			scale = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--out") == 0) {
+			path = argv[++i];
+		} else {
+			return usage(argv[0]);
+		}
+	}
+	
+	std::vector<m32::translation_source> sources;
+	
+	for (const m32::workload& work : m32::workload_corpus(scale)) {
+		sources.push_back({work.name, work.initial.sys_mem});
+	}
+	
+	if (path == nullptr) {
+		m32::translate(std::cout, sources);
+		
+		return EXIT_SUCCESS;
+	}
+	
+	std::ofstream out(path);
+	m32::translate(out, sources);
+	
+	if (not out) {
+		std::cerr << "couldn't write " << path << '\n';
+		
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
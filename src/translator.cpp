@@ -0,0 +1,454 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include "cfg.h"
+#include "jit.h"
+#include "predecode.h"
+#include "translator.h"
+
+namespace p32 = metronome32;
+
+using p32::basic_block;
+using p32::branch_target;
+using p32::conditional_branch;
+using p32::context_data;
+using p32::i_form;
+using p32::immediate;
+using p32::opcode;
+using p32::predecoded_word;
+using p32::register_value;
+using p32::translated_engine;
+using p32::translated_program;
+using p32::translation_source;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+static std::string hex(const register_value value)
+{
+	std::ostringstream out;
+	out << "0x" << std::hex << std::uppercase << value << 'U';
+	
+	return out.str();
+}
+
+// Returns the C++ for an ALU word running forward, or in reverse when
+// undo is set, but for the garbage it pushes or pops.
+static std::string alu(const predecoded_word& word, const bool undo)
+{
+	const bool i_type = i_form(word.op);
+	const std::string d = "r[" + std::to_string(i_type ? word.args.i.rsd.to_ulong() : word.args.r.rsd.to_ulong()) + "]";
+	const std::string s = i_type ? "" : "r[" + std::to_string(word.args.r.rs.to_ulong()) + "]";
+	const std::string amount = i_type ? "" : std::to_string(word.args.r.shrot.to_ulong());
+	const std::string imm = i_type ? hex(immediate(word)) : "";
+	
+	switch (word.op) {
+		case opcode::add: return d + (undo ? " -= " : " += ") + s + ";";
+		case opcode::sub: return d + (undo ? " += " : " -= ") + s + ";";
+		case opcode::xor_: return d + " ^= " + s + ";";
+		case opcode::addi: return d + (undo ? " -= " : " += ") + imm + ";";
+		case opcode::xori: return d + " ^= " + imm + ";";
+		case opcode::neg: return d + " = 0U - " + d + ";";
+		case opcode::rl: return d + " = " + (undo ? "rotate_right(" : "rotate_left(") + d + ", " + amount + ");";
+		case opcode::rr: return d + " = " + (undo ? "rotate_left(" : "rotate_right(") + d + ", " + amount + ");";
+		case opcode::rlv: return d + " = " + (undo ? "rotate_right(" : "rotate_left(") + d + ", " + s + ");";
+		case opcode::rrv: return d + " = " + (undo ? "rotate_left(" : "rotate_right(") + d + ", " + s + ");";
+		case opcode::and_: return d + " &= " + s + ";";
+		case opcode::or_: return d + " |= " + s + ";";
+		case opcode::nor: return d + " = ~(" + d + " | " + s + ");";
+		case opcode::andi: return d + " &= " + imm + ";";
+		case opcode::ori: return d + " |= " + imm + ";";
+		case opcode::sll: return d + " <<= " + amount + ";";
+		case opcode::srl: return d + " >>= " + amount + ";";
+		case opcode::sra: return d + " = shift_arithmetic(" + d + ", " + amount + ");";
+		case opcode::sllv: return d + " <<= " + s + " & 31;";
+		case opcode::srlv: return d + " >>= " + s + " & 31;";
+		case opcode::srav: return d + " = shift_arithmetic(" + d + ", " + s + ");";
+		case opcode::slt: return d + " = less(" + d + ", " + s + ");";
+		case opcode::slti: return d + " = less(" + d + ", " + imm + ");";
+		default: return "";
+	}
+}
+
+// Returns whether an ALU word leaves garbage, which its reverse pops.
+GC static bool leaves_garbage(const opcode op) noexcept
+{
+	switch (op) {
+		case opcode::add: case opcode::sub: case opcode::xor_:
+		case opcode::addi: case opcode::xori: case opcode::neg:
+		case opcode::rl: case opcode::rr: case opcode::rlv:
+		case opcode::rrv:
+			return false;
+		default:
+			return true;
+	}
+}
+
+// Returns the C++ condition under which a branch is taken.
+static std::string taken(const predecoded_word& word)
+{
+	const std::string a = "r[" + std::to_string(word.args.b.ra.to_ulong()) + "]";
+	const std::string b = "r[" + std::to_string(word.args.b.rb.to_ulong()) + "]";
+	
+	switch (word.op) {
+		case opcode::beq: return a + " == " + b;
+		case opcode::bne: return a + " != " + b;
+		case opcode::bgez: return b + " >> 31 == 0";
+		case opcode::bgtz: return b + " >> 31 == 0 and " + b + " != 0";
+		case opcode::blez: return b + " >> 31 == 1 or " + b + " == 0";
+		default: return b + " >> 31 == 1";
+	}
+}
+
+// A run of words in a basic block, from first up to end, taken as one
+// case of the switch. It may end with a branch.
+struct run {
+	register_value first;
+	register_value end;
+	bool branches;
+};
+
+// Returns the word at address in image, split.
+static predecoded_word word_at(const p32::instructions_t& image, const register_value address)
+{
+	return p32::predecode(p32::memory::read_word(image, address));
+}
+
+// Splits a program's basic blocks into runs.
+static std::vector<run> find_runs(const p32::instructions_t& image)
+{
+	const p32::control_flow_graph graph(image);
+	std::vector<run> runs;
+	
+	for (const basic_block& block : graph.blocks()) {
+		const register_value end = block.start + block.size;
+		register_value address = block.start;
+		
+		while (address != end) {
+			run next = {address, address, false};
+			
+			for (; next.end != end; next.end++) {
+				const predecoded_word word = word_at(image, next.end);
+				
+				if (not p32::compiles(word) and word.op != opcode::cf) {
+					break;
+				}
+			}
+			
+			// A branch may end a run if its target holds a CF.
+			if (next.end != end) {
+				const predecoded_word word = word_at(image, next.end);
+				const register_value target = branch_target(word, next.end);
+				
+				if (conditional_branch(word) and word_at(image, target).op == opcode::cf) {
+					next.end++;
+					next.branches = true;
+				}
+			}
+			
+			if (next.end == next.first) {
+				address++;
+			} else {
+				runs.push_back(next);
+				address = next.end;
+			}
+		}
+	}
+	
+	return runs;
+}
+
+// Writes the case running a run forward.
+static void write_forward(std::ostream& out, const p32::instructions_t& image, const run& words)
+{
+	const std::uint32_t count = words.end - words.first;
+	const register_value last = words.end - 1;
+	const predecoded_word branch = word_at(image, last);
+	const register_value target = words.branches ? branch_target(branch, last) : 0;
+	const bool loops = words.branches and target + 1 == words.first;
+	const std::string fits = "fits_forward(max_steps - retired, " + hex(words.first) + ", stop_at, " + std::to_string(count) + ")";
+	const std::string indent = loops ? "\t\t\t\t\t\t\t" : "\t\t\t\t\t\t";
+	
+	out << "\t\t\t\tcase " << hex(words.first) << ":\n"
+	    << "\t\t\t\t\tif (not " << fits << ") break;\n";
+	
+	if (loops) {
+		out << "\t\t\t\t\tdo {\n";
+	}
+	
+	for (register_value address = words.first; address != words.end; address++) {
+		const predecoded_word word = word_at(image, address);
+		
+		if (word.op == opcode::cf) {
+			out << indent.substr(1) << "context.pc_stack.push(" << hex(address) << ");\n";
+		} else if (p32::compiles(word)) {
+			if (leaves_garbage(word.op)) {
+				out << indent.substr(1) << "dp.push(r[" << (i_form(word.op) ? word.args.i.rsd.to_ulong() : word.args.r.rsd.to_ulong()) << "]);\n";
+			}
+			
+			out << indent.substr(1) << alu(word, false) << '\n';
+		}
+	}
+	
+	out << indent.substr(1) << "retired += " << count << ";\n"
+	    << indent.substr(1) << "context.retired += " << count << ";\n";
+	
+	if (loops) {
+		out << "\t\t\t\t\t\tif (not (" << taken(branch) << ")) {\n"
+		    << "\t\t\t\t\t\t\tcontext.counter = " << hex(words.end) << ";\n"
+		    << "\t\t\t\t\t\t\tbreak;\n"
+		    << "\t\t\t\t\t\t}\n"
+		    << "\t\t\t\t\t\tcontext.pc_stack.push(" << hex(last) << ");\n"
+		    << "\t\t\t\t\t\tcontext.counter = " << hex(words.first) << ";\n"
+		    << "\t\t\t\t\t} while (context.counter != stop_at and " << fits << ");\n";
+	} else if (words.branches) {
+		out << "\t\t\t\t\tif (" << taken(branch) << ") {\n"
+		    << "\t\t\t\t\t\tcontext.pc_stack.push(" << hex(last) << ");\n"
+		    << "\t\t\t\t\t\tcontext.counter = " << hex(target + 1) << ";\n"
+		    << "\t\t\t\t\t} else {\n"
+		    << "\t\t\t\t\t\tcontext.counter = " << hex(words.end) << ";\n"
+		    << "\t\t\t\t\t}\n";
+	} else {
+		out << "\t\t\t\t\tcontext.counter = " << hex(words.end) << ";\n";
+	}
+	
+	out << "\t\t\t\t\tnote_peaks(context);\n"
+	    << "\t\t\t\t\tcontinue;\n";
+}
+
+// Writes the case running a run in reverse, from the counter at its
+// end, but for a branch, which only moves the counter and is left to
+// step_context().
+static void write_reverse(std::ostream& out, const p32::instructions_t& image, const run& words)
+{
+	const register_value end = words.branches ? words.end - 1 : words.end;
+	const std::uint32_t count = end - words.first;
+	
+	if (count == 0) {
+		return;
+	}
+	
+	out << "\t\t\t\tcase " << hex(end) << ":\n"
+	    << "\t\t\t\t\tif (not fits_reverse(max_steps - retired, " << hex(end) << ", stop_at, " << count << ")) break;\n";
+	
+	for (register_value address = end; address != words.first; address--) {
+		const predecoded_word word = word_at(image, address - 1);
+		const std::uint32_t done = end - address;
+		const std::string strand = "return stranded(context, retired, " + hex(address) + ", " + std::to_string(done) + ");";
+		
+		if (word.op == opcode::cf) {
+			out << "\t\t\t\t\tif (not pop_counter(context)) " << strand << '\n';
+		} else if (leaves_garbage(word.op)) {
+			const unsigned long rsd = i_form(word.op) ? word.args.i.rsd.to_ulong() : word.args.r.rsd.to_ulong();
+			out << "\t\t\t\t\tif (not pop_garbage(context, " << rsd << ")) " << strand << '\n';
+		} else {
+			out << "\t\t\t\t\t" << alu(word, true) << '\n';
+		}
+	}
+	
+	// A CF, only ever first, has already moved the counter.
+	if (word_at(image, words.first).op != opcode::cf) {
+		out << "\t\t\t\t\tcontext.counter = " << hex(words.first) << ";\n";
+	}
+	
+	out << "\t\t\t\t\tretired += " << count << ";\n"
+	    << "\t\t\t\t\tcontext.retired += " << count << ";\n"
+	    << "\t\t\t\t\tcontinue;\n";
+}
+
+// Returns the name of the function a source is translated to.
+static std::string function_name(const std::string& name)
+{
+	std::string function = "translated_" + name;
+	
+	for (char& c : function) {
+		if (not std::isalnum(static_cast<unsigned char>(c))) {
+			c = '_';
+		}
+	}
+	
+	return function;
+}
+
+static void write_program(std::ostream& out, const translation_source& source)
+{
+	const std::string function = function_name(source.name);
+	const std::vector<run> runs = find_runs(source.image);
+	// The words the runs were translated from, and the CFs their
+	// branches land after.
+	std::vector<register_value> depended;
+	
+	for (const run& words : runs) {
+		for (register_value address = words.first; address != words.end; address++) {
+			depended.push_back(address);
+		}
+		
+		if (words.branches) {
+			const register_value last = words.end - 1;
+			depended.push_back(branch_target(word_at(source.image, last), last));
+		}
+	}
+	
+	std::sort(depended.begin(), depended.end());
+	depended.erase(std::unique(depended.begin(), depended.end()), depended.end());
+	
+	out << "// " << source.name << ": " << source.image.size() << " words, " << runs.size() << " runs.\n"
+	    << "static const metronome32::translated::word " << function << "_words[] = {\n";
+	
+	for (const register_value address : depended) {
+		out << "\t{" << hex(address) << ", " << hex(p32::memory::read_word(source.image, address)) << "},\n";
+	}
+	
+	// Past the last word, so that the array is never empty.
+	out << "\t{0, 0},\n"
+	    << "};\n\n"
+	    << "std::uint64_t " << function << "(metronome32::context_data& context, const std::uint64_t max_steps, const metronome32::register_value stop_at)\n"
+	    << "{\n"
+	    << "\tusing namespace metronome32::translated;\n"
+	    << "\tconst std::size_t count = " << depended.size() << ";\n"
+	    << "\tmetronome32::register_value* const r = context.registers.data();\n"
+	    << "\tauto& dp = context.dp_stack;\n"
+	    << "\tbool trusted = holds(context.sys_mem, " << function << "_words, count);\n"
+	    << "\tstd::uint64_t retired = 0;\n"
+	    << "\t(void) r;\n"
+	    << "\t(void) dp;\n"
+	    << "\t\n"
+	    << "\twhile (retired < max_steps and context.counter != stop_at) {\n"
+	    << "\t\tif (trusted and runnable(context)) {\n"
+	    << "\t\t\tif (not context.reversing) {\n"
+	    << "\t\t\t\tswitch (context.counter) {\n";
+	
+	for (const run& words : runs) {
+		write_forward(out, source.image, words);
+	}
+	
+	out << "\t\t\t\tdefault:\n"
+	    << "\t\t\t\t\tbreak;\n"
+	    << "\t\t\t\t}\n"
+	    << "\t\t\t} else {\n"
+	    << "\t\t\t\tswitch (context.counter) {\n";
+	
+	for (const run& words : runs) {
+		write_reverse(out, source.image, words);
+	}
+	
+	out << "\t\t\t\tdefault:\n"
+	    << "\t\t\t\t\tbreak;\n"
+	    << "\t\t\t\t}\n"
+	    << "\t\t\t}\n"
+	    << "\t\t}\n"
+	    << "\t\t\n"
+	    << "\t\tif (not step(context, trusted, " << function << "_words, count)) break;\n"
+	    << "\t\tretired++;\n"
+	    << "\t}\n"
+	    << "\t\n"
+	    << "\treturn retired;\n"
+	    << "}\n\n";
+}
+
+void p32::translate(std::ostream& out, const std::vector<translation_source>& sources)
+{
+	out << "// Translated from Pendulum bytecode by metronome32's translator.\n"
+	    << "\n"
+	    << "#include <cstddef>\n"
+	    << "#include <cstdint>\n"
+	    << "#include \"translator.h\"\n"
+	    << "\n";
+	
+	for (const translation_source& source : sources) {
+		out << "std::uint64_t " << function_name(source.name) << "(metronome32::context_data& context, std::uint64_t max_steps, metronome32::register_value stop_at);\n";
+	}
+	
+	out << "\n";
+	
+	for (const translation_source& source : sources) {
+		write_program(out, source);
+	}
+	
+	out << "const metronome32::translation metronome32::translated_programs[] = {\n";
+	
+	for (const translation_source& source : sources) {
+		out << "\t{\"" << source.name << "\", &" << function_name(source.name) << "},\n";
+	}
+	
+	out << "\t{nullptr, nullptr},\n"
+	    << "};\n";
+}
+
+bool p32::translated::step(context_data& context, bool& trusted, const word* const words, const std::size_t count) noexcept
+{
+	const register_value pc = context.reversing ? context.counter - 1 : context.counter;
+	bool exchange = false;
+	register_value address = 0;
+	
+	if (trusted) {
+		const instr_type::b peek = instr_to_b(memory::read_word(context.sys_mem, pc));
+		exchange = is_exchange(peek);
+		address = exchange ? context.registers[peek.rb.to_ulong()] : 0;
+	}
+	
+	if (not step_context(context)) {
+		return false;
+	}
+	
+	if (exchange) {
+		const word* const at = std::lower_bound(words, words + count, address, [](const word& w, const register_value a) {return w.address < a;});
+		
+		if (at != words + count and at->address == address and memory::read_word(context.sys_mem, address) != at->value) {
+			trusted = false;
+		}
+	}
+	
+	return true;
+}
+
+translated_engine::translated_engine(const char* const name, const translated_program function) noexcept
+	: engine_name(name), program(function)
+{
+}
+
+GP const char* translated_engine::name() const noexcept
+{
+	return engine_name;
+}
+
+void translated_engine::load(const context_data& context)
+{
+	state = context;
+}
+
+void translated_engine::reverse(const bool set_reverse) noexcept
+{
+	state.reversing = set_reverse;
+}
+
+std::uint64_t translated_engine::run(const std::uint64_t max_steps, const register_value stop_at) noexcept
+{
+	return program(state, max_steps, stop_at);
+}
+
+#undef GP
+#undef GC
@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "engine.h"
+#include "instruction.h"
+#include "memory.h"
+#include "vm.h"
+
+#ifndef HEADER_P32_TRANSLATOR_H
+#define HEADER_P32_TRANSLATOR_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// A function translated from a program. It runs context as calls to
+	// vm::step would, until max_steps have retired, the counter reaches
+	// stop_at or an instruction doesn't retire, and returns how many
+	// retired, in whichever direction the context is running.
+	typedef std::uint64_t (*translated_program)(context_data& context, std::uint64_t max_steps, register_value stop_at);
+	
+	// A program for translate(), and the name it is known by.
+	struct translation_source {
+		std::string name;
+		instructions_t image;
+	};
+	
+	// A translated program, as listed by the unit it was translated to.
+	struct translation {
+		const char* name;
+		translated_program run;
+	};
+	
+	// Every unit translate() writes defines this, listing its programs
+	// in order and ending with a null entry.
+	extern const translation translated_programs[];
+	
+	// Writes a C++ translation unit defining a translated_program for
+	// each source, named "translated_" and then its name with anything
+	// but letters and digits replaced by underscores. Each program's
+	// basic blocks are split into runs of ALU words and CFs, which may
+	// end with a conditional branch to a CF, and each run becomes a
+	// case of a switch on the counter in each direction, with its
+	// operands as constants for the host compiler to optimize. A run
+	// whose branch returns to its first word loops within its case.
+	// Everything else, and every run that max_steps or stop_at would
+	// cut short, runs one instruction at a time through step_context().
+	// The runs are only taken while the context has no quota and its
+	// memory holds the words they were translated from, as checked on
+	// each call and after each EXCHANGE into them.
+	void translate(std::ostream& out, const std::vector<translation_source>& sources);
+	
+	// Runs a translated program as an engine.
+	class translated_engine final : public engine {
+		public:
+			translated_engine(const char* engine_name, translated_program program) noexcept;
+			
+			const char* name() const noexcept override;
+			void load(const context_data& context) override;
+			GP const context_data& context() noexcept override {return state;}
+			void reverse(bool set_reverse) noexcept override;
+			std::uint64_t run(std::uint64_t max_steps, register_value stop_at) noexcept override;
+		
+		private:
+			const char* engine_name;
+			translated_program program;
+			context_data state;
+	};
+	
+	// Helpers for the code translate() writes. Each does what the VM
+	// does for the same instruction.
+	namespace translated {
+		// A word of a translated program, as it was translated.
+		struct word {
+			register_value address;
+			memory_value value;
+		};
+		
+		// Returns whether memory holds every one of count words, which
+		// are in order of address.
+		GP inline bool holds(const system_memory_t& memory, const word* const words, const std::size_t count) noexcept
+		{
+			auto at = memory.begin();
+			
+			for (std::size_t i = 0; i < count; i++) {
+				while (at != memory.end() and at->first < words[i].address) {
+					++at;
+				}
+				
+				const memory_value value = at != memory.end() and at->first == words[i].address ? at->second : memory_default;
+				
+				if (value != words[i].value) {
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		// Returns whether runs may be taken for a context: it is
+		// running, and has no quota that one could cross.
+		GP inline bool runnable(const context_data& context) noexcept
+		{
+			const resource_quota& quota = context.quota;
+			const bool trivial = context.errcode == context_error::nothing or context.errcode == context_error::naidefault;
+			
+			return not context.halted and trivial and quota.instructions == UINT64_MAX and quota.dp_depth == SIZE_MAX and quota.pc_depth == SIZE_MAX;
+		}
+		
+		// Returns whether a run of words can be taken from counter:
+		// left is enough steps for all of them, and stop_at isn't
+		// between them.
+		GC inline bool fits_forward(const std::uint64_t left, const register_value counter, const register_value stop_at, const std::uint32_t words) noexcept
+		{
+			return left >= words and register_value(stop_at - counter - 1) >= words - 1;
+		}
+		
+		GC inline bool fits_reverse(const std::uint64_t left, const register_value counter, const register_value stop_at, const std::uint32_t words) noexcept
+		{
+			return left >= words and register_value(counter - 1 - stop_at) >= words - 1;
+		}
+		
+		GC inline register_value rotate_left(const register_value value, const register_value amount) noexcept
+		{
+			return (value << (amount & 31)) | (value >> (-amount & 31));
+		}
+		
+		GC inline register_value rotate_right(const register_value value, const register_value amount) noexcept
+		{
+			return (value >> (amount & 31)) | (value << (-amount & 31));
+		}
+		
+		GC inline register_value shift_arithmetic(const register_value value, const register_value amount) noexcept
+		{
+			const register_value m = register_value(1) << (31 - (amount & 31));
+			
+			return ((value >> (amount & 31)) ^ m) - m;
+		}
+		
+		GC inline register_value less(const register_value a, const register_value b) noexcept
+		{
+			return (a ^ 0x80000000U) < (b ^ 0x80000000U);
+		}
+		
+		// Keeps the context's peaks up to date after a run.
+		inline void note_peaks(context_data& context) noexcept
+		{
+			if (context.sys_mem.size() > context.peak_memory_words) context.peak_memory_words = context.sys_mem.size();
+			if (context.dp_stack.size() > context.peak_dp_entries) context.peak_dp_entries = context.dp_stack.size();
+			if (context.pc_stack.size() > context.peak_pc_entries) context.peak_pc_entries = context.pc_stack.size();
+		}
+		
+		// Restores a register from garbage in reverse, or halts the
+		// context if there is none.
+		inline bool pop_garbage(context_data& context, const unsigned int rsd) noexcept
+		{
+			if (context.dp_stack.empty()) {
+				context.errcode = context_error::dp_stack_empty;
+				context.halted = true;
+				
+				return false;
+			}
+			
+			context.registers[rsd] = context.dp_stack.top();
+			context.dp_stack.pop();
+			
+			return true;
+		}
+		
+		// Runs a CF in reverse, or halts the context if the PC stack is
+		// empty.
+		inline bool pop_counter(context_data& context) noexcept
+		{
+			if (context.pc_stack.empty()) {
+				context.errcode = context_error::pc_stack_empty;
+				context.halted = true;
+				
+				return false;
+			}
+			
+			context.counter = context.pc_stack.top();
+			context.pc_stack.pop();
+			
+			return true;
+		}
+		
+		// Ends a run that halted done words in, with the counter at
+		// counter, and returns how many have retired in all.
+		inline std::uint64_t stranded(context_data& context, const std::uint64_t retired, const register_value counter, const std::uint32_t done) noexcept
+		{
+			context.counter = counter;
+			context.retired += done;
+			
+			return retired + done;
+		}
+		
+		// Runs one instruction through step_context(). If it is an
+		// EXCHANGE that leaves one of the count words changed, trusted
+		// is cleared.
+		bool step(context_data& context, bool& trusted, const word* words, std::size_t count) noexcept;
+	}
+}
+
+#undef GP
+#undef GC
+
+#endif
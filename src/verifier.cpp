@@ -0,0 +1,147 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "verifier.h"
+namespace p32 = metronome32;
+
+using p32::verified_code;
+using p32::register_value;
+using p32::opcode;
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+// Returns whether the word at address passes every check the VM would
+// make on it before it ran, noting the page of any branch target read.
+static bool passes(const p32::system_memory_t& memory, const register_value address, const p32::instruction& instr, std::vector<register_value>& targets)
+{
+	switch (p32::instr_to_opcode(instr)) {
+		case opcode::add: case opcode::and_: case opcode::nor:
+		case opcode::or_: case opcode::rlv: case opcode::rrv:
+		case opcode::sllv: case opcode::slt: case opcode::srav:
+		case opcode::srlv: case opcode::sub: case opcode::xor_: {
+			const p32::instr_type::r r = p32::instr_to_r(instr);
+			
+			return r.rsd != r.rs;
+		}
+		default:
+			break;
+	}
+	
+	register_value target;
+	
+	if (not p32::direct_target(instr, address, target)) {
+		return true;
+	}
+	
+	targets.push_back(p32::memory::page_of(target));
+	
+	return p32::is_cf(p32::instr_to_j(p32::memory::read_word(memory, target)));
+}
+
+verified_code::verified_code(const system_memory_t& memory)
+{
+	verify(memory);
+}
+
+void verified_code::verify(const system_memory_t& memory)
+{
+	clear();
+	failed.clear();
+	std::vector<register_value> targets;
+	auto word = memory.begin();
+	
+	while (word != memory.end()) {
+		const register_value page = p32::memory::page_of(word->first);
+		bool sound = true;
+		targets.clear();
+		
+		for (; word != memory.end() and p32::memory::page_of(word->first) == page; ++word) {
+			if (not passes(memory, word->first, word->second, targets)) {
+				failed.push_back(word->first);
+				sound = false;
+			}
+		}
+		
+		if (not sound) {
+			continue;
+		}
+		
+		proven.push_back(page);
+		dependents[page].push_back(page);
+		std::sort(targets.begin(), targets.end());
+		targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+		
+		for (const register_value target : targets) {
+			if (target != page) {
+				dependents[target].push_back(page);
+			}
+		}
+	}
+}
+
+void verified_code::wrote(const register_value address) noexcept
+{
+	const auto relying = dependents.find(p32::memory::page_of(address));
+	
+	if (relying == dependents.end()) {
+		return;
+	}
+	
+	for (const register_value page : relying->second) {
+		const auto found = std::lower_bound(proven.begin(), proven.end(), page);
+		
+		if (found != proven.end() and *found == page) {
+			proven.erase(found);
+		}
+	}
+	
+	dependents.erase(relying);
+}
+
+void verified_code::clear() noexcept
+{
+	proven.clear();
+	dependents.clear();
+}
+
+GP bool verified_code::covers(const register_value address) const noexcept
+{
+	return std::binary_search(proven.begin(), proven.end(), p32::memory::page_of(address));
+}
+
+GP std::size_t verified_code::pages() const noexcept
+{
+	return proven.size();
+}
+
+GC const std::vector<register_value>& verified_code::rejected() const noexcept
+{
+	return failed;
+}
+
+#undef GP
+#undef GC
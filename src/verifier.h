@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2019 Grayson Burton ( https://github.com/ocornoc/ )
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "instruction.h"
+#include "memory.h"
+
+#ifndef HEADER_P32_VERIFIER_H
+#define HEADER_P32_VERIFIER_H
+
+#define GP [[gnu::pure]]
+#define GC [[gnu::const]]
+
+namespace metronome32 {
+	// A proof, made when a program is loaded, that the words on some
+	// pages of memory can't fail the checks the VM makes on every step:
+	// every direct branch and jump (BEQ through BNE, J and JAL) targets
+	// a CF, and no R-type instruction names rsd as rs. A page is
+	// verified only if every word on it passes. Targets of JR and JALR
+	// aren't known until they run, so they are never covered.
+	//
+	// A proof only holds while the memory it was made from is unchanged.
+	// A write to a page withdraws the proof from that page and from
+	// every page with a branch targeting it, so code modified by
+	// EXCHANGE is checked again as it runs. Changes made to memory
+	// outside the VM must be reported the same way, with wrote(), or
+	// the proof made again.
+	class verified_code {
+		public:
+			// Verifies every page of memory holding a word, replacing
+			// whatever was proven before. This is O(n log n) in the
+			// number of words.
+			void verify(const system_memory_t& memory);
+			// Withdraws the proof from any page depending on the word
+			// at address.
+			void wrote(register_value address) noexcept;
+			// Forgets every page.
+			void clear() noexcept;
+			
+			// Returns whether the word at address is proven.
+			GP bool covers(register_value address) const noexcept;
+			// The number of pages proven.
+			GP std::size_t pages() const noexcept;
+			// The addresses of words found that would fail a check when
+			// run, in order, from the last verify().
+			GC const std::vector<register_value>& rejected() const noexcept;
+			
+			verified_code() noexcept = default;
+			explicit verified_code(const system_memory_t& memory);
+		
+		private:
+			// The pages proven, in order.
+			std::vector<register_value> proven;
+			// For every page a proof reads, the proven pages relying on
+			// it, which always include the page itself if proven.
+			std::map<register_value, std::vector<register_value>> dependents;
+			std::vector<register_value> failed;
+	};
+}
+
+#undef GP
+#undef GC
+
+#endif
@@ -22,23 +22,43 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include <utility>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <new>
+#include <memory>
 #include "instruction.h"
+#include "arena.h"
 #include "memory.h"
+#include "verifier.h"
+#include "predecode.h"
 #include "vm.h"
+#include "statistics.h"
+#include "trace.h"
+#include "profile.h"
+#include "sampler.h"
+#include "fuzz.h"
 namespace p32 = metronome32;
 
 using p32::context_data;
 using p32::context_error;
 using p32::instructions_t;
 using p32::register_value;
+using p32::sign_extend;
 using p32::memory_value;
 using p32::register_context_t;
 using p32::dp_garbage_stack_t;
 using p32::pc_garbage_stack_t;
 using p32::system_memory_t;
+using p32::step_event;
+using p32::opcode;
+using p32::fusion;
+using p32::predecoded_word;
+using p32::native_block;
+using p32::native_code;
+using p32::loop_idioms;
+using p32::counted_loop;
 
 #define GP [[gnu::pure]]
 #define GC [[gnu::const]]
@@ -51,77 +71,210 @@ context_data::context_data(const register_value& counter_init)
 	: counter(counter_init)
 {}
 
+context_data::context_data(p32::arena& storage, const system_memory_t& mem_init, const register_value& counter_init)
+	: counter(counter_init), dp_stack(p32::arena_allocator<register_value>(storage)), pc_stack(p32::arena_allocator<register_value>(storage)), sys_mem(mem_init, storage)
+{}
+
+context_data::context_data(p32::arena& storage, const register_value& counter_init)
+	: counter(counter_init), dp_stack(p32::arena_allocator<register_value>(storage)), pc_stack(p32::arena_allocator<register_value>(storage)), sys_mem(storage)
+{}
+
 context_data p32::fresh_context(const instructions_t& instructions, const register_value& start_pc)
 {
 	return context_data(instructions, start_pc);
 }
 
-p32::vm::vm(const std::vector<p32::memory_value>& bytecode, register_value start_at, register_value load_at)
-	: context(start_at)
+context_data p32::fresh_context(p32::arena& storage, const instructions_t& instructions, const register_value& start_pc)
 {
+	return context_data(storage, instructions, start_pc);
+}
+
+template <class Statistics>
+p32::basic_vm<Statistics>::basic_vm(const std::vector<p32::memory_value>& bytecode, register_value start_at, register_value load_at)
+{
+	contexts.emplace_back(new context_data(start_at));
+	context = contexts.back().get();
+	
 	if (not bytecode.empty()) {
 		for (const auto& bc : bytecode) {
-			auto br = static_cast<decltype(context.sys_mem)::mapped_type>(bc);
-			context.sys_mem[load_at] = br;
+			auto br = static_cast<system_memory_t::mapped_type>(bc);
+			context->sys_mem[load_at] = br;
 			load_at++;
 		}
 	}
 }
 
-GC const context_data& p32::vm::get_context() const noexcept
+template <class Statistics>
+p32::basic_vm<Statistics>::basic_vm(p32::arena& storage, const std::vector<p32::memory_value>& bytecode, register_value start_at, register_value load_at)
+	: own_arena(&storage)
+{
+	contexts.emplace_back(new context_data(storage, start_at));
+	context = contexts.back().get();
+	load_words(bytecode.data(), bytecode.size(), load_at);
+}
+
+template <class Statistics>
+p32::basic_vm<Statistics>::basic_vm(const basic_vm& other)
+	: Statistics(other), free_handles(other.free_handles), active(other.active)
+{
+	contexts.reserve(other.contexts.size());
+	
+	for (const auto& other_context : other.contexts) {
+		contexts.emplace_back(other_context ? new context_data(*other_context) : nullptr);
+	}
+	
+	context = contexts[active].get();
+}
+
+template <class Statistics>
+p32::basic_vm<Statistics>& p32::basic_vm<Statistics>::operator=(const basic_vm& other)
+{
+	if (this != &other) {
+		*this = basic_vm(other);
+	}
+	
+	return *this;
+}
+
+template <class Statistics>
+p32::context_handle p32::basic_vm<Statistics>::add_context(context_data&& new_context) noexcept
+{
+	std::unique_ptr<context_data> added(new context_data(std::move(new_context)));
+	
+	if (free_handles.empty()) {
+		contexts.push_back(std::move(added));
+		
+		return contexts.size() - 1;
+	} else {
+		const context_handle handle = free_handles.back();
+		free_handles.pop_back();
+		contexts[handle] = std::move(added);
+		
+		return handle;
+	}
+}
+
+template <class Statistics>
+p32::context_handle p32::basic_vm<Statistics>::add_context() noexcept
+{
+	return add_context(context_data());
+}
+
+template <class Statistics>
+bool p32::basic_vm<Statistics>::remove_context(const context_handle handle) noexcept
+{
+	if (handle == active or handle >= contexts.size() or not contexts[handle]) {
+		return false;
+	}
+	
+	contexts[handle].reset();
+	free_handles.push_back(handle);
+	
+	return true;
+}
+
+template <class Statistics>
+bool p32::basic_vm<Statistics>::switch_to(const context_handle handle) noexcept
+{
+	if (handle >= contexts.size() or not contexts[handle]) {
+		return false;
+	}
+	
+	active = handle;
+	context = contexts[handle].get();
+	
+	return true;
+}
+
+template <class Statistics>
+void p32::basic_vm<Statistics>::keep_first_context() noexcept
+{
+	if (not contexts[0]) {
+		contexts[0].reset(own_arena ? new context_data(*own_arena) : new context_data());
+	}
+	
+	contexts.resize(1);
+	free_handles.clear();
+	active = 0;
+	context = contexts[0].get();
+}
+
+template <class Statistics>
+GP p32::context_handle p32::basic_vm<Statistics>::active_context() const noexcept
+{
+	return active;
+}
+
+template <class Statistics>
+GP std::size_t p32::basic_vm<Statistics>::context_count() const noexcept
 {
-	return context;
+	return contexts.size() - free_handles.size();
 }
 
-void p32::vm::set_context(const context_data& other_context) noexcept
+template <class Statistics>
+GP const context_data& p32::basic_vm<Statistics>::get_context() const noexcept
 {
-	context = other_context;
+	return *context;
 }
 
-void p32::vm::set_context(context_data&& other_context) noexcept
+template <class Statistics>
+void p32::basic_vm<Statistics>::set_context(const context_data& other_context) noexcept
 {
-	context = std::move(other_context);
+	*context = other_context;
 }
 
-GP bool p32::vm::reversing() const noexcept
+template <class Statistics>
+void p32::basic_vm<Statistics>::set_context(context_data&& other_context) noexcept
 {
-	return context.reversing;
+	*context = std::move(other_context);
 }
 
-void p32::vm::reverse() noexcept
+template <class Statistics>
+GP bool p32::basic_vm<Statistics>::reversing() const noexcept
 {
-	reverse(!context.reversing); 
+	return context->reversing;
 }
 
-void p32::vm::reverse(const bool set_reverse) noexcept
+template <class Statistics>
+void p32::basic_vm<Statistics>::reverse() noexcept
 {
-	context.reversing = set_reverse;
+	reverse(!context->reversing); 
 }
 
-GP bool p32::vm::halted() const noexcept
+template <class Statistics>
+void p32::basic_vm<Statistics>::reverse(const bool set_reverse) noexcept
 {
-	return context.halted;
+	context->reversing = set_reverse;
 }
 
-bool p32::vm::halt(const bool set_halt) noexcept
+template <class Statistics>
+GP bool p32::basic_vm<Statistics>::halted() const noexcept
+{
+	return context->halted;
+}
+
+template <class Statistics>
+bool p32::basic_vm<Statistics>::halt(const bool set_halt) noexcept
 {
 	if (halted() and not set_halt and not is_error_trivial()) {
 		return false;
 	} else {
-		context.halted = set_halt;
+		context->halted = set_halt;
 		
 		return true;
 	}
 }
 
-GP p32::vm::error p32::vm::get_error_code() const noexcept
+template <class Statistics>
+GP typename p32::basic_vm<Statistics>::error p32::basic_vm<Statistics>::get_error_code() const noexcept
 {
-	return context.errcode;
+	return context->errcode;
 }
 
-std::string p32::vm::get_error_name() const noexcept
+template <class Statistics>
+std::string p32::basic_vm<Statistics>::get_error_name() const noexcept
 {
-	switch (context.errcode) {
+	switch (context->errcode) {
 		case (context_error::nothing): return "nothing";
 		case (context_error::nai): return "not an instruction";
 		case (context_error::naidefault): return "not an instruction, but memory default";
@@ -130,6 +283,10 @@ std::string p32::vm::get_error_name() const noexcept
 		case (context_error::missing_cf): return "missing CF instruction";
 		case (context_error::unclear_link): return "link register isn't clear";
 		case (context_error::r_same_registers): return "can't op on self";
+		case (context_error::instruction_quota): return "instruction quota exceeded";
+		case (context_error::memory_quota): return "memory quota exceeded";
+		case (context_error::dp_stack_quota): return "DP stack quota exceeded";
+		case (context_error::pc_stack_quota): return "PC stack quota exceeded";
 		default: return "unknown";
 	}
 }
@@ -141,17 +298,19 @@ std::string p32::vm::get_error_name() const noexcept
 #else
  #define _VMCPP_FALLTHROUGH [[gnu::fallthrough]];
 #endif
-GP bool p32::vm::is_error_trivial() const noexcept
+template <class Statistics>
+GP bool p32::basic_vm<Statistics>::is_error_trivial() const noexcept
 {
 	switch (get_error_code()) {
-		case p32::vm::error::nothing: _VMCPP_FALLTHROUGH
-		case p32::vm::error::naidefault:
+		case context_error::nothing: _VMCPP_FALLTHROUGH
+		case context_error::naidefault:
 			return true;
 		default: return false;
 	}
 }
 
-bool p32::vm::step(size_t times) noexcept
+template <class Statistics>
+bool p32::basic_vm<Statistics>::step(size_t times) noexcept
 {
 	bool still_good = true;
 	
@@ -162,6 +321,141 @@ bool p32::vm::step(size_t times) noexcept
 	return still_good;
 }
 
+template <class Statistics>
+bool p32::basic_vm<Statistics>::step_verified(verified_code& proof, size_t times) noexcept
+{
+	bool still_good = true;
+	
+	for (size_t i = 0; i < times and still_good; i++) {
+		still_good = static_step(*this, &proof);
+	}
+	
+	return still_good;
+}
+
+template <class Statistics>
+void p32::basic_vm<Statistics>::load_words(const memory_value* const words, const std::size_t count, const register_value at) noexcept
+{
+	for (std::size_t i = 0; i < count; i++) {
+		p32::memory::write_word(context->sys_mem, at + i, words[i]);
+	}
+}
+
+template <class Statistics>
+void p32::basic_vm<Statistics>::restore(const context_data& image, const std::vector<register_value>& dirty_pages) noexcept
+{
+	context->reversing = image.reversing;
+	context->halted = image.halted;
+	context->errcode = image.errcode;
+	context->counter = image.counter;
+	context->registers = image.registers;
+	context->dp_stack = image.dp_stack;
+	context->pc_stack = image.pc_stack;
+	context->peak_memory_words = image.peak_memory_words;
+	context->peak_dp_entries = image.peak_dp_entries;
+	context->peak_pc_entries = image.peak_pc_entries;
+	context->quota = image.quota;
+	context->retired = image.retired;
+	context->pages_written = image.pages_written;
+	p32::memory::restore_pages(context->sys_mem, image.sys_mem, dirty_pages);
+}
+
+template <class Statistics>
+void p32::basic_vm<Statistics>::recycle(const register_value start_pc) noexcept
+{
+	const p32::resource_quota quota = context->quota;
+	p32::arena* const storage = context->sys_mem.get_allocator().get_arena();
+	// The arena may only be reset if the VM was built in it, and no
+	// other context in its table was moved into it.
+	bool exclusive = storage != nullptr and storage == own_arena;
+	
+	for (context_handle handle = 0; exclusive and handle < contexts.size(); handle++) {
+		if (handle != active and contexts[handle] and contexts[handle]->sys_mem.get_allocator().get_arena() == storage) {
+			exclusive = false;
+		}
+	}
+	
+	if (not exclusive) {
+		*context = context_data(start_pc);
+	} else {
+		// The containers' storage goes back with the arena, so they
+		// are built afresh over the old ones instead of destroyed.
+		storage->reset();
+		new (context) context_data(*storage, start_pc);
+	}
+	
+	context->quota = quota;
+}
+
+template <class Statistics>
+void p32::basic_vm<Statistics>::set_quota(const resource_quota& limits) noexcept
+{
+	context->quota = limits;
+}
+
+template <class Statistics>
+GP const p32::resource_quota& p32::basic_vm<Statistics>::get_quota() const noexcept
+{
+	return context->quota;
+}
+
+// A std::map node holds three links and a colour besides its value.
+constexpr std::size_t map_node_bytes = 4 * sizeof(void*) + sizeof(system_memory_t::value_type);
+// A std::deque stores its elements in chunks of this many bytes, and
+// keeps an array of chunk pointers with at least this many slots.
+constexpr std::size_t deque_chunk_bytes = 512;
+constexpr std::size_t deque_min_map_slots = 8;
+
+GC static std::size_t garbage_stack_bytes(const std::size_t entries) noexcept
+{
+	constexpr std::size_t per_chunk = deque_chunk_bytes / sizeof(register_value);
+	const std::size_t chunks = entries / per_chunk + 1;
+	const std::size_t slots = chunks + 2 > deque_min_map_slots ? chunks + 2 : deque_min_map_slots;
+	
+	return chunks * deque_chunk_bytes + slots * sizeof(void*);
+}
+
+template <class Statistics>
+p32::memory_footprint p32::basic_vm<Statistics>::memory_usage() const noexcept
+{
+	p32::memory_footprint usage;
+	usage.memory_words = context->sys_mem.size();
+	usage.memory_bytes = usage.memory_words * map_node_bytes;
+	usage.dp_entries = context->dp_stack.size();
+	usage.dp_bytes = garbage_stack_bytes(usage.dp_entries);
+	usage.pc_entries = context->pc_stack.size();
+	usage.pc_bytes = garbage_stack_bytes(usage.pc_entries);
+	usage.total_bytes = usage.memory_bytes + usage.dp_bytes + usage.pc_bytes;
+	// The context may have been built or loaded with more than the VM
+	// has seen it step through.
+	usage.peak_memory_words = std::max(context->peak_memory_words, usage.memory_words);
+	usage.peak_dp_entries = std::max(context->peak_dp_entries, usage.dp_entries);
+	usage.peak_pc_entries = std::max(context->peak_pc_entries, usage.pc_entries);
+	usage.peak_bytes = usage.peak_memory_words * map_node_bytes + garbage_stack_bytes(usage.peak_dp_entries) + garbage_stack_bytes(usage.peak_pc_entries);
+	
+	return usage;
+}
+
+// Raises a context's high-water marks to its current sizes.
+static void note_peaks(context_data& context) noexcept
+{
+	if (context.sys_mem.size() > context.peak_memory_words) context.peak_memory_words = context.sys_mem.size();
+	if (context.dp_stack.size() > context.peak_dp_entries) context.peak_dp_entries = context.dp_stack.size();
+	if (context.pc_stack.size() > context.peak_pc_entries) context.peak_pc_entries = context.pc_stack.size();
+}
+
+template <class Statistics>
+const Statistics& p32::basic_vm<Statistics>::statistics() const noexcept
+{
+	return *this;
+}
+
+template <class Statistics>
+Statistics& p32::basic_vm<Statistics>::statistics() noexcept
+{
+	return *this;
+}
+
 #undef GP
 #undef GC
 #undef _VM_CPP_FALLTHROUGH
@@ -179,24 +473,23 @@ static p32::instruction load_instruction(const system_memory_t& sysmem, const re
 	return p32::memory::read_word(sysmem, pc);
 }
 
-// Sign extends to the left using the nth digit from the left, starting at 1.
-static register_value sign_extend(register_value x, unsigned int n)
+// Returns whether the word at address is a CF, so a branch may land there.
+static bool holds_cf(const system_memory_t& sysmem, const register_value& address)
 {
-	register_value m = 1U << (n - 1);
-	
-	return (x ^ m) - m;
+	return p32::is_cf(p32::instr_to_j(load_instruction(sysmem, address)));
 }
 
 // "fex" means "forward execute", "bex" means "backwards execute".
 // Assumes there are no preexisting non-trivial errors or halts.
 // Returns whether there is now an error EXCEPT for NAI errors.
 
+template <bool Checked>
 static bool fex_add(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -219,12 +512,13 @@ static bool fex_addi(const p32::instr_type::i& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_and(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -249,6 +543,7 @@ static bool fex_andi(const p32::instr_type::i& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_beq(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int ra = instruct.ra.to_ullong();
@@ -256,12 +551,7 @@ static bool fex_beq(const p32::instr_type::b& instruct, context_data& context) n
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[ra] == context.registers[rb]) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -277,18 +567,14 @@ static bool fex_beq(const p32::instr_type::b& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bgez(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int rb = instruct.rb.to_ullong();
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 0) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -304,6 +590,7 @@ static bool fex_bgez(const p32::instr_type::b& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bgezal(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int link = instruct.ra.to_ullong();
@@ -311,12 +598,7 @@ static bool fex_bgezal(const p32::instr_type::b& instruct, context_data& context
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 0) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -339,18 +621,14 @@ static bool fex_bgezal(const p32::instr_type::b& instruct, context_data& context
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bgtz(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int rb = instruct.rb.to_ullong();
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 0 and context.registers[rb] != 0) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -366,18 +644,14 @@ static bool fex_bgtz(const p32::instr_type::b& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_blez(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int rb = instruct.rb.to_ullong();
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 1 or context.registers[rb] == 0) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -393,18 +667,14 @@ static bool fex_blez(const p32::instr_type::b& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bltz(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int rb = instruct.rb.to_ullong();
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 1) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -420,6 +690,7 @@ static bool fex_bltz(const p32::instr_type::b& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bltzal(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int link = instruct.ra.to_ullong();
@@ -427,12 +698,7 @@ static bool fex_bltzal(const p32::instr_type::b& instruct, context_data& context
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[rb] >> 31 == 1) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -455,6 +721,7 @@ static bool fex_bltzal(const p32::instr_type::b& instruct, context_data& context
 	return true;
 }
 
+template <bool Checked>
 static bool fex_bne(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int ra = instruct.ra.to_ullong();
@@ -462,12 +729,7 @@ static bool fex_bne(const p32::instr_type::b& instruct, context_data& context) n
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
 	if (context.registers[ra] != context.registers[rb]) {
-		p32::instruction instr = load_instruction(
-			context.sys_mem,
-			context.counter + offset
-		);
-		
-		if (not p32::is_cf(p32::instr_to_j(instr))) {
+		if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 			context.errcode = p32::context_error::missing_cf;
 			context.halted = true;
 			
@@ -504,14 +766,13 @@ static bool fex_exchange(const p32::instr_type::b& instruct, context_data& conte
 	return true;
 }
 
+template <bool Checked>
 static bool fex_j(const p32::instr_type::j& instruct, context_data& context) noexcept
 {
 	auto new_counter = context.counter & 0b11111100000000000000000000000000;
 	new_counter += sign_extend(instruct.target.to_ullong(), 26);
 	
-	p32::instruction instr = load_instruction(context.sys_mem, new_counter);
-	
-	if (not p32::is_cf(p32::instr_to_j(instr))) {
+	if (Checked and not holds_cf(context.sys_mem, new_counter)) {
 		context.errcode = p32::context_error::missing_cf;
 		context.halted = true;
 		
@@ -524,17 +785,13 @@ static bool fex_j(const p32::instr_type::j& instruct, context_data& context) noe
 	return true;
 }
 
+template <bool Checked>
 static bool fex_jal(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int link = instruct.ra.to_ullong();
 	const register_value offset = sign_extend(instruct.offset.to_ullong(), 16);
 	
-	p32::instruction instr = load_instruction(
-		context.sys_mem,
-		context.counter + offset
-	);
-	
-	if (not p32::is_cf(p32::instr_to_j(instr))) {
+	if (Checked and not holds_cf(context.sys_mem, context.counter + offset)) {
 		context.errcode = p32::context_error::missing_cf;
 		context.halted = true;
 		
@@ -554,18 +811,14 @@ static bool fex_jal(const p32::instr_type::b& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_jalr(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int link = instruct.ra.to_ullong();
 	const unsigned int jreg = instruct.rb.to_ullong();
 	const register_value new_counter = context.registers[jreg];
 	
-	p32::instruction instr = load_instruction(
-		context.sys_mem,
-		new_counter
-	);
-	
-	if (not p32::is_cf(p32::instr_to_j(instr))) {
+	if (Checked and not holds_cf(context.sys_mem, new_counter)) {
 		context.errcode = p32::context_error::missing_cf;
 		context.halted = true;
 		
@@ -584,14 +837,13 @@ static bool fex_jalr(const p32::instr_type::b& instruct, context_data& context)
 	return true;
 }
 
+template <bool Checked>
 static bool fex_jr(const p32::instr_type::b& instruct, context_data& context) noexcept
 {
 	const unsigned int jreg = instruct.rb.to_ullong();
 	const register_value new_counter = context.registers[jreg];
 	
-	p32::instruction instr = load_instruction(context.sys_mem, new_counter);
-	
-	if (not p32::is_cf(p32::instr_to_j(instr))) {
+	if (Checked and not holds_cf(context.sys_mem, new_counter)) {
 		context.errcode = p32::context_error::missing_cf;
 		context.halted = true;
 		
@@ -604,12 +856,13 @@ static bool fex_jr(const p32::instr_type::b& instruct, context_data& context) no
 	return true;
 }
 
+template <bool Checked>
 static bool fex_nor(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -633,12 +886,13 @@ static bool fex_neg(const p32::instr_type::r& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_or(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -674,6 +928,7 @@ static bool fex_rl(const p32::instr_type::r& instruct, context_data& context) no
 	return true;
 }
 
+template <bool Checked>
 static bool fex_rlv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
@@ -681,7 +936,7 @@ static bool fex_rlv(const p32::instr_type::r& instruct, context_data& context) n
 	const register_value amt = context.registers[rs] & 0b11111;
 	const register_value rsdval = context.registers[rsd];
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -705,6 +960,7 @@ static bool fex_rr(const p32::instr_type::r& instruct, context_data& context) no
 	return true;
 }
 
+template <bool Checked>
 static bool fex_rrv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
@@ -712,7 +968,7 @@ static bool fex_rrv(const p32::instr_type::r& instruct, context_data& context) n
 	const register_value amt = context.registers[rs] & 0b11111;
 	const register_value rsdval = context.registers[rsd];
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -736,13 +992,14 @@ static bool fex_sll(const p32::instr_type::r& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_sllv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	const register_value amt = context.registers[rs] & 0b11111;
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -756,6 +1013,7 @@ static bool fex_sllv(const p32::instr_type::r& instruct, context_data& context)
 	}
 }
 
+template <bool Checked>
 static bool fex_slt(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
@@ -763,7 +1021,7 @@ static bool fex_slt(const p32::instr_type::r& instruct, context_data& context) n
 	const register_value rsdval = context.registers[rsd];
 	const register_value rsval = context.registers[rs];
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -820,13 +1078,14 @@ static bool fex_sra(const p32::instr_type::r& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_srav(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	const register_value amt = context.registers[rs] & 0b11111;
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -851,13 +1110,14 @@ static bool fex_srl(const p32::instr_type::r& instruct, context_data& context) n
 	return true;
 }
 
+template <bool Checked>
 static bool fex_srlv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	const register_value amt = context.registers[rs] & 0b11111;
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -871,12 +1131,13 @@ static bool fex_srlv(const p32::instr_type::r& instruct, context_data& context)
 	}
 }
 
+template <bool Checked>
 static bool fex_sub(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -889,12 +1150,13 @@ static bool fex_sub(const p32::instr_type::r& instruct, context_data& context) n
 	}
 }
 
+template <bool Checked>
 static bool fex_xor(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -933,12 +1195,13 @@ static bool pop_from_dpstack(const unsigned int rsd, context_data& context) noex
 	return true;
 }
 
+template <bool Checked>
 static bool bex_add(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -1124,6 +1387,7 @@ static bool bex_rl(const p32::instr_type::r& instruct, context_data& context) no
 	return true;
 }
 
+template <bool Checked>
 static bool bex_rlv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
@@ -1131,7 +1395,7 @@ static bool bex_rlv(const p32::instr_type::r& instruct, context_data& context) n
 	const register_value amt = context.registers[rs] & 0b11111;
 	const register_value rsdval = context.registers[rsd];
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -1155,6 +1419,7 @@ static bool bex_rr(const p32::instr_type::r& instruct, context_data& context) no
 	return true;
 }
 
+template <bool Checked>
 static bool bex_rrv(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
@@ -1162,7 +1427,7 @@ static bool bex_rrv(const p32::instr_type::r& instruct, context_data& context) n
 	const register_value amt = context.registers[rs] & 0b11111;
 	const register_value rsdval = context.registers[rsd];
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -1215,12 +1480,13 @@ static bool bex_srlv(const p32::instr_type::r& instruct, context_data& context)
 	return pop_from_dpstack(instruct.rsd.to_ullong(), context);
 }
 
+template <bool Checked>
 static bool bex_sub(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -1233,12 +1499,13 @@ static bool bex_sub(const p32::instr_type::r& instruct, context_data& context) n
 	}
 }
 
+template <bool Checked>
 static bool bex_xor(const p32::instr_type::r& instruct, context_data& context) noexcept
 {
 	const unsigned int rsd = instruct.rsd.to_ullong();
 	const unsigned int rs = instruct.rs.to_ullong();
 	
-	if (rsd == rs) {
+	if (Checked and rsd == rs) {
 		context.errcode = p32::context_error::r_same_registers;
 		context.halted = true;
 		
@@ -1263,190 +1530,457 @@ static bool bex_xori(const p32::instr_type::i& instruct, context_data& context)
 
 #undef _VMCPP_UNUSED
 
-bool p32::vm::static_step(p32::vm& my_vm) noexcept
+// Executes one instruction on a context, dispatching on its opcode.
+// Returns false if the instruction didn't retire. Unless Checked, the
+// checks a verified_code proves are skipped.
+template <bool Checked>
+static bool execute(const p32::predecoded_word& word, context_data& context) noexcept
+{
+	if (context.reversing) {
+		switch (word.op) {
+			case opcode::add: return bex_add<Checked>(word.args.r, context);
+			case opcode::addi: return bex_addi(word.args.i, context);
+			case opcode::and_: return bex_and(word.args.r, context);
+			case opcode::andi: return bex_andi(word.args.i, context);
+			case opcode::beq: return bex_beq(word.args.b, context);
+			case opcode::bgez: return bex_bgez(word.args.b, context);
+			case opcode::bgezal: return bex_bgezal(word.args.b, context);
+			case opcode::bgtz: return bex_bgtz(word.args.b, context);
+			case opcode::blez: return bex_blez(word.args.b, context);
+			case opcode::bltz: return bex_bltz(word.args.b, context);
+			case opcode::bltzal: return bex_bltzal(word.args.b, context);
+			case opcode::bne: return bex_bne(word.args.b, context);
+			case opcode::cf: return bex_cf(word.args.j, context);
+			case opcode::exchange: return bex_exchange(word.args.b, context);
+			case opcode::j: return bex_j(word.args.j, context);
+			case opcode::jal: return bex_jal(word.args.b, context);
+			case opcode::jalr: return bex_jalr(word.args.b, context);
+			case opcode::jr: return bex_jr(word.args.b, context);
+			case opcode::nor: return bex_nor(word.args.r, context);
+			case opcode::neg: return bex_neg(word.args.r, context);
+			case opcode::or_: return bex_or(word.args.r, context);
+			case opcode::ori: return bex_ori(word.args.i, context);
+			case opcode::rl: return bex_rl(word.args.r, context);
+			case opcode::rlv: return bex_rlv<Checked>(word.args.r, context);
+			case opcode::rr: return bex_rr(word.args.r, context);
+			case opcode::rrv: return bex_rrv<Checked>(word.args.r, context);
+			case opcode::sll: return bex_sll(word.args.r, context);
+			case opcode::sllv: return bex_sllv(word.args.r, context);
+			case opcode::slt: return bex_slt(word.args.r, context);
+			case opcode::slti: return bex_slti(word.args.i, context);
+			case opcode::sra: return bex_sra(word.args.r, context);
+			case opcode::srav: return bex_srav(word.args.r, context);
+			case opcode::srl: return bex_srl(word.args.r, context);
+			case opcode::srlv: return bex_srlv(word.args.r, context);
+			case opcode::sub: return bex_sub<Checked>(word.args.r, context);
+			case opcode::xor_: return bex_xor<Checked>(word.args.r, context);
+			case opcode::xori: return bex_xori(word.args.i, context);
+			case opcode::nai: break;
+		}
+		
+		if (word.instr == p32::memory_default) {
+			context.errcode = p32::context_error::naidefault;
+		} else {
+			context.halted = true;
+			context.errcode = context_error::nai;
+		}
+	} else {
+		switch (word.op) {
+			case opcode::add: return fex_add<Checked>(word.args.r, context);
+			case opcode::addi: return fex_addi(word.args.i, context);
+			case opcode::and_: return fex_and<Checked>(word.args.r, context);
+			case opcode::andi: return fex_andi(word.args.i, context);
+			case opcode::beq: return fex_beq<Checked>(word.args.b, context);
+			case opcode::bgez: return fex_bgez<Checked>(word.args.b, context);
+			case opcode::bgezal: return fex_bgezal<Checked>(word.args.b, context);
+			case opcode::bgtz: return fex_bgtz<Checked>(word.args.b, context);
+			case opcode::blez: return fex_blez<Checked>(word.args.b, context);
+			case opcode::bltz: return fex_bltz<Checked>(word.args.b, context);
+			case opcode::bltzal: return fex_bltzal<Checked>(word.args.b, context);
+			case opcode::bne: return fex_bne<Checked>(word.args.b, context);
+			case opcode::cf: return fex_cf(word.args.j, context);
+			case opcode::exchange: return fex_exchange(word.args.b, context);
+			case opcode::j: return fex_j<Checked>(word.args.j, context);
+			case opcode::jal: return fex_jal<Checked>(word.args.b, context);
+			case opcode::jalr: return fex_jalr<Checked>(word.args.b, context);
+			case opcode::jr: return fex_jr<Checked>(word.args.b, context);
+			case opcode::nor: return fex_nor<Checked>(word.args.r, context);
+			case opcode::neg: return fex_neg(word.args.r, context);
+			case opcode::or_: return fex_or<Checked>(word.args.r, context);
+			case opcode::ori: return fex_ori(word.args.i, context);
+			case opcode::rl: return fex_rl(word.args.r, context);
+			case opcode::rlv: return fex_rlv<Checked>(word.args.r, context);
+			case opcode::rr: return fex_rr(word.args.r, context);
+			case opcode::rrv: return fex_rrv<Checked>(word.args.r, context);
+			case opcode::sll: return fex_sll(word.args.r, context);
+			case opcode::sllv: return fex_sllv<Checked>(word.args.r, context);
+			case opcode::slt: return fex_slt<Checked>(word.args.r, context);
+			case opcode::slti: return fex_slti(word.args.i, context);
+			case opcode::sra: return fex_sra(word.args.r, context);
+			case opcode::srav: return fex_srav<Checked>(word.args.r, context);
+			case opcode::srl: return fex_srl(word.args.r, context);
+			case opcode::srlv: return fex_srlv<Checked>(word.args.r, context);
+			case opcode::sub: return fex_sub<Checked>(word.args.r, context);
+			case opcode::xor_: return fex_xor<Checked>(word.args.r, context);
+			case opcode::xori: return fex_xori(word.args.i, context);
+			case opcode::nai: break;
+		}
+		
+		if (word.instr == p32::memory_default) {
+			context.errcode = p32::context_error::naidefault;
+		} else {
+			context.halted = true;
+			context.counter++;
+			context.errcode = context_error::nai;
+		}
+	}
+	
+	return false;
+}
+
+static bool stop_for_quota(context_data& context, const context_error error) noexcept
 {
-	bool success = false;
-	p32::instruction instr;
+	context.errcode = error;
+	context.halted = true;
 	
-	if (my_vm.reversing()) {
-		instr = load_instruction(my_vm.context.sys_mem, my_vm.context.counter - 1);
-	} else {
-		instr = load_instruction(my_vm.context.sys_mem, my_vm.context.counter);
+	return false;
+}
+
+// Returns whether an EXCHANGE would write to a page holding no words.
+[[gnu::pure]] static bool writes_new_page(const p32::predecoded_word& exchange, const context_data& context) noexcept
+{
+	const register_value address = context.registers[exchange.args.b.rb.to_ulong()];
+	const register_value first = p32::memory::page_of(address) << p32::memory::page_bits;
+	const auto word = context.sys_mem.lower_bound(first);
+	
+	return word == context.sys_mem.end() or p32::memory::page_of(word->first) != p32::memory::page_of(address);
+}
+
+// Executes an instruction, enforcing the context's resource quota and
+// keeping its usage and memory peaks up to date.
+template <bool Checked>
+static bool execute_within_quota(const p32::predecoded_word& word, context_data& context) noexcept
+{
+	if (context.retired >= context.quota.instructions) {
+		return stop_for_quota(context, context_error::instruction_quota);
 	}
 	
-	if (my_vm.halted() or not my_vm.is_error_trivial()) {
+	// Pages are only looked up, and counted, under a memory quota.
+	if (word.op == opcode::exchange and context.quota.memory_pages != SIZE_MAX and writes_new_page(word, context)) {
+		if (context.pages_written >= context.quota.memory_pages) {
+			return stop_for_quota(context, context_error::memory_quota);
+		}
+		
+		context.pages_written++;
+	}
+	
+	if (not execute<Checked>(word, context)) {
 		return false;
 	}
 	
-	auto ir = p32::instr_to_r(instr);
-	auto ib = p32::instr_to_b(instr);
-	auto ij = p32::instr_to_j(instr);
-	auto ii = p32::instr_to_i(instr);
-	
-	if (my_vm.reversing()) {
-		if (p32::is_add(ir)) {
-			success = bex_add(ir, my_vm.context);
-		} else if (p32::is_addi(ii)) {
-			success = bex_addi(ii, my_vm.context);
-		} else if (p32::is_and(ir)) {
-			success = bex_and(ir, my_vm.context);
-		} else if (p32::is_andi(ii)) {
-			success = bex_andi(ii, my_vm.context);
-		} else if (p32::is_beq(ib)) {
-			success = bex_beq(ib, my_vm.context);
-		} else if (p32::is_bgez(ib)) {
-			success = bex_bgez(ib, my_vm.context);
-		} else if (p32::is_bgezal(ib)) {
-			success = bex_bgezal(ib, my_vm.context);
-		} else if (p32::is_bgtz(ib)) {
-			success = bex_bgtz(ib, my_vm.context);
-		} else if (p32::is_blez(ib)) {
-			success = bex_blez(ib, my_vm.context);
-		} else if (p32::is_bltz(ib)) {
-			success = bex_bltz(ib, my_vm.context);
-		} else if (p32::is_bltzal(ib)) {
-			success = bex_bltzal(ib, my_vm.context);
-		} else if (p32::is_bne(ib)) {
-			success = bex_bne(ib, my_vm.context);
-		} else if (p32::is_cf(ij)) {
-			success = bex_cf(ij, my_vm.context);
-		} else if (p32::is_exchange(ib)) {
-			success = bex_exchange(ib, my_vm.context);
-		} else if (p32::is_j(ij)) {
-			success = bex_j(ij, my_vm.context);
-		} else if (p32::is_jal(ib)) {
-			success = bex_jal(ib, my_vm.context);
-		} else if (p32::is_jalr(ib)) {
-			success = bex_jalr(ib, my_vm.context);
-		} else if (p32::is_jr(ib)) {
-			success = bex_jr(ib, my_vm.context);
-		} else if (p32::is_nor(ir)) {
-			success = bex_nor(ir, my_vm.context);
-		} else if (p32::is_neg(ir)) {
-			success = bex_neg(ir, my_vm.context);
-		} else if (p32::is_or(ir)) {
-			success = bex_or(ir, my_vm.context);
-		} else if (p32::is_ori(ii)) {
-			success = bex_ori(ii, my_vm.context);
-		} else if (p32::is_rl(ir)) {
-			success = bex_rl(ir, my_vm.context);
-		} else if (p32::is_rlv(ir)) {
-			success = bex_rlv(ir, my_vm.context);
-		} else if (p32::is_rr(ir)) {
-			success = bex_rr(ir, my_vm.context);
-		} else if (p32::is_rrv(ir)) {
-			success = bex_rrv(ir, my_vm.context);
-		} else if (p32::is_sll(ir)) {
-			success = bex_sll(ir, my_vm.context);
-		} else if (p32::is_sllv(ir)) {
-			success = bex_sllv(ir, my_vm.context);
-		} else if (p32::is_slt(ir)) {
-			success = bex_slt(ir, my_vm.context);
-		} else if (p32::is_slti(ii)) {
-			success = bex_slti(ii, my_vm.context);
-		} else if (p32::is_sra(ir)) {
-			success = bex_sra(ir, my_vm.context);
-		} else if (p32::is_srav(ir)) {
-			success = bex_srav(ir, my_vm.context);
-		} else if (p32::is_srl(ir)) {
-			success = bex_srl(ir, my_vm.context);
-		} else if (p32::is_srlv(ir)) {
-			success = bex_srlv(ir, my_vm.context);
-		} else if (p32::is_sub(ir)) {
-			success = bex_sub(ir, my_vm.context);
-		} else if (p32::is_xor(ir)) {
-			success = bex_xor(ir, my_vm.context);
-		} else if (p32::is_xori(ii)) {
-			success = bex_xori(ii, my_vm.context);
-		} else if (instr == p32::memory_default) {
-			my_vm.context.errcode = p32::context_error::naidefault;
-		} else {
-			my_vm.halt(true);
-			my_vm.context.errcode = context_error::nai;
+	context.retired++;
+	note_peaks(context);
+	
+	// The instruction has retired, so the VM halts after it.
+	if (context.dp_stack.size() > context.quota.dp_depth) {
+		stop_for_quota(context, context_error::dp_stack_quota);
+	} else if (context.pc_stack.size() > context.quota.pc_depth) {
+		stop_for_quota(context, context_error::pc_stack_quota);
+	}
+	
+	return true;
+}
+
+// Returns whether an opcode makes a check that a verified_code can prove.
+[[gnu::const]] static bool statically_checked(const opcode op) noexcept
+{
+	switch (op) {
+		case opcode::add: case opcode::and_: case opcode::nor:
+		case opcode::or_: case opcode::rlv: case opcode::rrv:
+		case opcode::sllv: case opcode::slt: case opcode::srav:
+		case opcode::srlv: case opcode::sub: case opcode::xor_:
+		case opcode::beq: case opcode::bgez: case opcode::bgezal:
+		case opcode::bgtz: case opcode::blez: case opcode::bltz:
+		case opcode::bltzal: case opcode::bne: case opcode::j:
+		case opcode::jal:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Executes an instruction at pc, trusting proof, if there is one, for
+// the checks it covers there. An EXCHANGE withdraws the proof from the
+// page it writes.
+static bool execute_with_proof(const p32::predecoded_word& word, context_data& context, const register_value pc, p32::verified_code* const proof) noexcept
+{
+	if (proof == nullptr) {
+		return execute_within_quota<true>(word, context);
+	} else if (word.op == opcode::exchange) {
+		const register_value address = context.registers[word.args.b.rb.to_ulong()];
+		const bool retired = execute_within_quota<true>(word, context);
+		
+		if (retired) {
+			proof->wrote(address);
+		}
+		
+		return retired;
+	} else if (statically_checked(word.op) and proof->covers(pc)) {
+		return execute_within_quota<false>(word, context);
+	} else {
+		return execute_within_quota<true>(word, context);
+	}
+}
+
+// Counts an instruction a fused pair retired, for a context without a
+// quota.
+static void count_retired(context_data& context) noexcept
+{
+	context.retired++;
+	note_peaks(context);
+}
+
+// Runs a fused pair for a context without a quota, exactly as its two
+// words would run one after the other: word, at the pc, and then next,
+// the word after it going forward or before it in reverse. Returns how
+// many retired.
+static unsigned int execute_fused(const p32::predecoded_word& word, const p32::predecoded_word& next, context_data& context) noexcept
+{
+	if (context.reversing) {
+		switch (word.reverse) {
+			case fusion::move:
+				bex_add<false>(word.args.r, context);
+				count_retired(context);
+				if (not bex_andi(next.args.i, context)) return 1;
+				break;
+			case fusion::loop_head:
+				bex_addi(word.args.i, context);
+				count_retired(context);
+				if (not bex_cf(next.args.j, context)) return 1;
+				break;
+			case fusion::count_down:
+				bex_bgtz(word.args.b, context);
+				count_retired(context);
+				bex_addi(next.args.i, context);
+				break;
+			case fusion::none:
+				return 0;
 		}
 	} else {
-		if (p32::is_add(ir)) {
-			success = fex_add(ir, my_vm.context);
-		} else if (p32::is_addi(ii)) {
-			success = fex_addi(ii, my_vm.context);
-		} else if (p32::is_and(ir)) {
-			success = fex_and(ir, my_vm.context);
-		} else if (p32::is_andi(ii)) {
-			success = fex_andi(ii, my_vm.context);
-		} else if (p32::is_beq(ib)) {
-			success = fex_beq(ib, my_vm.context);
-		} else if (p32::is_bgez(ib)) {
-			success = fex_bgez(ib, my_vm.context);
-		} else if (p32::is_bgezal(ib)) {
-			success = fex_bgezal(ib, my_vm.context);
-		} else if (p32::is_bgtz(ib)) {
-			success = fex_bgtz(ib, my_vm.context);
-		} else if (p32::is_blez(ib)) {
-			success = fex_blez(ib, my_vm.context);
-		} else if (p32::is_bltz(ib)) {
-			success = fex_bltz(ib, my_vm.context);
-		} else if (p32::is_bltzal(ib)) {
-			success = fex_bltzal(ib, my_vm.context);
-		} else if (p32::is_bne(ib)) {
-			success = fex_bne(ib, my_vm.context);
-		} else if (p32::is_cf(ij)) {
-			success = fex_cf(ij, my_vm.context);
-		} else if (p32::is_exchange(ib)) {
-			success = fex_exchange(ib, my_vm.context);
-		} else if (p32::is_j(ij)) {
-			success = fex_j(ij, my_vm.context);
-		} else if (p32::is_jal(ib)) {
-			success = fex_jal(ib, my_vm.context);
-		} else if (p32::is_jalr(ib)) {
-			success = fex_jalr(ib, my_vm.context);
-		} else if (p32::is_jr(ib)) {
-			success = fex_jr(ib, my_vm.context);
-		} else if (p32::is_nor(ir)) {
-			success = fex_nor(ir, my_vm.context);
-		} else if (p32::is_neg(ir)) {
-			success = fex_neg(ir, my_vm.context);
-		} else if (p32::is_or(ir)) {
-			success = fex_or(ir, my_vm.context);
-		} else if (p32::is_ori(ii)) {
-			success = fex_ori(ii, my_vm.context);
-		} else if (p32::is_rl(ir)) {
-			success = fex_rl(ir, my_vm.context);
-		} else if (p32::is_rlv(ir)) {
-			success = fex_rlv(ir, my_vm.context);
-		} else if (p32::is_rr(ir)) {
-			success = fex_rr(ir, my_vm.context);
-		} else if (p32::is_rrv(ir)) {
-			success = fex_rrv(ir, my_vm.context);
-		} else if (p32::is_sll(ir)) {
-			success = fex_sll(ir, my_vm.context);
-		} else if (p32::is_sllv(ir)) {
-			success = fex_sllv(ir, my_vm.context);
-		} else if (p32::is_slt(ir)) {
-			success = fex_slt(ir, my_vm.context);
-		} else if (p32::is_slti(ii)) {
-			success = fex_slti(ii, my_vm.context);
-		} else if (p32::is_sra(ir)) {
-			success = fex_sra(ir, my_vm.context);
-		} else if (p32::is_srav(ir)) {
-			success = fex_srav(ir, my_vm.context);
-		} else if (p32::is_srl(ir)) {
-			success = fex_srl(ir, my_vm.context);
-		} else if (p32::is_srlv(ir)) {
-			success = fex_srlv(ir, my_vm.context);
-		} else if (p32::is_sub(ir)) {
-			success = fex_sub(ir, my_vm.context);
-		} else if (p32::is_xor(ir)) {
-			success = fex_xor(ir, my_vm.context);
-		} else if (p32::is_xori(ii)) {
-			success = fex_xori(ii, my_vm.context);
-		} else if (instr == p32::memory_default) {
-			my_vm.context.errcode = p32::context_error::naidefault;
+		switch (word.forward) {
+			case fusion::move:
+				fex_andi(word.args.i, context);
+				count_retired(context);
+				fex_add<false>(next.args.r, context);
+				break;
+			case fusion::loop_head:
+				fex_cf(word.args.j, context);
+				count_retired(context);
+				fex_addi(next.args.i, context);
+				break;
+			case fusion::count_down:
+				fex_addi(word.args.i, context);
+				count_retired(context);
+				if (not fex_bgtz<true>(next.args.b, context)) return 1;
+				break;
+			case fusion::none:
+				return 0;
+		}
+	}
+	
+	count_retired(context);
+	
+	return 2;
+}
+
+template <class Statistics>
+std::uint64_t p32::basic_vm<Statistics>::run_predecoded(predecoded_code& code, const std::uint64_t max_steps, const register_value stop_at, native_code* const native, loop_idioms* const idioms) noexcept
+{
+	std::uint64_t steps = 0;
+	
+	if (Statistics::enabled) {
+		while (steps < max_steps and context->counter != stop_at and static_step(*this)) {
+			steps++;
+		}
+		
+		return steps;
+	}
+	
+	// Without a quota, nothing can stop a pair between its words that
+	// the pair itself doesn't check.
+	const resource_quota& quota = context->quota;
+	const bool fusing = quota.instructions == UINT64_MAX and quota.dp_depth == SIZE_MAX and quota.pc_depth == SIZE_MAX;
+	
+	while (steps < max_steps and context->counter != stop_at and not halted() and is_error_trivial()) {
+		const bool backwards = context->reversing;
+		const register_value pc = backwards ? context->counter - 1 : context->counter;
+		
+		if (code.sealed() and not code.holds(pc)) {
+			break;
+		}
+		
+		const predecoded_word& word = code.fetch(context->sys_mem, pc);
+		const fusion pair = backwards ? word.reverse : word.forward;
+		// Where the counter is between the pair's words.
+		const register_value middle = backwards ? pc : pc + 1;
+		// The bit of word.no_native and word.no_idiom for this
+		// direction.
+		const std::uint8_t direction = backwards ? 2 : 1;
+		
+		if (idioms != nullptr and fusing and (word.no_idiom & direction) == 0) {
+			const counted_loop* const loop = idioms->at(context->counter, backwards);
+			
+			if (loop == nullptr) {
+				word.no_idiom |= direction;
+			} else {
+				const std::uint64_t done = loop_idioms::run(*loop, *context, max_steps - steps, stop_at);
+				
+				if (done != 0) {
+					context->retired += done;
+					note_peaks(*context);
+					steps += done;
+					
+					continue;
+				}
+			}
+		}
+		
+		if (native != nullptr and fusing and (word.no_native & direction) == 0) {
+			std::uint32_t words = 0;
+			const native_block block = native->block(code, context->sys_mem, context->counter, backwards, words);
+			
+			if (block == nullptr) {
+				word.no_native |= direction;
+			}
+			
+			// How far ahead stop_at is, which a block may reach but not
+			// pass.
+			const std::uint64_t ahead = backwards ? context->counter - std::uint64_t(stop_at) : std::uint64_t(stop_at) - context->counter;
+			
+			if (block != nullptr and words <= max_steps - steps and ahead >= words) {
+				const std::uint64_t done = block(context, context->registers.data(), &context->counter, max_steps - steps);
+				context->retired += done;
+				note_peaks(*context);
+				steps += done;
+				
+				continue;
+			}
+		}
+		
+		if (pair != fusion::none and fusing and max_steps - steps >= 2 and middle != stop_at) {
+			const predecoded_word& next = code.fetch(context->sys_mem, backwards ? pc - 1 : pc + 1);
+			const unsigned int done = execute_fused(word, next, *context);
+			steps += done;
+			
+			if (done < 2) {
+				break;
+			}
+		} else if (word.op == opcode::exchange) {
+			const register_value address = context->registers[word.args.b.rb.to_ulong()];
+			
+			if (not execute_within_quota<true>(word, *context)) {
+				break;
+			}
+			
+			code.wrote(address);
+			
+			if (native != nullptr) {
+				native->wrote(address);
+			}
+			
+			if (idioms != nullptr) {
+				idioms->wrote(address);
+			}
+			
+			steps++;
+		} else if (not backwards and (word.op == opcode::jr or word.op == opcode::jalr)) {
+			// The site's inline cache vouches for a target it has seen
+			// hold a CF.
+			const register_value target = context->registers[word.args.b.rb.to_ulong()];
+			const bool known = code.knows_target(word, target);
+			
+			if (not (known ? execute_within_quota<false>(word, *context) : execute_within_quota<true>(word, *context))) {
+				break;
+			}
+			
+			if (not known) {
+				code.learn_target(word, target, context->sys_mem);
+			}
+			
+			steps++;
+		} else if (execute_within_quota<true>(word, *context)) {
+			steps++;
 		} else {
-			my_vm.halt(true);
-			my_vm.context.counter++;
-			my_vm.context.errcode = context_error::nai;
+			break;
 		}
 	}
 	
-	return success;
+	return steps;
+}
+
+// Lets a policy with a quick_record(pc, reversing) member take the
+// step that way, when it returns true, instead of from a step_event.
+template <class Statistics>
+static auto quick_record(Statistics& policy, const register_value pc, const bool reversing, int) noexcept -> decltype(policy.quick_record(pc, reversing))
+{
+	return policy.quick_record(pc, reversing);
+}
+
+template <class Statistics>
+static bool quick_record(Statistics&, register_value, bool, long) noexcept
+{
+	return false;
+}
+
+template <class Statistics>
+bool p32::basic_vm<Statistics>::static_step(p32::basic_vm<Statistics>& my_vm, verified_code* const proof) noexcept
+{
+	context_data& context = *my_vm.context;
+	
+	if (my_vm.halted() or not my_vm.is_error_trivial()) {
+		return false;
+	}
+	
+	const register_value pc = context.reversing ? context.counter - 1 : context.counter;
+	const p32::predecoded_word word = p32::predecode(load_instruction(context.sys_mem, pc));
+	
+	if (not Statistics::enabled or quick_record(my_vm.statistics(), pc, context.reversing, 0)) {
+		return execute_with_proof(word, context, pc, proof);
+	}
+	
+	const auto dp_depth = context.dp_stack.size();
+	const auto pc_depth = context.pc_stack.size();
+	step_event event;
+	event.pc = pc;
+	event.word = word.instr.to_ulong();
+	event.op = word.op;
+	event.reversing = context.reversing;
+	event.address = word.op == opcode::exchange ? context.registers[word.args.b.rb.to_ulong()] : 0;
+	event.retired = execute_with_proof(word, context, pc, proof);
+	event.next_pc = context.counter;
+	event.errcode = context.errcode;
+	event.dp_delta = static_cast<int>(context.dp_stack.size() - dp_depth);
+	event.pc_delta = static_cast<int>(context.pc_stack.size() - pc_depth);
+	my_vm.statistics().record(event, context);
+	
+	return event.retired;
+}
+
+bool p32::step_context(context_data& context) noexcept
+{
+	if (context.halted or (context.errcode != context_error::nothing and context.errcode != context_error::naidefault)) {
+		return false;
+	}
+	
+	const register_value pc = context.reversing ? context.counter - 1 : context.counter;
+	
+	return execute_within_quota<true>(p32::predecode(load_instruction(context.sys_mem, pc)), context);
 }
+
+template class p32::basic_vm<p32::no_statistics>;
+template class p32::basic_vm<p32::opcode_statistics>;
+template class p32::basic_vm<p32::tracing>;
+template class p32::basic_vm<p32::garbage_profiling>;
+template class p32::basic_vm<p32::function_profiling>;
+template class p32::basic_vm<p32::sampling>;
+template class p32::basic_vm<p32::edge_coverage>;
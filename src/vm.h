@@ -25,8 +25,16 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <array>
 #include <stack>
+#include <deque>
+#include <memory>
+#include <cstdint>
 #include "instruction.h"
+#include "arena.h"
 #include "memory.h"
+#include "verifier.h"
+#include "predecode.h"
+#include "jit.h"
+#include "idioms.h"
 
 #ifndef HEADER_P32_VM_H
 #define HEADER_P32_VM_H
@@ -35,9 +43,9 @@ namespace metronome32 {
 	// An array holding all of the registers for a particular context.
 	typedef std::array<register_value, 32> register_context_t;
 	// The datapath garbage stack.
-	typedef std::stack<register_value> dp_garbage_stack_t;
+	typedef std::stack<register_value, std::deque<register_value, arena_allocator<register_value>>> dp_garbage_stack_t;
 	// The program counter garbage stack.
-	typedef std::stack<register_value> pc_garbage_stack_t;
+	typedef std::stack<register_value, std::deque<register_value, arena_allocator<register_value>>> pc_garbage_stack_t;
 	// Context error codes.
 	enum class context_error {
 		// No error currently.
@@ -59,6 +67,31 @@ namespace metronome32 {
 		unclear_link,
 		// r-type instructions using RS and RSD cannot have RS == RSD.
 		r_same_registers,
+		// The context has retired as many instructions as its quota
+		// allows.
+		instruction_quota,
+		// An EXCHANGE would write to a new memory page beyond the
+		// context's quota.
+		memory_quota,
+		// The datapath stack grew deeper than its quota.
+		dp_stack_quota,
+		// The PC stack grew deeper than its quota.
+		pc_stack_quota,
+	};
+	// The number of distinct context_error values.
+	constexpr std::size_t context_error_count = static_cast<std::size_t>(context_error::pc_stack_quota) + 1;
+	
+	// Limits on the resources a context may use. Every limit defaults
+	// to the largest value of its type, which is no limit at all.
+	struct resource_quota {
+		// The most instructions the context may retire.
+		std::uint64_t instructions = UINT64_MAX;
+		// The most memory pages (of 2^memory::page_bits words) that
+		// held no words beforehand the context may write to.
+		std::size_t memory_pages = SIZE_MAX;
+		// The deepest the garbage stacks may grow.
+		std::size_t dp_depth = SIZE_MAX;
+		std::size_t pc_depth = SIZE_MAX;
 	};
 	
 	// An entire context for the VM.
@@ -81,6 +114,19 @@ namespace metronome32 {
 		register_value counter = 0;
 		// The current register context.
 		register_context_t registers = {};
+		// The limits the VM enforces on this context, and the usage
+		// counted against them so far. New pages are only counted
+		// while there is a memory quota. These and the peaks below are
+		// checked or updated on every step, so they sit with the
+		// registers, ahead of the containers.
+		resource_quota quota;
+		std::uint64_t retired = 0;
+		std::size_t pages_written = 0;
+		// The most entries sys_mem and the garbage stacks have held, as
+		// kept by the VM for memory_usage().
+		std::size_t peak_memory_words = 0;
+		std::size_t peak_dp_entries = 0;
+		std::size_t peak_pc_entries = 0;
 		// The current datapath garbage stack.
 		dp_garbage_stack_t dp_stack;
 		// The current program counter garbage stack.
@@ -95,6 +141,10 @@ namespace metronome32 {
 		~context_data() = default;
 		context_data(const system_memory_t& mem_init, const register_value& counter_init = 0);
 		context_data(const register_value& counter_init = 0);
+		// Contexts whose memory and garbage stacks allocate from
+		// storage.
+		context_data(arena& storage, const system_memory_t& mem_init, const register_value& counter_init = 0);
+		context_data(arena& storage, const register_value& counter_init = 0);
 	};
 	
 	// The type holding bytecode to be loaded into memory.
@@ -103,21 +153,117 @@ namespace metronome32 {
 	// starting program counter. If start_pc isn't specified, it is
 	// assumed to be zero.
 	context_data fresh_context(const instructions_t& instructions, const register_value& start_pc = 0);
+	// The same, with the context's storage drawn from an arena.
+	context_data fresh_context(arena& storage, const instructions_t& instructions, const register_value& start_pc = 0);
+	// Executes one instruction of a context in place, exactly as
+	// vm::step would, and returns whether it retired. For code running
+	// contexts without a VM, such as translated programs.
+	bool step_context(context_data& context) noexcept;
+	
+	// Identifies one of the contexts a VM holds.
+	typedef std::size_t context_handle;
+	
+	// A summary of one executed step, handed to the VM's statistics
+	// policy after the step has been carried out.
+	struct step_event {
+		// The address of the instruction that was executed.
+		register_value pc;
+		// The program counter after the step.
+		register_value next_pc;
+		// The raw instruction word.
+		memory_value word;
+		// The decoded mnemonic.
+		opcode op;
+		// Whether the step was executed in reverse.
+		bool reversing;
+		// Whether the instruction retired successfully.
+		bool retired;
+		// The context status after the step.
+		context_error errcode;
+		// The change in the datapath garbage stack's depth.
+		int dp_delta;
+		// The change in the program counter garbage stack's depth.
+		int pc_delta;
+		// The memory address an EXCHANGE accessed, or zero.
+		register_value address;
+	};
 	
-	// A class of a VM.
-	class vm;
+	// A breakdown of the memory a context occupies. The byte counts
+	// estimate what the containers allocate, after libstdc++'s layout of
+	// map nodes and deque chunks.
+	struct memory_footprint {
+		// Resident memory words, each in its own map node.
+		std::size_t memory_words;
+		std::size_t memory_bytes;
+		// Entries on the datapath garbage stack.
+		std::size_t dp_entries;
+		std::size_t dp_bytes;
+		// Entries on the program counter garbage stack.
+		std::size_t pc_entries;
+		std::size_t pc_bytes;
+		// The sum of the byte counts.
+		std::size_t total_bytes;
+		// The most each count has been in the context's lifetime.
+		std::size_t peak_memory_words;
+		std::size_t peak_dp_entries;
+		std::size_t peak_pc_entries;
+		// The bytes of all three peaks together. They needn't have been
+		// reached at once, so this bounds the most ever held.
+		std::size_t peak_bytes;
+	};
+	
+	// The default statistics policy. It records nothing, and the engine
+	// skips building step_events for it entirely.
+	struct no_statistics {
+		static constexpr bool enabled = false;
+		
+		void record(const step_event&, const context_data&) noexcept {}
+	};
+	
+	// A class of a VM, parameterised on a statistics policy. A policy
+	// needs a static constexpr bool "enabled" and a member function
+	// record(const step_event&, const context_data&).
+	template <class Statistics>
+	class basic_vm;
+	// The plain VM, which keeps no statistics.
+	typedef basic_vm<no_statistics> vm;
 }
 
 #define GP [[gnu::pure]]
 #define GC [[gnu::const]]
 
-class metronome32::vm {
+template <class Statistics>
+class metronome32::basic_vm : private Statistics {
 	public:
 		typedef metronome32::context_data context_data;
 		typedef metronome32::context_error error;
+		typedef Statistics statistics_type;
+		
+		// A VM holds a table of contexts and runs the active one, which
+		// every other member function works on. It starts with one
+		// context, handle 0.
+		// Moves a context into the table, returning its handle.
+		context_handle add_context(context_data&& new_context) noexcept;
+		// Adds an empty context on the heap. It never shares the
+		// active context's arena, which recycle() may reset.
+		context_handle add_context() noexcept;
+		// Deletes a context that isn't active, so its handle may be
+		// reused. Returns whether there was such a context.
+		bool remove_context(context_handle handle) noexcept;
+		// Makes another context active. This only swaps a pointer.
+		// Returns whether there was such a context.
+		bool switch_to(context_handle handle) noexcept;
+		// Removes every context but handle 0 and makes it active. If
+		// handle 0 was removed, an empty context takes its place, in
+		// the arena the VM was built with if it has one.
+		void keep_first_context() noexcept;
+		GP context_handle active_context() const noexcept;
+		// The number of contexts in the table.
+		GP std::size_t context_count() const noexcept;
 		
-		// Setting, getting, and swapping contexts.
-		GC const context_data& get_context() const noexcept;
+		// Setting, getting, and swapping contexts. Setting copies or
+		// moves into the active context.
+		GP const context_data& get_context() const noexcept;
 		void set_context(const context_data& other_context) noexcept;
 		void set_context(context_data&& other_context) noexcept;
 		
@@ -147,19 +293,84 @@ class metronome32::vm {
 		// already halted prior to execution, this will return false.
 		// Otherwise, it returns true for success.
 		bool step(size_t times = 1) noexcept;
+		// The same, but skipping the checks proof covers for the words
+		// it covers. An EXCHANGE withdraws the proof from the page it
+		// writes, and every other change to memory made outside
+		// stepping must be reported to proof too.
+		bool step_verified(verified_code& proof, size_t times = 1) noexcept;
+		// Executes up to max_steps instructions as step() would, but
+		// fetching them from code, a predecoded copy of the context's
+		// memory, and running the idioms it finds as one instruction
+		// when no quota is set. Stops before an instruction would start
+		// at stop_at, or after one that didn't retire, and returns how
+		// many retired. EXCHANGE drops the page it writes from code;
+		// other changes to memory need code to be told or cleared.
+		// With native, runs of ALU words are run as the blocks it
+		// compiles from them, in place of code, when no quota is set.
+		// With idioms, the counted loops it holds are each run at once
+		// where they are entered, when no quota is set, and EXCHANGE
+		// drops those on the page it writes.
+		// A sealed code stops the run before a word it doesn't hold.
+		std::uint64_t run_predecoded(predecoded_code& code, std::uint64_t max_steps, register_value stop_at, native_code* native = nullptr, loop_idioms* idioms = nullptr) noexcept;
+		
+		// Writes count words into memory, starting at address at.
+		void load_words(const memory_value* words, std::size_t count, register_value at = 0) noexcept;
+		// Makes the context equal to image again, in place. Only the
+		// listed memory pages are restored, so every page written to
+		// since the context last matched image must be listed.
+		void restore(const context_data& image, const std::vector<register_value>& dirty_pages) noexcept;
+		
+		// Sets or gets the context's resource quota. When a step would
+		// retire an instruction past the instruction quota or write a
+		// page past the memory quota, the VM halts instead with
+		// instruction_quota or memory_quota. A step that takes a
+		// garbage stack past its quota retires, and then the VM halts
+		// with dp_stack_quota or pc_stack_quota.
+		void set_quota(const resource_quota& limits) noexcept;
+		GP const resource_quota& get_quota() const noexcept;
 		
-		vm(const vm&) = default;
-		vm(vm&&) = default;
-		vm& operator=(const vm&) = default;
-		vm& operator=(vm&&) = default;
-		~vm() = default;
-		vm(const std::vector<memory_value>& bytecode = {}, register_value start_at = 0, register_value load_at = 0);
+		// Returns the memory the context occupies now and at its
+		// peaks. This is O(1); the peaks are kept up to date as the VM
+		// steps.
+		memory_footprint memory_usage() const noexcept;
+		
+		// Empties the context for the next program, keeping its quota.
+		// When the context's storage comes from the arena the VM was
+		// built with, and no other context in its table shares it, the
+		// arena is reset in bulk instead of each word and stack chunk
+		// being freed. Otherwise the context is just replaced. Copies
+		// of the VM or of its contexts are made on the heap, so they
+		// are unaffected.
+		void recycle(register_value start_pc = 0) noexcept;
+		
+		// Returns the statistics policy, for reading or resetting it.
+		const statistics_type& statistics() const noexcept;
+		statistics_type& statistics() noexcept;
+		
+		// Copying a VM copies every context in its table.
+		basic_vm(const basic_vm& other);
+		basic_vm(basic_vm&&) = default;
+		basic_vm& operator=(const basic_vm& other);
+		basic_vm& operator=(basic_vm&&) = default;
+		~basic_vm() = default;
+		basic_vm(const std::vector<memory_value>& bytecode = {}, register_value start_at = 0, register_value load_at = 0);
+		// A VM whose context's storage is drawn from an arena, which
+		// must outlive it.
+		basic_vm(arena& storage, const std::vector<memory_value>& bytecode = {}, register_value start_at = 0, register_value load_at = 0);
 	
 	private:
-		context_data context;
-		
-		// Steps a VM once. Same return conditions as step().
-		static bool static_step(metronome32::vm& my_vm) noexcept;
+		// The table of contexts, with nullptr for removed ones whose
+		// handles are free, and the active context.
+		std::vector<std::unique_ptr<context_data>> contexts;
+		std::vector<context_handle> free_handles;
+		context_data* context = nullptr;
+		context_handle active = 0;
+		// The arena the VM was built with, if any. Copies of the VM,
+		// like every copy of a context, are made on the heap.
+		arena* own_arena = nullptr;
+		// Steps a VM once, trusting proof if there is one. Same return
+		// conditions as step().
+		static bool static_step(basic_vm& my_vm, verified_code* proof = nullptr) noexcept;
 };
 
 #undef GP